@@ -0,0 +1,118 @@
+/**
+@file arena_example.c
+@brief 
+Example usage of the arena allocator for per-request scratch containers
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "arena.h"
+#include "hashtable.h"
+#include "list.h"
+
+#define REQUESTS 3
+#define ELEMENTS 1000000
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static int match_int(const void *int1, const void *int2);
+static uint64_t hash_int(const void *key);
+
+// =============================================================================
+// Main Program
+// =============================================================================
+
+int main(int argc, char *argv[])
+{
+  Arena_t arena;
+  HashTable_t htable;
+  List_t list;
+  clock_t start;
+  int *data;
+  int request;
+  int i;
+
+  if (arena_init(&arena, 1 << 20) != 0)
+    return 1;
+
+  for (request = 0; request < REQUESTS; request++) {
+    // Both the elements and the data of the scratch containers live in the arena
+    list_init_allocator(&list, NULL, arena_allocator(&arena));
+
+    if (hashtable_init_allocator(&htable, 1024, hash_int, match_int, NULL, arena_allocator(&arena)) != 0)
+      return 1;
+
+    hashtable_set_load_factor(&htable, 1.0, 0);
+
+    for (i = 0; i < ELEMENTS; i++) {
+      if ((data = (int *)arena_alloc(&arena, sizeof(int))) == NULL)
+        return 1;
+
+      *data = i;
+
+      if (list_insert_next(&list, list_tail(&list), data) != 0)
+        return 1;
+
+      if (hashtable_insert(&htable, data) != 0)
+        return 1;
+    }
+
+    fprintf(stdout, "Request %d: list size=%d, table size=%d\n", 
+      request, list_size(&list), hashtable_size(&htable));
+
+    // Tear everything down without visiting a single element
+    start = clock();
+    list_destroy(&list);
+    hashtable_destroy(&htable);
+    arena_reset(&arena);
+
+    fprintf(stdout, "Request %d: teardown took %.6fs\n", 
+      request, (double)(clock() - start) / CLOCKS_PER_SEC);
+  }
+
+  // Compare with element by element teardown of a malloc based list
+  list_init(&list, free);
+
+  for (i = 0; i < ELEMENTS; i++) {
+    if ((data = (int *)malloc(sizeof(int))) == NULL)
+      return 1;
+
+    *data = i;
+
+    if (list_insert_next(&list, list_tail(&list), data) != 0)
+      return 1;
+  }
+
+  start = clock();
+  list_destroy(&list);
+
+  fprintf(stdout, "malloc based list teardown took %.6fs\n", 
+    (double)(clock() - start) / CLOCKS_PER_SEC);
+
+  arena_destroy(&arena);
+
+  return 0;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+static int match_int(const void *int1, const void *int2)
+{
+  // Compare two integers
+  return (*(const int *)int1 == *(const int *)int2);
+}
+
+
+static uint64_t hash_int(const void *key)
+{
+  // Integers hash to themselves
+  return (uint64_t)*(const int *)key;
+}
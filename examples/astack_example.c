@@ -0,0 +1,165 @@
+/**
+@file astack_example.c
+@brief 
+Example usage of array-backed stack ADT
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "astack.h"
+#include "stack.h"
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static void print_stack(const AStack_t *stack);
+static void benchmark(void);
+
+// =============================================================================
+// Main Program
+// =============================================================================
+
+int main(int argc, char *argv[])
+{
+  AStack_t stack;
+  int *data;
+  int i;
+
+  // Initialize the stack
+  astack_init(&stack, free);
+
+  // Perform some stack operations
+  fprintf(stdout, "Pushing 10 elements\n");
+
+  for (i = 0; i < 10; i++) {
+    if ((data = (int *)malloc(sizeof(int))) == NULL)
+      return 1;
+
+    *data = i + 1;
+
+    if (astack_push(&stack, data) != 0)
+      return 1;
+  }
+
+  print_stack(&stack);
+
+  fprintf(stdout, "Popping 5 elements\n");
+
+  for (i = 0; i < 5; i++) {
+    if (astack_pop(&stack, (void **)&data) == 0)
+      free(data);
+    else
+      return 1;
+  }
+
+  print_stack(&stack);
+
+  fprintf(stdout, "Pushing 100 and 200\n");
+
+  if ((data = (int *)malloc(sizeof(int))) == NULL)
+    return 1;
+
+  *data = 100;
+
+  if (astack_push(&stack, data) != 0)
+    return 1;
+
+  if ((data = (int *)malloc(sizeof(int))) == NULL)
+    return 1;
+
+  *data = 200;
+
+  if (astack_push(&stack, data) != 0)
+    return 1;
+
+  print_stack(&stack);
+
+  if ((data = astack_peek(&stack)) != NULL)
+    fprintf(stdout, "Peeking at the top element...Value=%03d\n", *data);
+  else
+    fprintf(stdout, "Peeking at the top element...Value=NULL\n");
+
+  print_stack(&stack);
+
+  fprintf(stdout, "Popping all elements\n");
+
+  while (astack_size(&stack) > 0) {
+    if (astack_pop(&stack, (void **)&data) == 0)
+      free(data);
+  }
+
+  if ((data = astack_peek(&stack)) != NULL)
+    fprintf(stdout, "Peeking at an empty stack...Value=%03d\n", *data);
+  else
+    fprintf(stdout, "Peeking at an empty stack...Value=NULL\n");
+
+  print_stack(&stack);
+
+  // Destroy the stack
+  fprintf(stdout, "Destroying the stack\n");
+  astack_destroy(&stack);
+
+  // Compare against the linked-list stack
+  benchmark();
+
+  return 0;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+static void print_stack(const AStack_t *stack)
+{
+  int *data;
+  int size;
+  int i;
+
+  // Display the stack
+  fprintf(stdout, "Stack size is %d\n", size = astack_size(stack));
+
+  for (i = 0; i < size; i++) {
+    data = stack->items[size - 1 - i];
+    fprintf(stdout, "stack[%03d]=%03d\n", i, *data);
+  }
+}
+
+
+static void benchmark(void)
+{
+  AStack_t astack;
+  Stack_t stack;
+  clock_t start;
+  void *data;
+  int depth;
+  int i;
+
+  // Simulate a DFS that repeatedly dives up to 64 levels deep and back
+  fprintf(stdout, "Benchmarking 10000000 push/pop pairs\n");
+
+  start = clock();
+  stack_init(&stack, NULL);
+  for (i = 0; i < 10000000 / 64; i++) {
+    for (depth = 0; depth < 64; depth++)
+      stack_push(&stack, &stack);
+    while (stack_size(&stack) > 0)
+      stack_pop(&stack, &data);
+  }
+  stack_destroy(&stack);
+  fprintf(stdout, "Stack_t:  %.3fs\n", (double)(clock() - start) / CLOCKS_PER_SEC);
+
+  start = clock();
+  astack_init(&astack, NULL);
+  for (i = 0; i < 10000000 / 64; i++) {
+    for (depth = 0; depth < 64; depth++)
+      astack_push(&astack, &astack);
+    while (astack_size(&astack) > 0)
+      astack_pop(&astack, &data);
+  }
+  astack_destroy(&astack);
+  fprintf(stdout, "AStack_t: %.3fs\n", (double)(clock() - start) / CLOCKS_PER_SEC);
+}
@@ -23,6 +23,7 @@ static void print_clist(const CList_t *list);
 int main(int argc, char *argv[])
 {
   CList_t list;
+  CList_t other;
   CList_Element_t *element;
 
   int *data;
@@ -84,9 +85,26 @@ int main(int argc, char *argv[])
 
   print_clist(&list);
 
-  // Destroy the linked list
-  fprintf(stdout, "Destroying the list\n");
+  fprintf(stdout, "Splitting off the three elements after the head\n");
+
+  element = clist_head(&list);
+  if (clist_split(&list, element, clist_next(clist_next(clist_next(element))), &other) != 0)
+    return 1;
+
+  print_clist(&list);
+  print_clist(&other);
+
+  fprintf(stdout, "Joining them back in after the head (rotated by one)\n");
+
+  if (clist_concat(&list, &other) != 0)
+    return 1;
+
+  print_clist(&list);
+
+  // Destroy the linked lists
+  fprintf(stdout, "Destroying the lists\n");
   clist_destroy(&list);
+  clist_destroy(&other);
 
   return 0;
 }
@@ -24,6 +24,7 @@ static void print_dlist(const DList_t *list);
 int main(int argc, char *argv[])
 {
   DList_t list;
+  DList_t other;
   DList_Element_t *element;
 
   int *data;
@@ -146,9 +147,34 @@ int main(int argc, char *argv[])
   i = dlist_is_tail(dlist_head(&list));
   fprintf(stdout, "Testing dlist_is_tail...Value=%d (0=OK)\n", i);
 
-  // Destroy the linked list
-  fprintf(stdout, "Destroying the list\n");
+  fprintf(stdout, "Splitting the list after the second element\n");
+
+  if (dlist_split(&list, dlist_next(dlist_head(&list)), &other) != 0)
+    return 1;
+
+  print_dlist(&list);
+  print_dlist(&other);
+
+  fprintf(stdout, "Splicing the first two elements of the other list to the head\n");
+
+  element = dlist_head(&other);
+  if (dlist_splice_next(&list, NULL, &other, element, dlist_next(element)) != 0)
+    return 1;
+
+  print_dlist(&list);
+  print_dlist(&other);
+
+  fprintf(stdout, "Concatenating the rest of the other list\n");
+
+  if (dlist_concat(&list, &other) != 0)
+    return 1;
+
+  print_dlist(&list);
+
+  // Destroy the linked lists
+  fprintf(stdout, "Destroying the lists\n");
   dlist_destroy(&list);
+  dlist_destroy(&other);
 
   return 0;
 }
@@ -0,0 +1,197 @@
+/**
+@file flathash_example.c
+@brief 
+Example usage of open-addressing hash table ADT
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "flathash.h"
+#include "hashtable.h"
+
+#define BENCH_SIZE 200000
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static int match_int(const void *int1, const void *int2);
+static uint64_t hash_int(const void *key);
+
+static void print_flathash(const FlatHash_t *fhash);
+static void benchmark(void);
+
+// =============================================================================
+// Main Program
+// =============================================================================
+
+int main(int argc, char *argv[])
+{
+  FlatHash_t fhash;
+  int *data;
+  int key;
+  int retval;
+  int i;
+
+  // Initialize the open-addressing hash table
+  if (flathash_init(&fhash, 16, hash_int, match_int, free) != 0)
+    return 1;
+
+  // Perform some hash table operations
+  fprintf(stdout, "Inserting 20 elements\n");
+
+  for (i = 0; i < 20; i++) {
+    if ((data = (int *)malloc(sizeof(int))) == NULL)
+      return 1;
+
+    *data = i * 7;
+
+    if (flathash_insert(&fhash, data) != 0)
+      return 1;
+  }
+
+  print_flathash(&fhash);
+
+  if ((data = (int *)malloc(sizeof(int))) == NULL)
+    return 1;
+
+  *data = 14;
+
+  if ((retval = flathash_insert(&fhash, data)) != 0)
+    free(data);
+
+  fprintf(stdout, "Trying to insert 14 again...Value=%d (1=OK)\n", retval);
+
+  fprintf(stdout, "Removing 0, 7 and 70\n");
+
+  for (i = 0; i < 3; i++) {
+    key = (i == 2) ? 70 : i * 7;
+    data = &key;
+
+    if (flathash_remove(&fhash, (void **)&data) == 0)
+      free(data);
+  }
+
+  print_flathash(&fhash);
+
+  key = 21;
+  data = &key;
+
+  if (flathash_lookup(&fhash, (void **)&data) == 0)
+    fprintf(stdout, "Found an occurrence of 21\n");
+  else
+    fprintf(stdout, "Did not find an occurrence of 21\n");
+
+  key = 7;
+  data = &key;
+
+  if (flathash_lookup(&fhash, (void **)&data) == 0)
+    fprintf(stdout, "Found an occurrence of 7\n");
+  else
+    fprintf(stdout, "Did not find an occurrence of 7\n");
+
+  // Destroy the hash table
+  fprintf(stdout, "Destroying the hash table\n");
+  flathash_destroy(&fhash);
+
+  // Compare against the chained hash table on the same workload
+  benchmark();
+
+  return 0;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+static int match_int(const void *int1, const void *int2)
+{
+  // Compare two integers
+  return (*(const int *)int1 == *(const int *)int2);
+}
+
+
+static uint64_t hash_int(const void *key)
+{
+  // Integers hash to themselves
+  return (uint64_t)*(const int *)key;
+}
+
+
+static void print_flathash(const FlatHash_t *fhash)
+{
+  int i;
+
+  // Display the hash table
+  fprintf(stdout, "Table size is %d (capacity %d)\n", 
+    flathash_size(fhash), flathash_capacity(fhash));
+
+  for (i = 0; i < flathash_capacity(fhash); i++) {
+    if (flathash_is_used(fhash, i))
+      fprintf(stdout, "%d ", *(int *)flathash_data(fhash, i));
+  }
+  fprintf(stdout, "\n");
+}
+
+
+static void benchmark(void)
+{
+  FlatHash_t fhash;
+  HashTable_t htable;
+  int *keys;
+  void *data;
+  clock_t start;
+  int found;
+  int i;
+
+  if ((keys = (int *)malloc(BENCH_SIZE * sizeof(int))) == NULL)
+    return;
+
+  for (i = 0; i < BENCH_SIZE; i++)
+    keys[i] = i * 2654435761U;
+
+  fprintf(stdout, "Benchmarking %d inserts and %d lookups\n", BENCH_SIZE, 2 * BENCH_SIZE);
+
+  // Chained hash table
+  start = clock();
+  hashtable_init(&htable, 1024, hash_int, match_int, NULL);
+  hashtable_set_load_factor(&htable, 1.0, 0);
+
+  for (i = 0; i < BENCH_SIZE; i++)
+    hashtable_insert(&htable, &keys[i]);
+
+  found = 0;
+  for (i = 0; i < 2 * BENCH_SIZE; i++) {
+    data = &keys[i % BENCH_SIZE];
+    if (hashtable_lookup(&htable, &data) == 0)
+      found++;
+  }
+
+  hashtable_destroy(&htable);
+  fprintf(stdout, "HashTable_t: found=%d time=%.3fs\n", found, 
+    (double)(clock() - start) / CLOCKS_PER_SEC);
+
+  // Open-addressing hash table
+  start = clock();
+  flathash_init(&fhash, 1024, hash_int, match_int, NULL);
+
+  for (i = 0; i < BENCH_SIZE; i++)
+    flathash_insert(&fhash, &keys[i]);
+
+  found = 0;
+  for (i = 0; i < 2 * BENCH_SIZE; i++) {
+    data = &keys[i % BENCH_SIZE];
+    if (flathash_lookup(&fhash, &data) == 0)
+      found++;
+  }
+
+  flathash_destroy(&fhash);
+  fprintf(stdout, "FlatHash_t:  found=%d time=%.3fs\n", found, 
+    (double)(clock() - start) / CLOCKS_PER_SEC);
+
+  free(keys);
+}
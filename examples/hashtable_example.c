@@ -5,11 +5,11 @@ Example usage of chained hash table ADT
 
 @author Justin Hadella (pitchnogle@gmail.com)
 */
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 
 #include "hashtable.h"
-#include "list.h"
 
 #define HASH_TABLE_SIZE 11
 
@@ -18,10 +18,25 @@ Example usage of chained hash table ADT
 // -----------------------------------------------------------------------------
 
 static int match_char(const void *char1, const void *char2);
-static int hash_char(const void *key);
+static uint64_t hash_char(const void *key);
+static int match_int(const void *int1, const void *int2);
+static uint64_t hash_int(const void *key);
+
+static void *create_counter(const void *key);
 
 static void print_hashtable(const HashTable_t *htable);
 
+/**
+@struct Counter_t
+A character and the number of times it has been seen (the key comes first so
+the character hash and match functions apply)
+*/
+typedef struct Counter_T {
+  char c;
+  int count;
+
+} Counter_t;
+
 // =============================================================================
 // Main Program
 // =============================================================================
@@ -31,6 +46,12 @@ int main(int argc, char *argv[])
   HashTable_t htable;
   char *data;
   char c;
+  int *number;
+  char text[] = "mississippi";
+  Counter_t *counter;
+  int keys[8];
+  void *batch[8];
+  int results[8];
   int retval;
   int i;
 
@@ -170,6 +191,105 @@ int main(int argc, char *argv[])
   fprintf(stdout, "Destroying the hash table\n");
   hashtable_destroy(&htable);
 
+  // Count characters, creating each counter the first time it is seen
+  if (hashtable_init(&htable, HASH_TABLE_SIZE, hash_char, match_char, free) != 0)
+    return 1;
+
+  fprintf(stdout, "Counting the characters in \"%s\"\n", text);
+
+  for (i = 0; text[i] != '\0'; i++) {
+    counter = (Counter_t *)&text[i];
+
+    if (hashtable_get_or_insert_with(&htable, (void **)&counter, create_counter) < 0)
+      return 1;
+
+    counter->count++;
+  }
+
+  for (c = 'a'; c <= 'z'; c++) {
+    counter = (Counter_t *)&c;
+
+    if (hashtable_lookup(&htable, (void **)&counter) == 0)
+      fprintf(stdout, "%c=%d\n", counter->c, counter->count);
+  }
+
+  fprintf(stdout, "Replacing the counter for s\n");
+
+  if ((counter = (Counter_t *)create_counter("s")) == NULL)
+    return 1;
+
+  retval = hashtable_upsert(&htable, (void **)&counter);
+  fprintf(stdout, "Upserting s...Value=%d (1=OK) old count=%d\n", retval, counter->count);
+  free(counter);
+
+  c = 's';
+  counter = (Counter_t *)&c;
+
+  if (hashtable_lookup(&htable, (void **)&counter) == 0)
+    fprintf(stdout, "s=%d (0=OK)\n", counter->count);
+
+  hashtable_destroy(&htable);
+
+  // Initialize a chained hash table that grows as elements are added
+  if (hashtable_init(&htable, HASH_TABLE_SIZE, hash_int, match_int, free) != 0)
+    return 1;
+
+  if (hashtable_set_load_factor(&htable, 2.0, 0.5) != 0)
+    return 1;
+
+  fprintf(stdout, "Inserting 1000 integers into a growable table\n");
+
+  for (i = 0; i < 1000; i++) {
+    if ((number = (int *)malloc(sizeof(int))) == NULL)
+      return 1;
+
+    *number = i;
+
+    if (hashtable_insert(&htable, number) != 0)
+      return 1;
+  }
+
+  fprintf(stdout, "Table size is %d, buckets=%d, rehashing=%d\n", 
+    hashtable_size(&htable), hashtable_buckets(&htable), hashtable_is_rehashing(&htable));
+
+  fprintf(stdout, "Looking up a batch of 8 integers\n");
+
+  for (i = 0; i < 8; i++) {
+    keys[i] = i * 250;
+    batch[i] = &keys[i];
+  }
+
+  retval = hashtable_lookup_many(&htable, batch, 8, results);
+  fprintf(stdout, "Found %d of 8 (4=OK)\n", retval);
+
+  for (i = 0; i < 8; i++)
+    fprintf(stdout, "key=%d result=%d\n", keys[i], results[i]);
+
+  fprintf(stdout, "Removing 990 integers\n");
+
+  for (i = 0; i < 990; i++) {
+    number = &i;
+
+    if (hashtable_remove(&htable, (void **)&number) != 0)
+      return 1;
+
+    free(number);
+  }
+
+  fprintf(stdout, "Table size is %d, buckets=%d, rehashing=%d\n", 
+    hashtable_size(&htable), hashtable_buckets(&htable), hashtable_is_rehashing(&htable));
+
+  i = 995;
+  number = &i;
+
+  if (hashtable_lookup(&htable, (void **)&number) == 0)
+    fprintf(stdout, "Found an occurrence of %d\n", *number);
+  else
+    fprintf(stdout, "Did not find an occurrence of %d\n", i);
+
+  fprintf(stdout, "Destroying the growable hash table\n");
+  hashtable_destroy(&htable);
+
   return 0;
 }
 
@@ -184,16 +304,45 @@ static int match_char(const void *char1, const void *char2)
 }
 
 
-static int hash_char(const void *key)
+static uint64_t hash_char(const void *key)
 {
   // A simplistic hash function
   return *(const char *)key % HASH_TABLE_SIZE;
 }
 
 
+static int match_int(const void *int1, const void *int2)
+{
+  // Compare two integers
+  return (*(const int *)int1 == *(const int *)int2);
+}
+
+
+static uint64_t hash_int(const void *key)
+{
+  // Integers hash to themselves
+  return (uint64_t)*(const int *)key;
+}
+
+
+static void *create_counter(const void *key)
+{
+  Counter_t *counter;
+
+  // Create a counter for the character that has not been seen yet
+  if ((counter = (Counter_t *)malloc(sizeof(Counter_t))) == NULL)
+    return NULL;
+
+  counter->c = *(const char *)key;
+  counter->count = 0;
+
+  return counter;
+}
+
+
 static void print_hashtable(const HashTable_t *htable)
 {
-  List_Element_t *element;
+  HashTable_Element_t *element;
   int i;
 
   // Display the chained hash table
@@ -202,8 +351,8 @@ static void print_hashtable(const HashTable_t *htable)
   for (i = 0; i < HASH_TABLE_SIZE; i++) {
     fprintf(stdout, "Bucket[%03d]=", i);
 
-    for (element = list_head(&htable->table[i]); element != NULL; element = list_next(element)) {
-      fprintf(stdout, "%c", *(char *)list_data(element));
+    for (element = hashtable_head(htable, i); element != NULL; element = hashtable_next(element)) {
+      fprintf(stdout, "%c", *(char *)hashtable_data(element));
     }
     fprintf(stdout, "\n");
   }
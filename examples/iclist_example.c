@@ -0,0 +1,94 @@
+/**
+@file iclist_example.c
+@brief 
+Example usage of intrusive circular linked-list ADT
+
+A round-robin scheduler keeps its runnable tasks in a ring and gives each one a
+slice in turn. A task that finishes is unlinked from the ring after the task
+before it.
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "iclist.h"
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+typedef struct Task_T {
+  char name;
+  int remaining;         ///< Slices of work left
+  ICList_Element_t link; ///< Links the task into the run ring
+} Task_t;
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static void destroy_task(ICList_Element_t *element);
+
+// =============================================================================
+// Main Program
+// =============================================================================
+
+int main(int argc, char *argv[])
+{
+  static const int work[] = { 3, 1, 4, 2 };
+  ICList_t ring;
+  ICList_Element_t *prev;
+  ICList_Element_t *element;
+  Task_t *task;
+  int slice;
+  int i;
+
+  iclist_init(&ring, destroy_task);
+
+  prev = NULL;
+  for (i = 0; i < 4; i++) {
+    if ((task = (Task_t *)malloc(sizeof (Task_t))) == NULL)
+      return 1;
+
+    task->name = 'A' + i;
+    task->remaining = work[i];
+
+    if (iclist_insert_next(&ring, prev, &task->link) != 0)
+      return 1;
+
+    prev = &task->link;
+  }
+
+  // Run the ring, remembering the task before the current one so a finished
+  // task can be unlinked
+  slice = 0;
+  while (iclist_size(&ring) > 0) {
+    element = iclist_next(prev);
+    task = iclist_entry(element, Task_t, link);
+
+    task->remaining--;
+    fprintf(stdout, "slice %02d: task %c (%d left)\n", ++slice, task->name, task->remaining);
+
+    if (task->remaining == 0) {
+      fprintf(stdout, "          task %c done\n", task->name);
+      iclist_remove_next(&ring, prev, &element);
+      free(task);
+    }
+    else
+      prev = element;
+  }
+
+  iclist_destroy(&ring);
+
+  return 0;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+static void destroy_task(ICList_Element_t *element)
+{
+  free(iclist_entry(element, Task_t, link));
+}
@@ -0,0 +1,136 @@
+/**
+@file idlist_example.c
+@brief 
+Example usage of intrusive doubly linked-list ADT
+
+A connection sits in two lists at once through two embedded elements: the list
+of all connections and the list of idle ones. Since each element knows its own
+neighbours, a connection is moved between or dropped from lists without any
+search or allocation.
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "idlist.h"
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+typedef struct Connection_T {
+  int fd;
+  IDList_Element_t all;  ///< Links the connection into the list of all
+  IDList_Element_t idle; ///< Links the connection into the idle list
+} Connection_t;
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static void destroy_connection(IDList_Element_t *element);
+static void print_all(const IDList_t *list);
+static void print_idle(const IDList_t *list);
+
+// =============================================================================
+// Main Program
+// =============================================================================
+
+int main(int argc, char *argv[])
+{
+  IDList_t all;
+  IDList_t idle;
+  IDList_Element_t *element;
+  Connection_t *connection;
+  int i;
+
+  // Only the list of all connections frees them
+  idlist_init(&all, destroy_connection);
+  idlist_init(&idle, NULL);
+
+  for (i = 0; i < 6; i++) {
+    if ((connection = (Connection_t *)malloc(sizeof (Connection_t))) == NULL)
+      return 1;
+
+    connection->fd = 3 + i;
+
+    if (idlist_insert_next(&all, idlist_tail(&all), &connection->all) != 0)
+      return 1;
+
+    // Every other connection starts out idle
+    if (i % 2 == 0 && idlist_insert_next(&idle, idlist_tail(&idle), &connection->idle) != 0)
+      return 1;
+  }
+
+  print_all(&all);
+  print_idle(&idle);
+
+  // The oldest idle connection becomes busy
+  element = idlist_head(&idle);
+  connection = idlist_entry(element, Connection_t, idle);
+  fprintf(stdout, "Connection %d becomes busy\n", connection->fd);
+
+  if (idlist_remove(&idle, &connection->idle) != 0)
+    return 1;
+
+  print_idle(&idle);
+
+  // A busy connection in the middle goes idle, ahead of the others
+  connection = idlist_entry(idlist_next(idlist_head(&all)), Connection_t, all);
+  fprintf(stdout, "Connection %d goes idle\n", connection->fd);
+
+  if (idlist_insert_prev(&idle, idlist_head(&idle), &connection->idle) != 0)
+    return 1;
+
+  print_idle(&idle);
+
+  // A connection closes and leaves both lists in O(1)
+  connection = idlist_entry(idlist_head(&idle), Connection_t, idle);
+  fprintf(stdout, "Connection %d closes\n", connection->fd);
+
+  idlist_remove(&idle, &connection->idle);
+  idlist_remove(&all, &connection->all);
+  free(connection);
+
+  print_all(&all);
+  print_idle(&idle);
+
+  // Destroy the lists
+  fprintf(stdout, "Destroying the lists\n");
+  idlist_destroy(&idle);
+  idlist_destroy(&all);
+
+  return 0;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+static void destroy_connection(IDList_Element_t *element)
+{
+  free(idlist_entry(element, Connection_t, all));
+}
+
+
+static void print_all(const IDList_t *list)
+{
+  IDList_Element_t *element;
+
+  fprintf(stdout, "All (%d):", idlist_size(list));
+  for (element = idlist_head(list); element != NULL; element = idlist_next(element))
+    fprintf(stdout, " %d", idlist_entry(element, Connection_t, all)->fd);
+  fprintf(stdout, "\n");
+}
+
+
+static void print_idle(const IDList_t *list)
+{
+  IDList_Element_t *element;
+
+  fprintf(stdout, "Idle (%d):", idlist_size(list));
+  for (element = idlist_head(list); element != NULL; element = idlist_next(element))
+    fprintf(stdout, " %d", idlist_entry(element, Connection_t, idle)->fd);
+  fprintf(stdout, "\n");
+}
@@ -0,0 +1,199 @@
+/**
+@file ilist_example.c
+@brief 
+Example usage of intrusive linked-list ADT
+
+The second half builds the same list of BENCH_SIZE records as an IList_t and
+as a List_t of pointers to separately allocated records, then times summing
+the records by walking each list.
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "ilist.h"
+#include "list.h"
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+#define BENCH_SIZE   1000000
+#define BENCH_PASSES 20
+
+typedef struct Record_T {
+  int id;
+  int value;
+  IList_Element_t link; ///< Links the record into a list
+} Record_t;
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static void destroy_record(IList_Element_t *element);
+static void print_ilist(const IList_t *list);
+static double now(void);
+static void benchmark(void);
+
+// =============================================================================
+// Main Program
+// =============================================================================
+
+int main(int argc, char *argv[])
+{
+  IList_t list;
+  IList_Element_t *element;
+  Record_t *record;
+  int i;
+
+  // Initialize the linked-list
+  ilist_init(&list, destroy_record);
+
+  // Each record is a single allocation; the list allocates nothing
+  element = NULL;
+
+  for (i = 1; i <= 10; i++) {
+    if ((record = (Record_t *)malloc(sizeof (Record_t))) == NULL)
+      return 1;
+
+    record->id = i;
+    record->value = i * i;
+
+    if (ilist_insert_next(&list, element, &record->link) != 0)
+      return 1;
+
+    element = &record->link;
+  }
+
+  print_ilist(&list);
+
+  // Remove the record after the head
+  fprintf(stdout, "Removing the record after the head\n");
+
+  if (ilist_remove_next(&list, ilist_head(&list), &element) != 0)
+    return 1;
+
+  record = ilist_entry(element, Record_t, link);
+  fprintf(stdout, "Removed record %d\n", record->id);
+
+  // The record is not freed by the removal, so it can go back in at the head
+  fprintf(stdout, "Reinserting it at the head\n");
+
+  if (ilist_insert_next(&list, NULL, &record->link) != 0)
+    return 1;
+
+  print_ilist(&list);
+
+  // Destroy the linked list
+  fprintf(stdout, "Destroying the list\n");
+  ilist_destroy(&list);
+
+  benchmark();
+
+  return 0;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+static void destroy_record(IList_Element_t *element)
+{
+  free(ilist_entry(element, Record_t, link));
+}
+
+
+static void print_ilist(const IList_t *list)
+{
+  IList_Element_t *element;
+  Record_t *record;
+  int i;
+
+  fprintf(stdout, "List size is %d\n", ilist_size(list));
+
+  i = 0;
+  for (element = ilist_head(list); element != NULL; element = ilist_next(element)) {
+    record = ilist_entry(element, Record_t, link);
+    fprintf(stdout, "list[%03d]: id=%02d value=%03d\n", i++, record->id, record->value);
+  }
+}
+
+
+static double now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+
+static void benchmark(void)
+{
+  IList_t ilist;
+  List_t list;
+  IList_Element_t *ielement;
+  List_Element_t *element;
+  Record_t *records;
+  Record_t *record;
+  long long isum;
+  long long sum;
+  double start;
+  double itime;
+  double time;
+  int pass;
+  int i;
+
+  fprintf(stdout, "\nSumming %d records %d times\n", BENCH_SIZE, BENCH_PASSES);
+
+  // Intrusive list over one array of records
+  if ((records = (Record_t *)malloc(BENCH_SIZE * sizeof (Record_t))) == NULL)
+    return;
+
+  ilist_init(&ilist, NULL);
+  ielement = NULL;
+  for (i = 0; i < BENCH_SIZE; i++) {
+    records[i].id = i;
+    records[i].value = i % 1000;
+    ilist_insert_next(&ilist, ielement, &records[i].link);
+    ielement = &records[i].link;
+  }
+
+  // List_t over separately allocated records, as the other containers store them
+  list_init(&list, free);
+  element = NULL;
+  for (i = 0; i < BENCH_SIZE; i++) {
+    if ((record = (Record_t *)malloc(sizeof (Record_t))) == NULL)
+      break;
+    record->id = i;
+    record->value = i % 1000;
+    list_insert_next(&list, element, record);
+    element = element == NULL ? list_head(&list) : list_next(element);
+  }
+
+  start = now();
+  isum = 0;
+  for (pass = 0; pass < BENCH_PASSES; pass++)
+    for (ielement = ilist_head(&ilist); ielement != NULL; ielement = ilist_next(ielement))
+      isum += ilist_entry(ielement, Record_t, link)->value;
+  itime = now() - start;
+
+  start = now();
+  sum = 0;
+  for (pass = 0; pass < BENCH_PASSES; pass++)
+    for (element = list_head(&list); element != NULL; element = list_next(element))
+      sum += ((Record_t *)list_data(element))->value;
+  time = now() - start;
+
+  fprintf(stdout, "IList_t: %6.2f ns/element (sum %lld)\n", 
+    itime * 1e9 / ((double)BENCH_SIZE * BENCH_PASSES), isum);
+  fprintf(stdout, "List_t:  %6.2f ns/element (sum %lld)\n", 
+    time * 1e9 / ((double)BENCH_SIZE * BENCH_PASSES), sum);
+
+  ilist_destroy(&ilist);
+  free(records);
+  list_destroy(&list);
+}
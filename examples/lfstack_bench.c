@@ -0,0 +1,192 @@
+/**
+@file lfstack_bench.c
+@brief 
+Contention benchmark of lock-free stack ADT
+
+The stack is used as a shared free-list of buffers: each of T threads
+repeatedly pops a buffer, touches it, and pushes it back. This is run against
+a mutex protected Stack_t and LFStack_t for T = 1..32. Afterwards every buffer
+must be back on the stack exactly once.
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "stack.h"
+#include "lfstack.h"
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+#define BENCH_SIZE  2000000
+#define BUFFERS     64
+#define MAX_THREADS 32
+
+typedef struct LockedStack_T {
+  pthread_mutex_t lock;
+  Stack_t stack;
+} LockedStack_t;
+
+typedef struct Worker_T {
+  void *stack;
+  int count; ///< Number of pop/push pairs to perform
+} Worker_t;
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static double now(void);
+static double run(int threads, void *stack, void *(*worker)(void *));
+
+static void *locked_worker(void *arg);
+static void *lfstack_worker(void *arg);
+
+static int buffers[BUFFERS];
+
+// =============================================================================
+// Main Program
+// =============================================================================
+
+int main(int argc, char *argv[])
+{
+  LockedStack_t locked;
+  LFStack_t lfstack;
+  char seen[BUFFERS];
+  double locked_time;
+  double lfstack_time;
+  int locked_ok;
+  int lfstack_ok;
+  int threads;
+  int *data;
+  int i;
+
+  fprintf(stdout, "Cycling %d buffers through a shared free-list, %d pop/push pairs\n", 
+    BUFFERS, BENCH_SIZE);
+  fprintf(stdout, " T | Stack_t + mutex     | LFStack_t\n");
+
+  for (threads = 1; threads <= MAX_THREADS; threads *= 2) {
+    // Mutex protected linked-list stack
+    pthread_mutex_init(&locked.lock, NULL);
+    stack_init(&locked.stack, NULL);
+    for (i = 0; i < BUFFERS; i++)
+      stack_push(&locked.stack, &buffers[i]);
+
+    locked_time = run(threads, &locked, locked_worker);
+
+    memset(seen, 0, sizeof (seen));
+    locked_ok = stack_size(&locked.stack) == BUFFERS;
+    while (stack_pop(&locked.stack, (void **)&data) == 0)
+      locked_ok &= seen[data - buffers]++ == 0;
+
+    stack_destroy(&locked.stack);
+    pthread_mutex_destroy(&locked.lock);
+
+    // Lock-free stack
+    lfstack_init(&lfstack, BUFFERS, NULL);
+    for (i = 0; i < BUFFERS; i++)
+      lfstack_push(&lfstack, &buffers[i]);
+
+    lfstack_time = run(threads, &lfstack, lfstack_worker);
+
+    memset(seen, 0, sizeof (seen));
+    for (lfstack_ok = 1, i = 0; lfstack_pop(&lfstack, (void **)&data) == 0; i++)
+      lfstack_ok &= seen[data - buffers]++ == 0;
+    lfstack_ok &= i == BUFFERS;
+
+    lfstack_destroy(&lfstack);
+
+    fprintf(stdout, "%2d | %-3s %6.1f Mops/s     | %-3s %6.1f Mops/s\n", threads, 
+      locked_ok ? "OK" : "BAD", BENCH_SIZE / locked_time / 1e6, 
+      lfstack_ok ? "OK" : "BAD", BENCH_SIZE / lfstack_time / 1e6);
+  }
+
+  return 0;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+static double now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+
+static double run(int threads, void *stack, void *(*worker)(void *))
+{
+  pthread_t ids[MAX_THREADS];
+  Worker_t workers[MAX_THREADS];
+  double start;
+  int i;
+
+  for (i = 0; i < threads; i++) {
+    workers[i].stack = stack;
+    workers[i].count = BENCH_SIZE / threads;
+  }
+
+  start = now();
+
+  for (i = 0; i < threads; i++)
+    pthread_create(&ids[i], NULL, worker, &workers[i]);
+  for (i = 0; i < threads; i++)
+    pthread_join(ids[i], NULL);
+
+  return now() - start;
+}
+
+
+static void *locked_worker(void *arg)
+{
+  Worker_t *worker = (Worker_t *)arg;
+  LockedStack_t *locked = (LockedStack_t *)worker->stack;
+  void *data;
+  int retval;
+  int i;
+
+  for (i = 0; i < worker->count; i++) {
+    pthread_mutex_lock(&locked->lock);
+    retval = stack_pop(&locked->stack, &data);
+    pthread_mutex_unlock(&locked->lock);
+
+    // Every thread holds at most one buffer, so the free-list never runs dry
+    if (retval != 0)
+      continue;
+
+    (*(int *)data)++;
+
+    pthread_mutex_lock(&locked->lock);
+    stack_push(&locked->stack, data);
+    pthread_mutex_unlock(&locked->lock);
+  }
+  return NULL;
+}
+
+
+static void *lfstack_worker(void *arg)
+{
+  Worker_t *worker = (Worker_t *)arg;
+  LFStack_t *stack = (LFStack_t *)worker->stack;
+  void *data;
+  int i;
+
+  for (i = 0; i < worker->count; i++) {
+    if (lfstack_pop(stack, &data) != 0)
+      continue;
+
+    (*(int *)data)++;
+
+    lfstack_push(stack, data);
+  }
+  return NULL;
+}
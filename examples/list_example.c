@@ -24,6 +24,7 @@ static void print_list(const List_t *list);
 int main(int argc, char *argv[])
 {
   List_t list;
+  List_t other;
   List_Element_t *element;
 
   int *data;
@@ -112,9 +113,26 @@ int main(int argc, char *argv[])
   i = list_is_tail(list_head(&list));
   fprintf(stdout, "Testing list_is_tail...Value=%d (0=OK)\n", i);
 
-  // Destroy the linked list
-  fprintf(stdout, "Destroying the list\n");
+  fprintf(stdout, "Splitting the list after the third element\n");
+
+  element = list_next(list_next(list_head(&list)));
+  if (list_split(&list, element, &other) != 0)
+    return 1;
+
+  print_list(&list);
+  print_list(&other);
+
+  fprintf(stdout, "Concatenating the two halves in the other order\n");
+
+  if (list_concat(&other, &list) != 0)
+    return 1;
+
+  print_list(&other);
+
+  // Destroy the linked lists
+  fprintf(stdout, "Destroying the lists\n");
   list_destroy(&list);
+  list_destroy(&other);
 
   return 0;
 }
@@ -0,0 +1,232 @@
+/**
+@file listsort_example.c
+@brief 
+Example usage of the linked-list sorts
+
+Sorts a small list of records by key to show that the sort is stable, then
+times sorting BENCH_SIZE records by copying the data out to an array for
+_qsort_ and rebuilding the list, by *list_sort()*, and by
+*list_sort_parallel()* on 2, 4 and 8 threads. Each sorted list is
+checked to be in order with ties in their original order.
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "dlist.h"
+#include "list.h"
+#include "listsort.h"
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+#define BENCH_SIZE  1000000
+#define BENCH_KEYS  100000
+
+typedef struct Record_T {
+  int key;
+  int seq; ///< Position in the unsorted list, to check stability
+} Record_t;
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static int compare_records(const void *key1, const void *key2);
+static int compare_indirect(const void *key1, const void *key2);
+static int is_sorted(const List_t *list);
+static int sort_by_qsort(List_t *list);
+static void build(List_t *list, Record_t *records);
+static double now(void);
+static void benchmark(void);
+
+// =============================================================================
+// Main Program
+// =============================================================================
+
+int main(int argc, char *argv[])
+{
+  static const int keys[] = { 5, 3, 5, 1, 3, 9, 1, 5 };
+  Record_t records[8];
+  DList_t list;
+  DList_Element_t *element;
+  Record_t *record;
+  int i;
+
+  dlist_init(&list, NULL);
+
+  for (i = 0; i < 8; i++) {
+    records[i].key = keys[i];
+    records[i].seq = i;
+    if (dlist_insert_next(&list, dlist_tail(&list), &records[i]) != 0)
+      return 1;
+  }
+
+  fprintf(stdout, "Before sorting (key/original position):");
+  for (element = dlist_head(&list); element != NULL; element = dlist_next(element)) {
+    record = (Record_t *)dlist_data(element);
+    fprintf(stdout, " %d/%d", record->key, record->seq);
+  }
+  fprintf(stdout, "\n");
+
+  dlist_sort(&list, compare_records);
+
+  fprintf(stdout, "After sorting:                         ");
+  for (element = dlist_head(&list); element != NULL; element = dlist_next(element)) {
+    record = (Record_t *)dlist_data(element);
+    fprintf(stdout, " %d/%d", record->key, record->seq);
+  }
+  fprintf(stdout, "\n");
+
+  fprintf(stdout, "Backwards:                             ");
+  for (element = dlist_tail(&list); element != NULL; element = dlist_prev(element)) {
+    record = (Record_t *)dlist_data(element);
+    fprintf(stdout, " %d/%d", record->key, record->seq);
+  }
+  fprintf(stdout, "\n");
+
+  dlist_destroy(&list);
+
+  benchmark();
+
+  return 0;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+static int compare_records(const void *key1, const void *key2)
+{
+  const Record_t *a = (const Record_t *)key1;
+  const Record_t *b = (const Record_t *)key2;
+
+  return (a->key > b->key) - (a->key < b->key);
+}
+
+
+static int compare_indirect(const void *key1, const void *key2)
+{
+  const Record_t *a = *(Record_t *const *)key1;
+  const Record_t *b = *(Record_t *const *)key2;
+
+  // qsort is not stable, so ties are broken on the original position
+  if (a->key != b->key)
+    return (a->key > b->key) - (a->key < b->key);
+  return (a->seq > b->seq) - (a->seq < b->seq);
+}
+
+
+static int is_sorted(const List_t *list)
+{
+  List_Element_t *element;
+  Record_t *a;
+  Record_t *b;
+  int count = 1;
+
+  for (element = list_head(list); list_next(element) != NULL; element = list_next(element)) {
+    a = (Record_t *)list_data(element);
+    b = (Record_t *)list_data(list_next(element));
+    if (a->key > b->key || (a->key == b->key && a->seq > b->seq))
+      return 0;
+    count++;
+  }
+  return count == list_size(list) && element == list_tail(list);
+}
+
+
+static int sort_by_qsort(List_t *list)
+{
+  void **items;
+  void *data;
+  int size;
+  int i;
+
+  // What sorting a list took before: copy out, sort, and rebuild
+  size = list_size(list);
+  if ((items = (void **)malloc(size * sizeof (void *))) == NULL)
+    return -1;
+
+  for (i = 0; i < size; i++)
+    list_remove_next(list, NULL, &items[i]);
+
+  qsort(items, size, sizeof (void *), compare_indirect);
+
+  for (i = size - 1; i >= 0; i--) {
+    data = items[i];
+    list_insert_next(list, NULL, data);
+  }
+
+  free(items);
+  return 0;
+}
+
+
+static void build(List_t *list, Record_t *records)
+{
+  int i;
+
+  list_init(list, NULL);
+  for (i = BENCH_SIZE - 1; i >= 0; i--)
+    list_insert_next(list, NULL, &records[i]);
+}
+
+
+static double now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+
+static void benchmark(void)
+{
+  static const char *names[] = { 
+    "qsort + rebuild:       ", "list_sort:             ", 
+    "list_sort_parallel (2):", "list_sort_parallel (4):", "list_sort_parallel (8):" 
+  };
+  Record_t *records;
+  List_t lists[5];
+  double start;
+  int i;
+
+  if ((records = (Record_t *)malloc(BENCH_SIZE * sizeof (Record_t))) == NULL)
+    return;
+
+  srand(1);
+  for (i = 0; i < BENCH_SIZE; i++) {
+    records[i].key = rand() % BENCH_KEYS;
+    records[i].seq = i;
+  }
+
+  // All lists are built before any is sorted, so none of them is made from
+  // elements freed by an earlier sort in a scattered order
+  for (i = 0; i < 5; i++)
+    build(&lists[i], records);
+
+  fprintf(stdout, "\nSorting %d records\n", BENCH_SIZE);
+
+  for (i = 0; i < 5; i++) {
+    start = now();
+
+    if (i == 0)
+      sort_by_qsort(&lists[i]);
+    else if (i == 1)
+      list_sort(&lists[i], compare_records);
+    else
+      list_sort_parallel(&lists[i], compare_records, 1 << (i - 1));
+
+    fprintf(stdout, "%s %6.3f s %s\n", names[i], now() - start, 
+      is_sorted(&lists[i]) ? "OK" : "BAD");
+  }
+
+  for (i = 0; i < 5; i++)
+    list_destroy(&lists[i]);
+
+  free(records);
+}
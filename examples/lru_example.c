@@ -0,0 +1,216 @@
+/**
+@file lru_example.c
+@brief 
+Example usage of least-recently-used cache ADT
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "dlist.h"
+#include "hashstr.h"
+#include "hashtable.h"
+#include "lru.h"
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+#define BENCH_ENTRIES 10000
+#define BENCH_KEYS    20000
+#define BENCH_GETS    200000
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static int match_str(const void *key1, const void *key2);
+static uint64_t hash_int(const void *key);
+static int match_int(const void *key1, const void *key2);
+static void print_evict(void *key, void *value);
+static void print_cache(const LRUCache_t *cache);
+static void benchmark(void);
+
+// =============================================================================
+// Main Program
+// =============================================================================
+
+int main(int argc, char *argv[])
+{
+  static const char *pages[] = { "/", "/about", "/blog", "/contact", "/docs" };
+  LRUCache_t cache;
+  void *key;
+  void *value;
+  int i;
+
+  // A cache of at most 3 pages weighing at most 2000 bytes in total
+  if (lru_init(&cache, 8, 3, 2000, hashstr64_cstr, match_str, print_evict) != 0)
+    return 1;
+
+  fprintf(stdout, "Putting 3 pages\n");
+
+  for (i = 0; i < 3; i++)
+    lru_put(&cache, pages[i], pages[i], 500);
+
+  print_cache(&cache);
+
+  fprintf(stdout, "Getting %s\n", pages[0]);
+  if (lru_get(&cache, pages[0], &value) == 0)
+    fprintf(stdout, "Hit: %s\n", (char *)value);
+
+  print_cache(&cache);
+
+  fprintf(stdout, "Putting %s (over the entry limit)\n", pages[3]);
+  lru_put(&cache, pages[3], pages[3], 500);
+
+  print_cache(&cache);
+
+  fprintf(stdout, "Putting %s weighing 1200 (over the weight limit)\n", pages[4]);
+  lru_put(&cache, pages[4], pages[4], 1200);
+
+  print_cache(&cache);
+
+  fprintf(stdout, "Getting %s\n", pages[1]);
+  if (lru_get(&cache, pages[1], &value) != 0)
+    fprintf(stdout, "Miss\n");
+
+  fprintf(stdout, "Removing %s\n", pages[4]);
+  key = (void *)pages[4];
+  if (lru_remove(&cache, &key, &value) == 0)
+    fprintf(stdout, "Removed %s\n", (char *)key);
+
+  print_cache(&cache);
+
+  // Destroy the cache (evicts what is left)
+  fprintf(stdout, "Destroying the cache\n");
+  lru_destroy(&cache);
+
+  // Compare against a hash table whose values must be searched for in a list
+  benchmark();
+
+  return 0;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+static int match_str(const void *key1, const void *key2)
+{
+  return strcmp((const char *)key1, (const char *)key2) == 0;
+}
+
+
+static uint64_t hash_int(const void *key)
+{
+  return (uint64_t)*(const int *)key * 0x9e3779b97f4a7c15ULL;
+}
+
+
+static int match_int(const void *key1, const void *key2)
+{
+  return *(const int *)key1 == *(const int *)key2;
+}
+
+
+static void print_evict(void *key, void *value)
+{
+  (void)value;
+
+  // The key is NULL when a put replaced only the value
+  if (key != NULL)
+    fprintf(stdout, "Evicted %s\n", (char *)key);
+}
+
+
+static void print_cache(const LRUCache_t *cache)
+{
+  DList_Element_t *element;
+  LRUCache_Entry_t *entry;
+
+  // Display the entries, most recently used first
+  fprintf(stdout, "Cache size is %d, weight %zu:", lru_size(cache), lru_weight(cache));
+
+  for (element = dlist_head(&cache->recency); element != NULL; element = dlist_next(element)) {
+    entry = (LRUCache_Entry_t *)dlist_data(element);
+    fprintf(stdout, " %s", (char *)entry->key);
+  }
+  fprintf(stdout, "\n");
+}
+
+
+static void benchmark(void)
+{
+  HashTable_t htable;
+  DList_t recency;
+  DList_Element_t *element;
+  LRUCache_t cache;
+  clock_t start;
+  int *keys;
+  void *data;
+  int hits;
+  int i;
+
+  fprintf(stdout, "Benchmarking %d gets on %d entries (%d keys)\n", 
+    BENCH_GETS, BENCH_ENTRIES, BENCH_KEYS);
+
+  if ((keys = (int *)malloc(BENCH_KEYS * sizeof (int))) == NULL)
+    return;
+
+  for (i = 0; i < BENCH_KEYS; i++)
+    keys[i] = i;
+
+  // Hand-rolled: the hash table finds the key, the list is searched for it
+  // (so slow that only one in a hundred of the gets is run)
+  start = clock();
+  hashtable_init(&htable, BENCH_ENTRIES, hash_int, match_int, NULL);
+  dlist_init(&recency, NULL);
+
+  for (i = 0; i < BENCH_ENTRIES; i++) {
+    hashtable_insert(&htable, &keys[i]);
+    dlist_insert_prev(&recency, dlist_head(&recency), &keys[i]);
+  }
+
+  srand(1);
+  for (hits = 0, i = 0; i < BENCH_GETS / 100; i++) {
+    data = &keys[rand() % BENCH_KEYS];
+    if (hashtable_lookup(&htable, &data) != 0)
+      continue;
+
+    for (element = dlist_head(&recency); dlist_data(element) != data; element = dlist_next(element))
+      ;
+    dlist_remove(&recency, element, &data);
+    dlist_insert_prev(&recency, dlist_head(&recency), data);
+    hits++;
+  }
+
+  dlist_destroy(&recency);
+  hashtable_destroy(&htable);
+  fprintf(stdout, "HashTable_t + DList_t scan: hits=%d (of %d gets) %.0f ns/get\n", 
+    hits, BENCH_GETS / 100, 1e9 * (clock() - start) / CLOCKS_PER_SEC / (BENCH_GETS / 100));
+
+  // LRU cache
+  start = clock();
+  lru_init(&cache, BENCH_ENTRIES, BENCH_ENTRIES, 0, hash_int, match_int, NULL);
+
+  for (i = 0; i < BENCH_ENTRIES; i++)
+    lru_put(&cache, &keys[i], &keys[i], 1);
+
+  srand(1);
+  for (hits = 0, i = 0; i < BENCH_GETS; i++) {
+    if (lru_get(&cache, &keys[rand() % BENCH_KEYS], &data) == 0)
+      hits++;
+    else
+      lru_put(&cache, &keys[rand() % BENCH_KEYS], &keys[0], 1);
+  }
+
+  lru_destroy(&cache);
+  fprintf(stdout, "LRUCache_t:                 hits=%d (of %d gets) %.0f ns/get\n", 
+    hits, BENCH_GETS, 1e9 * (clock() - start) / CLOCKS_PER_SEC / BENCH_GETS);
+
+  free(keys);
+}
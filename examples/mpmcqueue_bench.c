@@ -0,0 +1,216 @@
+/**
+@file mpmcqueue_bench.c
+@brief 
+Throughput benchmark of lock-free multi-producer/multi-consumer queue ADT
+
+For each thread count T, T producers and T consumers pass BENCH_SIZE elements
+in total, first through a mutex protected Queue_t and then through MPMCQueue_t.
+Every element is checked off by summing, so lost or duplicated elements show
+up as BAD.
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "queue.h"
+#include "mpmcqueue.h"
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+#define BENCH_SIZE  2000000
+#define RING_SIZE   1024
+#define MAX_THREADS 8
+
+typedef struct LockedQueue_T {
+  pthread_mutex_t lock;
+  Queue_t queue;
+} LockedQueue_t;
+
+typedef struct Worker_T {
+  void *queue;
+  uintptr_t first; ///< First element produced (producers only)
+  int count;       ///< Number of elements to produce or consume
+  uint64_t sum;    ///< Sum of elements consumed (consumers only)
+} Worker_t;
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static double now(void);
+static double run(int threads, void *queue, 
+  void *(*producer)(void *), void *(*consumer)(void *), int *ok);
+
+static void *locked_producer(void *arg);
+static void *locked_consumer(void *arg);
+static void *mpmc_producer(void *arg);
+static void *mpmc_consumer(void *arg);
+
+// =============================================================================
+// Main Program
+// =============================================================================
+
+int main(int argc, char *argv[])
+{
+  LockedQueue_t locked;
+  MPMCQueue_t mpmc;
+  double locked_time;
+  double mpmc_time;
+  int locked_ok;
+  int mpmc_ok;
+  int threads;
+
+  fprintf(stdout, "Passing %d elements between T producers and T consumers\n", 
+    BENCH_SIZE);
+  fprintf(stdout, " T | Queue_t + mutex     | MPMCQueue_t\n");
+
+  for (threads = 1; threads <= MAX_THREADS; threads *= 2) {
+    pthread_mutex_init(&locked.lock, NULL);
+    queue_init(&locked.queue, NULL);
+    locked_time = run(threads, &locked, locked_producer, locked_consumer, &locked_ok);
+    queue_destroy(&locked.queue);
+    pthread_mutex_destroy(&locked.lock);
+
+    mpmcqueue_init(&mpmc, RING_SIZE, NULL);
+    mpmc_time = run(threads, &mpmc, mpmc_producer, mpmc_consumer, &mpmc_ok);
+    mpmcqueue_destroy(&mpmc);
+
+    fprintf(stdout, "%2d | %-3s %6.1f Mops/s     | %-3s %6.1f Mops/s\n", threads, 
+      locked_ok ? "OK" : "BAD", BENCH_SIZE / locked_time / 1e6, 
+      mpmc_ok ? "OK" : "BAD", BENCH_SIZE / mpmc_time / 1e6);
+  }
+
+  return 0;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+static double now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+
+static double run(int threads, void *queue, 
+  void *(*producer)(void *), void *(*consumer)(void *), int *ok)
+{
+  pthread_t ids[2 * MAX_THREADS];
+  Worker_t workers[2 * MAX_THREADS];
+  uint64_t expected;
+  uint64_t sum;
+  double start;
+  int share;
+  int i;
+
+  // The elements are the integers 1..BENCH_SIZE smuggled through the pointer,
+  // dealt out in equal shares (the last thread takes the remainder)
+  share = BENCH_SIZE / threads;
+  for (i = 0; i < threads; i++) {
+    workers[i].queue = queue;
+    workers[i].first = 1 + (uintptr_t)i * share;
+    workers[i].count = i == threads - 1 ? BENCH_SIZE - i * share : share;
+
+    workers[threads + i].queue = queue;
+    workers[threads + i].count = workers[i].count;
+    workers[threads + i].sum = 0;
+  }
+
+  start = now();
+
+  for (i = 0; i < threads; i++) {
+    pthread_create(&ids[i], NULL, producer, &workers[i]);
+    pthread_create(&ids[threads + i], NULL, consumer, &workers[threads + i]);
+  }
+  for (i = 0; i < 2 * threads; i++)
+    pthread_join(ids[i], NULL);
+
+  start = now() - start;
+
+  sum = 0;
+  for (i = 0; i < threads; i++)
+    sum += workers[threads + i].sum;
+
+  expected = (uint64_t)BENCH_SIZE * (BENCH_SIZE + 1) / 2;
+  *ok = sum == expected;
+
+  return start;
+}
+
+
+static void *locked_producer(void *arg)
+{
+  Worker_t *worker = (Worker_t *)arg;
+  LockedQueue_t *locked = (LockedQueue_t *)worker->queue;
+  int i;
+
+  for (i = 0; i < worker->count; i++) {
+    pthread_mutex_lock(&locked->lock);
+    queue_enqueue(&locked->queue, (void *)(worker->first + i));
+    pthread_mutex_unlock(&locked->lock);
+  }
+  return NULL;
+}
+
+
+static void *locked_consumer(void *arg)
+{
+  Worker_t *worker = (Worker_t *)arg;
+  LockedQueue_t *locked = (LockedQueue_t *)worker->queue;
+  void *data;
+  int count = 0;
+  int retval;
+
+  while (count < worker->count) {
+    pthread_mutex_lock(&locked->lock);
+    retval = queue_dequeue(&locked->queue, &data);
+    pthread_mutex_unlock(&locked->lock);
+
+    if (retval == 0) {
+      worker->sum += (uintptr_t)data;
+      count++;
+    }
+    else
+      sched_yield();
+  }
+  return NULL;
+}
+
+
+static void *mpmc_producer(void *arg)
+{
+  Worker_t *worker = (Worker_t *)arg;
+  MPMCQueue_t *queue = (MPMCQueue_t *)worker->queue;
+  int i;
+
+  for (i = 0; i < worker->count; i++)
+    mpmcqueue_enqueue(queue, (void *)(worker->first + i));
+
+  return NULL;
+}
+
+
+static void *mpmc_consumer(void *arg)
+{
+  Worker_t *worker = (Worker_t *)arg;
+  MPMCQueue_t *queue = (MPMCQueue_t *)worker->queue;
+  void *data;
+  int i;
+
+  for (i = 0; i < worker->count; i++) {
+    mpmcqueue_dequeue(queue, &data);
+    worker->sum += (uintptr_t)data;
+  }
+  return NULL;
+}
@@ -0,0 +1,236 @@
+/**
+@file msqueue_example.c
+@brief 
+Example usage of unbounded lock-free queue ADT
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "queue.h"
+#include "msqueue.h"
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+#define BENCH_THREADS 4
+#define BENCH_ROUNDS  250000
+#define BENCH_BURST   8
+
+typedef struct LockedQueue_T {
+  pthread_mutex_t lock;
+  Queue_t queue;
+} LockedQueue_t;
+
+typedef struct Worker_T {
+  void *queue;
+  uintptr_t first; ///< First value this worker enqueues
+  uint64_t in;     ///< Sum of values enqueued
+  uint64_t out;    ///< Sum of values dequeued
+} Worker_t;
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static double now(void);
+static void benchmark(void);
+static void *locked_worker(void *arg);
+static void *msqueue_worker(void *arg);
+
+// =============================================================================
+// Main Program
+// =============================================================================
+
+int main(int argc, char *argv[])
+{
+  MSQueue_t queue;
+  MSQueue_Handle_t handle;
+
+  int *data;
+  int i;
+
+  // Initialize the queue and register this thread with it
+  msqueue_init(&queue, free);
+
+  if (msqueue_register(&queue, &handle) != 0)
+    return 1;
+
+  // Perform some queue operations
+  fprintf(stdout, "Enqueuing 10 elements\n");
+
+  for (i = 0; i < 10; i++) {
+    if ((data = (int *)malloc(sizeof(int))) == NULL)
+      return 1;
+
+    *data = i + 1;
+
+    if (msqueue_enqueue(&handle, data) != 0)
+      return 1;
+  }
+
+  fprintf(stdout, "Dequeuing 5 elements\n");
+
+  for (i = 0; i < 5; i++) {
+    if (msqueue_dequeue(&handle, (void **)&data) != 0)
+      return 1;
+
+    fprintf(stdout, "dequeued=%03d\n", *data);
+    free(data);
+  }
+
+  fprintf(stdout, "Elements waiting for reclamation: %d\n", 
+    epoch_pending(handle.record));
+
+  // Leave the remaining 5 elements for msqueue_destroy
+  fprintf(stdout, "Destroying the queue\n");
+  msqueue_unregister(&handle);
+  msqueue_destroy(&queue);
+
+  // Compare against a mutex protected linked-list queue
+  benchmark();
+
+  return 0;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+static double now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+
+static void benchmark(void)
+{
+  LockedQueue_t locked;
+  MSQueue_t queue;
+  pthread_t ids[BENCH_THREADS];
+  Worker_t workers[BENCH_THREADS];
+  uint64_t in;
+  uint64_t out;
+  double start;
+  int i;
+
+  // Each thread enqueues a burst then dequeues a burst, over and over
+  fprintf(stdout, "Benchmarking %d threads x %d rounds of %d enqueues/dequeues\n", 
+    BENCH_THREADS, BENCH_ROUNDS, BENCH_BURST);
+
+  pthread_mutex_init(&locked.lock, NULL);
+  queue_init(&locked.queue, NULL);
+
+  for (i = 0; i < BENCH_THREADS; i++) {
+    workers[i].queue = &locked;
+    workers[i].first = 1 + (uintptr_t)i * BENCH_ROUNDS * BENCH_BURST;
+  }
+
+  start = now();
+  for (i = 0; i < BENCH_THREADS; i++)
+    pthread_create(&ids[i], NULL, locked_worker, &workers[i]);
+  for (i = 0; i < BENCH_THREADS; i++)
+    pthread_join(ids[i], NULL);
+  start = now() - start;
+
+  for (in = out = 0, i = 0; i < BENCH_THREADS; i++) {
+    in += workers[i].in;
+    out += workers[i].out;
+  }
+  fprintf(stdout, "Queue_t + mutex: %s time=%.3fs\n", in == out ? "OK" : "BAD", start);
+
+  queue_destroy(&locked.queue);
+  pthread_mutex_destroy(&locked.lock);
+
+  msqueue_init(&queue, NULL);
+
+  for (i = 0; i < BENCH_THREADS; i++)
+    workers[i].queue = &queue;
+
+  start = now();
+  for (i = 0; i < BENCH_THREADS; i++)
+    pthread_create(&ids[i], NULL, msqueue_worker, &workers[i]);
+  for (i = 0; i < BENCH_THREADS; i++)
+    pthread_join(ids[i], NULL);
+  start = now() - start;
+
+  for (in = out = 0, i = 0; i < BENCH_THREADS; i++) {
+    in += workers[i].in;
+    out += workers[i].out;
+  }
+  fprintf(stdout, "MSQueue_t:       %s time=%.3fs\n", in == out ? "OK" : "BAD", start);
+
+  msqueue_destroy(&queue);
+}
+
+
+static void *locked_worker(void *arg)
+{
+  Worker_t *worker = (Worker_t *)arg;
+  LockedQueue_t *locked = (LockedQueue_t *)worker->queue;
+  uintptr_t value = worker->first;
+  void *data;
+  int i;
+  int j;
+
+  worker->in = worker->out = 0;
+
+  for (i = 0; i < BENCH_ROUNDS; i++) {
+    for (j = 0; j < BENCH_BURST; j++, value++) {
+      pthread_mutex_lock(&locked->lock);
+      queue_enqueue(&locked->queue, (void *)value);
+      pthread_mutex_unlock(&locked->lock);
+      worker->in += value;
+    }
+
+    // Every burst enqueued is matched by a burst dequeued, so the queue never
+    // runs dry for the thread that filled it
+    for (j = 0; j < BENCH_BURST; j++) {
+      pthread_mutex_lock(&locked->lock);
+      queue_dequeue(&locked->queue, &data);
+      pthread_mutex_unlock(&locked->lock);
+      worker->out += (uintptr_t)data;
+    }
+  }
+  return NULL;
+}
+
+
+static void *msqueue_worker(void *arg)
+{
+  Worker_t *worker = (Worker_t *)arg;
+  MSQueue_Handle_t handle;
+  uintptr_t value = worker->first;
+  void *data;
+  int i;
+  int j;
+
+  worker->in = worker->out = 0;
+
+  if (msqueue_register((MSQueue_t *)worker->queue, &handle) != 0)
+    return NULL;
+
+  for (i = 0; i < BENCH_ROUNDS; i++) {
+    for (j = 0; j < BENCH_BURST; j++, value++) {
+      msqueue_enqueue(&handle, (void *)value);
+      worker->in += value;
+    }
+
+    for (j = 0; j < BENCH_BURST; j++) {
+      msqueue_dequeue(&handle, &data);
+      worker->out += (uintptr_t)data;
+    }
+  }
+
+  msqueue_unregister(&handle);
+
+  return NULL;
+}
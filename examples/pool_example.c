@@ -0,0 +1,124 @@
+/**
+@file pool_example.c
+@brief 
+Example usage of the pool allocator with the list based ADT's
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "pool.h"
+#include "dlist.h"
+#include "queue.h"
+#include "stack.h"
+
+#define BENCH_SIZE 1000000
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static double churn(Queue_t *queue);
+
+// =============================================================================
+// Main Program
+// =============================================================================
+
+int main(int argc, char *argv[])
+{
+  Pool_t pool;
+  Stack_t stack;
+  Queue_t queue;
+  DList_t list;
+  void *data;
+  int values[10];
+  int i;
+
+  // One pool sized for the largest element serves every kind of list
+  if (pool_init(&pool, sizeof (DList_Element_t), 256) != 0)
+    return 1;
+
+  stack_init_allocator(&stack, NULL, pool_allocator(&pool));
+  queue_init_allocator(&queue, NULL, pool_allocator(&pool));
+  dlist_init_allocator(&list, NULL, pool_allocator(&pool));
+
+  fprintf(stdout, "Pushing, enqueuing and inserting 10 elements\n");
+
+  for (i = 0; i < 10; i++) {
+    values[i] = i + 1;
+
+    if (stack_push(&stack, &values[i]) != 0)
+      return 1;
+
+    if (queue_enqueue(&queue, &values[i]) != 0)
+      return 1;
+
+    if (dlist_insert_next(&list, dlist_tail(&list), &values[i]) != 0)
+      return 1;
+  }
+
+  fprintf(stdout, "Stack top=%d, queue front=%d, list tail=%d\n", 
+    *(int *)stack_peek(&stack), *(int *)queue_peek(&queue), 
+    *(int *)dlist_data(dlist_tail(&list)));
+
+  fprintf(stdout, "Popping and dequeuing 5 elements\n");
+
+  for (i = 0; i < 5; i++) {
+    if (stack_pop(&stack, &data) != 0)
+      return 1;
+
+    if (queue_dequeue(&queue, &data) != 0)
+      return 1;
+  }
+
+  fprintf(stdout, "Stack top=%d, queue front=%d\n", 
+    *(int *)stack_peek(&stack), *(int *)queue_peek(&queue));
+
+  // Destroy the containers before the pool their elements came from
+  fprintf(stdout, "Destroying the containers and the pool\n");
+  stack_destroy(&stack);
+  queue_destroy(&queue);
+  dlist_destroy(&list);
+  pool_destroy(&pool);
+
+  // Compare enqueue/dequeue churn with malloc and with a pool
+  fprintf(stdout, "Benchmarking %d enqueue/dequeue pairs\n", BENCH_SIZE);
+
+  queue_init(&queue, NULL);
+  fprintf(stdout, "malloc: %.3fs\n", churn(&queue));
+  queue_destroy(&queue);
+
+  if (pool_init(&pool, sizeof (List_Element_t), 4096) != 0)
+    return 1;
+
+  queue_init_allocator(&queue, NULL, pool_allocator(&pool));
+  fprintf(stdout, "pool:   %.3fs\n", churn(&queue));
+  queue_destroy(&queue);
+  pool_destroy(&pool);
+
+  return 0;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+static double churn(Queue_t *queue)
+{
+  clock_t start;
+  void *data;
+  int i;
+
+  start = clock();
+
+  // Keep a window of 64 elements in flight
+  for (i = 0; i < BENCH_SIZE; i++) {
+    queue_enqueue(queue, queue);
+    if (queue_size(queue) > 64)
+      queue_dequeue(queue, &data);
+  }
+
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
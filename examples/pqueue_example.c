@@ -0,0 +1,253 @@
+/**
+@file pqueue_example.c
+@brief 
+Example usage of priority queue ADT
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "list.h"
+#include "pqueue.h"
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+#define GRAPH_NODES 6
+#define BENCH_SIZE  20000
+
+typedef struct Vertex_T {
+  int id;
+  int distance;
+  int handle; ///< Handle in the priority queue while queued
+} Vertex_t;
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static int compare_int(const void *key1, const void *key2);
+static int compare_vertex(const void *key1, const void *key2);
+static void dijkstra(void);
+static void benchmark(void);
+
+// =============================================================================
+// Main Program
+// =============================================================================
+
+int main(int argc, char *argv[])
+{
+  static const int values[] = { 42, 7, 19, 88, 3, 61, 25, 7, 90, 14 };
+  PQueue_t pqueue;
+  void *batch[10];
+  int handles[10];
+  int *data;
+  int i;
+
+  // Initialize the priority queue
+  pqueue_init(&pqueue, compare_int, free);
+
+  // Perform some priority queue operations
+  fprintf(stdout, "Inserting 10 elements\n");
+
+  for (i = 0; i < 10; i++) {
+    if ((data = (int *)malloc(sizeof(int))) == NULL)
+      return 1;
+
+    *data = values[i];
+
+    if (pqueue_insert(&pqueue, data) != 0)
+      return 1;
+  }
+
+  fprintf(stdout, "Queue size is %d\n", pqueue_size(&pqueue));
+
+  if ((data = pqueue_peek(&pqueue)) != NULL)
+    fprintf(stdout, "Peeking at the head element...Value=%03d\n", *data);
+
+  fprintf(stdout, "Extracting all elements\n");
+
+  while (pqueue_extract(&pqueue, (void **)&data) == 0) {
+    fprintf(stdout, "%03d ", *data);
+    free(data);
+  }
+  fprintf(stdout, "\n");
+
+  // Build the queue in one go, then change a key and remove an element
+  fprintf(stdout, "Building a queue from 10 elements\n");
+
+  for (i = 0; i < 10; i++) {
+    if ((batch[i] = malloc(sizeof(int))) == NULL)
+      return 1;
+
+    *(int *)batch[i] = values[i];
+  }
+
+  if (pqueue_build(&pqueue, batch, 10, handles) != 0)
+    return 1;
+
+  fprintf(stdout, "Decreasing 61 to 1\n");
+  *(int *)pqueue_data(&pqueue, handles[5]) = 1;
+  pqueue_update(&pqueue, handles[5]);
+
+  fprintf(stdout, "Removing 88\n");
+  if (pqueue_remove(&pqueue, handles[3], (void **)&data) == 0)
+    free(data);
+
+  fprintf(stdout, "Extracting 5 elements\n");
+
+  for (i = 0; i < 5; i++) {
+    if (pqueue_extract(&pqueue, (void **)&data) != 0)
+      return 1;
+
+    fprintf(stdout, "%03d ", *data);
+    free(data);
+  }
+  fprintf(stdout, "\n");
+
+  // Destroy the queue (frees the 4 elements left)
+  fprintf(stdout, "Destroying the queue\n");
+  pqueue_destroy(&pqueue);
+
+  // Shortest paths using decrease-key
+  dijkstra();
+
+  // Compare against scanning a linked-list for the minimum
+  benchmark();
+
+  return 0;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+static int compare_int(const void *key1, const void *key2)
+{
+  int a = *(const int *)key1;
+  int b = *(const int *)key2;
+
+  return (a > b) - (a < b);
+}
+
+
+static int compare_vertex(const void *key1, const void *key2)
+{
+  return compare_int(&((const Vertex_t *)key1)->distance, 
+    &((const Vertex_t *)key2)->distance);
+}
+
+
+static void dijkstra(void)
+{
+  // Edge weights of a small directed graph (0 = no edge)
+  static const int weights[GRAPH_NODES][GRAPH_NODES] = {
+    { 0, 7, 9, 0, 0, 14 },
+    { 7, 0, 10, 15, 0, 0 },
+    { 9, 10, 0, 11, 0, 2 },
+    { 0, 15, 11, 0, 6, 0 },
+    { 0, 0, 0, 6, 0, 9 },
+    { 14, 0, 2, 0, 9, 0 }
+  };
+  Vertex_t vertices[GRAPH_NODES];
+  PQueue_t pqueue;
+  Vertex_t *vertex;
+  int distance;
+  int i;
+
+  fprintf(stdout, "Shortest distances from vertex 0\n");
+
+  pqueue_init(&pqueue, compare_vertex, NULL);
+
+  for (i = 0; i < GRAPH_NODES; i++) {
+    vertices[i].id = i;
+    vertices[i].distance = i == 0 ? 0 : 1000000;
+    pqueue_insert_handle(&pqueue, &vertices[i], &vertices[i].handle);
+  }
+
+  while (pqueue_extract(&pqueue, (void **)&vertex) == 0) {
+    for (i = 0; i < GRAPH_NODES; i++) {
+      if (weights[vertex->id][i] == 0 || !pqueue_is_queued(&pqueue, vertices[i].handle))
+        continue;
+
+      // Relax the edge and move the neighbour up if it got closer
+      distance = vertex->distance + weights[vertex->id][i];
+      if (distance < vertices[i].distance) {
+        vertices[i].distance = distance;
+        pqueue_update(&pqueue, vertices[i].handle);
+      }
+    }
+  }
+
+  for (i = 0; i < GRAPH_NODES; i++)
+    fprintf(stdout, "distance[%d]=%d\n", i, vertices[i].distance);
+
+  pqueue_destroy(&pqueue);
+}
+
+
+static void benchmark(void)
+{
+  List_t list;
+  List_Element_t *element;
+  List_Element_t *min_prev;
+  List_Element_t *prev;
+  PQueue_t pqueue;
+  unsigned long sum;
+  int *keys;
+  void *data;
+  int min;
+  clock_t start;
+  int i;
+
+  fprintf(stdout, "Benchmarking %d inserts and extracts\n", BENCH_SIZE);
+
+  if ((keys = (int *)malloc(BENCH_SIZE * sizeof (int))) == NULL)
+    return;
+
+  srand(1);
+  for (i = 0; i < BENCH_SIZE; i++)
+    keys[i] = rand();
+
+  // Linked-list scanned for the minimum on every extract
+  start = clock();
+  list_init(&list, NULL);
+  for (i = 0; i < BENCH_SIZE; i++)
+    list_insert_next(&list, NULL, &keys[i]);
+
+  for (sum = 0; list_size(&list) > 0; ) {
+    min_prev = NULL;
+    min = *(int *)list_data(list_head(&list));
+
+    for (prev = list_head(&list), element = list_next(prev); element != NULL; 
+        prev = element, element = list_next(element)) {
+      if (*(int *)list_data(element) < min) {
+        min = *(int *)list_data(element);
+        min_prev = prev;
+      }
+    }
+    list_remove_next(&list, min_prev, &data);
+    sum = sum * 31 + *(int *)data;
+  }
+  list_destroy(&list);
+  fprintf(stdout, "List_t scan: checksum=%lu time=%.3fs\n", sum, 
+    (double)(clock() - start) / CLOCKS_PER_SEC);
+
+  // 4-ary heap
+  start = clock();
+  pqueue_init(&pqueue, compare_int, NULL);
+  for (i = 0; i < BENCH_SIZE; i++)
+    pqueue_insert(&pqueue, &keys[i]);
+
+  for (sum = 0; pqueue_extract(&pqueue, &data) == 0; )
+    sum = sum * 31 + *(int *)data;
+
+  pqueue_destroy(&pqueue);
+  fprintf(stdout, "PQueue_t:    checksum=%lu time=%.3fs\n", sum, 
+    (double)(clock() - start) / CLOCKS_PER_SEC);
+
+  free(keys);
+}
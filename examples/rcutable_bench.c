@@ -0,0 +1,319 @@
+/**
+@file rcutable_bench.c
+@brief 
+Throughput benchmark of read-mostly hash table ADT with lock-free readers
+
+For each thread count T, T readers run BENCH_READS lookups in total while one
+writer keeps inserting and removing keys, pausing WRITE_PAUSE microseconds
+between updates. The same run is made against a HashTable_t behind a
+pthread rwlock and against RCUTable_t. The odd keys stay in the table
+throughout and every lookup of one must find it, so a torn chain (or a reader
+lost during a resize) shows up as BAD.
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "hashtable.h"
+#include "rcutable.h"
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+#define BENCH_READS 4000000
+#define BENCH_KEYS  (1 << 14)
+#define WRITE_PAUSE 50
+#define MAX_THREADS 8
+
+typedef struct LockedTable_T {
+  pthread_rwlock_t lock;
+  HashTable_t table;
+} LockedTable_t;
+
+typedef struct Reader_T {
+  void *table;
+  int count;      ///< Number of lookups to run
+  uint32_t seed;  ///< State of the reader's random number generator
+  int bad;        ///< Number of lookups of odd keys that failed
+} Reader_t;
+
+typedef struct Writer_T {
+  void *table;
+  atomic_int done; ///< Set once every reader has finished
+  int updates;     ///< Number of inserts and removes made
+} Writer_t;
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static uint64_t hash_key(const void *key);
+static int match_key(const void *key1, const void *key2);
+static uint32_t next_random(uint32_t *seed);
+static void pause_writer(void);
+
+static double now(void);
+static double run(int threads, void *table, 
+  void *(*reader)(void *), void *(*writer)(void *), int *ok, int *updates);
+
+static void *locked_reader(void *arg);
+static void *locked_writer(void *arg);
+static void *rcu_reader(void *arg);
+static void *rcu_writer(void *arg);
+
+// =============================================================================
+// Main Program
+// =============================================================================
+
+int main(int argc, char *argv[])
+{
+  LockedTable_t locked;
+  RCUTable_t rcu;
+  double locked_time;
+  double rcu_time;
+  int locked_updates;
+  int rcu_updates;
+  int locked_ok;
+  int rcu_ok;
+  int threads;
+  uintptr_t key;
+
+  fprintf(stdout, "Running %d lookups on %d keys alongside one writer\n", 
+    BENCH_READS, BENCH_KEYS);
+  fprintf(stdout, " T | HashTable_t + rwlock          | RCUTable_t\n");
+
+  for (threads = 1; threads <= MAX_THREADS; threads *= 2) {
+    // Both tables start with the odd keys, sized so the writer makes them grow
+    pthread_rwlock_init(&locked.lock, NULL);
+    hashtable_init(&locked.table, BENCH_KEYS / 2, hash_key, match_key, NULL);
+    hashtable_set_load_factor(&locked.table, 1.0, 0.0);
+    for (key = 1; key <= BENCH_KEYS; key += 2)
+      hashtable_insert(&locked.table, (void *)key);
+
+    locked_time = run(threads, &locked, locked_reader, locked_writer, 
+      &locked_ok, &locked_updates);
+
+    hashtable_destroy(&locked.table);
+    pthread_rwlock_destroy(&locked.lock);
+
+    rcutable_init(&rcu, BENCH_KEYS / 2, hash_key, match_key, NULL);
+    for (key = 1; key <= BENCH_KEYS; key += 2)
+      rcutable_insert(&rcu, (void *)key);
+
+    rcu_time = run(threads, &rcu, rcu_reader, rcu_writer, &rcu_ok, &rcu_updates);
+
+    rcutable_destroy(&rcu);
+
+    fprintf(stdout, "%2d | %-3s %6.1f Mops/s %6d upd | %-3s %6.1f Mops/s %6d upd\n", 
+      threads, 
+      locked_ok ? "OK" : "BAD", BENCH_READS / locked_time / 1e6, locked_updates, 
+      rcu_ok ? "OK" : "BAD", BENCH_READS / rcu_time / 1e6, rcu_updates);
+  }
+
+  return 0;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+static uint64_t hash_key(const void *key)
+{
+  uint64_t x = (uintptr_t)key;
+
+  // splitmix64 finalizer
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+
+static int match_key(const void *key1, const void *key2)
+{
+  return key1 == key2;
+}
+
+
+static uint32_t next_random(uint32_t *seed)
+{
+  uint32_t x = *seed;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return *seed = x;
+}
+
+
+static void pause_writer(void)
+{
+  struct timespec ts = { 0, WRITE_PAUSE * 1000L };
+
+  nanosleep(&ts, NULL);
+}
+
+
+static double now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+
+static double run(int threads, void *table, 
+  void *(*reader)(void *), void *(*writer)(void *), int *ok, int *updates)
+{
+  pthread_t ids[MAX_THREADS];
+  pthread_t writer_id;
+  Reader_t readers[MAX_THREADS];
+  Writer_t writer_state;
+  double start;
+  int share;
+  int i;
+
+  // The lookups are dealt out in equal shares (the last thread takes the
+  // remainder)
+  share = BENCH_READS / threads;
+  for (i = 0; i < threads; i++) {
+    readers[i].table = table;
+    readers[i].count = i == threads - 1 ? BENCH_READS - i * share : share;
+    readers[i].seed = 2463534242u + 977u * i;
+    readers[i].bad = 0;
+  }
+
+  writer_state.table = table;
+  atomic_init(&writer_state.done, 0);
+  writer_state.updates = 0;
+
+  start = now();
+
+  pthread_create(&writer_id, NULL, writer, &writer_state);
+  for (i = 0; i < threads; i++)
+    pthread_create(&ids[i], NULL, reader, &readers[i]);
+  for (i = 0; i < threads; i++)
+    pthread_join(ids[i], NULL);
+
+  start = now() - start;
+
+  atomic_store(&writer_state.done, 1);
+  pthread_join(writer_id, NULL);
+
+  *ok = 1;
+  for (i = 0; i < threads; i++)
+    if (readers[i].bad != 0)
+      *ok = 0;
+  *updates = writer_state.updates;
+
+  return start;
+}
+
+
+static void *locked_reader(void *arg)
+{
+  Reader_t *reader = (Reader_t *)arg;
+  LockedTable_t *locked = (LockedTable_t *)reader->table;
+  uintptr_t key;
+  void *data;
+  int retval;
+  int i;
+
+  for (i = 0; i < reader->count; i++) {
+    key = 1 + next_random(&reader->seed) % BENCH_KEYS;
+    data = (void *)key;
+
+    // A lookup may move buckets while the table grows, so it needs the write
+    // lock then
+    pthread_rwlock_rdlock(&locked->lock);
+    if (hashtable_is_rehashing(&locked->table)) {
+      pthread_rwlock_unlock(&locked->lock);
+      pthread_rwlock_wrlock(&locked->lock);
+    }
+    retval = hashtable_lookup(&locked->table, &data);
+    pthread_rwlock_unlock(&locked->lock);
+
+    if ((key & 1) && (retval != 0 || data != (void *)key))
+      reader->bad++;
+  }
+  return NULL;
+}
+
+
+static void *locked_writer(void *arg)
+{
+  Writer_t *writer = (Writer_t *)arg;
+  LockedTable_t *locked = (LockedTable_t *)writer->table;
+  uint32_t seed = 88675123u;
+  uintptr_t key;
+  void *data;
+
+  while (!atomic_load(&writer->done)) {
+    key = 2 + 2 * (next_random(&seed) % (BENCH_KEYS / 2));
+    data = (void *)key;
+
+    pthread_rwlock_wrlock(&locked->lock);
+    if (hashtable_remove(&locked->table, &data) != 0)
+      hashtable_insert(&locked->table, data);
+    pthread_rwlock_unlock(&locked->lock);
+
+    writer->updates++;
+    pause_writer();
+  }
+  return NULL;
+}
+
+
+static void *rcu_reader(void *arg)
+{
+  Reader_t *reader = (Reader_t *)arg;
+  RCUTable_Handle_t handle;
+  uintptr_t key;
+  void *data;
+  int retval;
+  int i;
+
+  rcutable_register((RCUTable_t *)reader->table, &handle);
+
+  for (i = 0; i < reader->count; i++) {
+    key = 1 + next_random(&reader->seed) % BENCH_KEYS;
+    data = (void *)key;
+
+    retval = rcutable_lookup(&handle, &data);
+
+    if ((key & 1) && (retval != 0 || data != (void *)key))
+      reader->bad++;
+  }
+
+  rcutable_unregister(&handle);
+  return NULL;
+}
+
+
+static void *rcu_writer(void *arg)
+{
+  Writer_t *writer = (Writer_t *)arg;
+  RCUTable_t *table = (RCUTable_t *)writer->table;
+  uint32_t seed = 88675123u;
+  uintptr_t key;
+  void *data;
+
+  while (!atomic_load(&writer->done)) {
+    key = 2 + 2 * (next_random(&seed) % (BENCH_KEYS / 2));
+    data = (void *)key;
+
+    // The keys are plain integers, so nothing waits for a grace period
+    if (rcutable_remove(table, &data) != 0)
+      rcutable_insert(table, data);
+
+    writer->updates++;
+    pause_writer();
+  }
+  return NULL;
+}
@@ -0,0 +1,202 @@
+/**
+@file rqueue_example.c
+@brief 
+Example usage of ring-buffer queue ADT
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "queue.h"
+#include "rqueue.h"
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static void print_queue(const RQueue_t *queue);
+static void benchmark(void);
+
+// =============================================================================
+// Main Program
+// =============================================================================
+
+int main(int argc, char *argv[])
+{
+  RQueue_t queue;
+
+  int *data;
+  void *batch[10];
+  int i;
+
+  // Initialize the queue
+  rqueue_init(&queue, free);
+
+  // Perform some queue operations
+  fprintf(stdout, "Enqueuing 10 elements\n");
+
+  for (i = 0; i < 10; i++) {
+    if ((data = (int *)malloc(sizeof(int))) == NULL)
+      return 1;
+
+    *data = i + 1;
+
+    if (rqueue_enqueue(&queue, data) != 0)
+      return 1;
+  }
+
+  print_queue(&queue);
+
+  fprintf(stdout, "Dequeuing 5 elements\n");
+
+  for (i = 0; i < 5; i++) {
+    if (rqueue_dequeue(&queue, (void **)&data) == 0)
+      free(data);
+    else
+      return 1;
+  }
+
+  print_queue(&queue);
+
+  fprintf(stdout, "Dequeuing 3 elements at once\n");
+
+  if (rqueue_dequeue_n(&queue, batch, 3) != 3)
+    return 1;
+
+  for (i = 0; i < 3; i++)
+    free(batch[i]);
+
+  print_queue(&queue);
+
+  fprintf(stdout, "Enqueuing 10 elements at once\n");
+
+  for (i = 0; i < 10; i++) {
+    if ((batch[i] = malloc(sizeof(int))) == NULL)
+      return 1;
+
+    *(int *)batch[i] = 1000 + i;
+  }
+
+  if (rqueue_enqueue_n(&queue, batch, 10) != 0)
+    return 1;
+
+  fprintf(stdout, "Queue size is %d\n", rqueue_size(&queue));
+
+  fprintf(stdout, "Enqueuing 100 and 200\n");
+
+  if ((data = (int *)malloc(sizeof(int))) == NULL)
+   return 1;
+
+  *data = 100;
+
+  if (rqueue_enqueue(&queue, data) != 0)
+    return 1;
+
+  if ((data = (int *)malloc(sizeof(int))) == NULL)
+    return 1;
+
+  *data = 200;
+
+  if (rqueue_enqueue(&queue, data) != 0)
+    return 1;
+
+  print_queue(&queue);
+
+  if ((data = rqueue_peek(&queue)) != NULL)
+    fprintf(stdout, "Peeking at the head element...Value=%03d\n", *data);
+  else
+    fprintf(stdout, "Peeking at the head element...Value=NULL\n");
+
+  print_queue(&queue);
+
+  fprintf(stdout, "Dequeuing all elements\n");
+
+  while (rqueue_size(&queue) > 0) {
+    if (rqueue_dequeue(&queue, (void **)&data) == 0)
+      free(data);
+  }
+
+  if ((data = rqueue_peek(&queue)) != NULL)
+    fprintf(stdout, "Peeking at an empty queue...Value=%03d\n", *data);
+  else
+    fprintf(stdout, "Peeking at an empty queue...Value=NULL\n");
+
+  // Destroy the queue
+  fprintf(stdout, "Destroying the queue\n");
+  rqueue_destroy(&queue);
+
+  // Compare against the linked-list queue
+  benchmark();
+
+  return 0;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+static void print_queue(const RQueue_t *queue)
+{
+  int *data;
+  int size;
+  int i;
+
+  // Display the queue
+  fprintf(stdout, "Queue size is %d\n", size = rqueue_size(queue));
+
+  for (i = 0; i < size; i++) {
+    data = queue->items[(queue->head + i) & (queue->capacity - 1)];
+    fprintf(stdout, "queue[%03d]=%03d\n", i, *data);
+  }
+}
+
+
+static void benchmark(void)
+{
+  RQueue_t rqueue;
+  Queue_t queue;
+  void *batch[64];
+  clock_t start;
+  void *data;
+  int i;
+  int j;
+
+  // Move messages through the queue in bursts of 64
+  fprintf(stdout, "Benchmarking 10000000 messages\n");
+
+  for (i = 0; i < 64; i++)
+    batch[i] = &batch[i];
+
+  start = clock();
+  queue_init(&queue, NULL);
+  for (i = 0; i < 10000000 / 64; i++) {
+    for (j = 0; j < 64; j++)
+      queue_enqueue(&queue, batch[j]);
+    for (j = 0; j < 64; j++)
+      queue_dequeue(&queue, &data);
+  }
+  queue_destroy(&queue);
+  fprintf(stdout, "Queue_t:                %.3fs\n", (double)(clock() - start) / CLOCKS_PER_SEC);
+
+  start = clock();
+  rqueue_init(&rqueue, NULL);
+  for (i = 0; i < 10000000 / 64; i++) {
+    for (j = 0; j < 64; j++)
+      rqueue_enqueue(&rqueue, batch[j]);
+    for (j = 0; j < 64; j++)
+      rqueue_dequeue(&rqueue, &data);
+  }
+  rqueue_destroy(&rqueue);
+  fprintf(stdout, "RQueue_t:               %.3fs\n", (double)(clock() - start) / CLOCKS_PER_SEC);
+
+  start = clock();
+  rqueue_init(&rqueue, NULL);
+  for (i = 0; i < 10000000 / 64; i++) {
+    rqueue_enqueue_n(&rqueue, batch, 64);
+    rqueue_dequeue_n(&rqueue, batch, 64);
+  }
+  rqueue_destroy(&rqueue);
+  fprintf(stdout, "RQueue_t (batch calls): %.3fs\n", (double)(clock() - start) / CLOCKS_PER_SEC);
+}
@@ -0,0 +1,235 @@
+/**
+@file shardtable_bench.c
+@brief 
+Throughput benchmark of sharded concurrent hash table ADT
+
+For each thread count T, T threads run BENCH_OPS operations in total on a table
+preloaded with half of BENCH_KEYS keys. The mix is read-heavy: 90% lookups,
+5% inserts and 5% removes of random keys. The same run is made against a single
+HashTable_t behind one mutex and against ShardTable_t. Every lookup hit is
+checked to return its own key, so a torn table shows up as BAD.
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "hashtable.h"
+#include "shardtable.h"
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+#define BENCH_OPS   4000000
+#define BENCH_KEYS  (1 << 16)
+#define BENCH_READS 90 ///< Percentage of lookups
+#define SHARDS      64
+#define MAX_THREADS 8
+
+typedef struct LockedTable_T {
+  pthread_mutex_t lock;
+  HashTable_t table;
+} LockedTable_t;
+
+typedef struct Worker_T {
+  void *table;
+  int count;      ///< Number of operations to run
+  uint32_t seed;  ///< State of the worker's random number generator
+  int bad;        ///< Number of lookups that returned the wrong key
+} Worker_t;
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static uint64_t hash_key(const void *key);
+static int match_key(const void *key1, const void *key2);
+static uint32_t next_random(uint32_t *seed);
+
+static double now(void);
+static double run(int threads, void *table, void *(*worker)(void *), int *ok);
+
+static void *locked_worker(void *arg);
+static void *shard_worker(void *arg);
+
+// =============================================================================
+// Main Program
+// =============================================================================
+
+int main(int argc, char *argv[])
+{
+  LockedTable_t locked;
+  ShardTable_t sharded;
+  double locked_time;
+  double shard_time;
+  int locked_ok;
+  int shard_ok;
+  int threads;
+  uintptr_t key;
+
+  fprintf(stdout, "Running %d operations (%d%% lookups) on %d keys\n", 
+    BENCH_OPS, BENCH_READS, BENCH_KEYS);
+  fprintf(stdout, " T | HashTable_t + mutex | ShardTable_t (%d shards)\n", SHARDS);
+
+  for (threads = 1; threads <= MAX_THREADS; threads *= 2) {
+    pthread_mutex_init(&locked.lock, NULL);
+    hashtable_init(&locked.table, BENCH_KEYS, hash_key, match_key, NULL);
+    for (key = 1; key <= BENCH_KEYS; key += 2)
+      hashtable_insert(&locked.table, (void *)key);
+
+    locked_time = run(threads, &locked, locked_worker, &locked_ok);
+
+    hashtable_destroy(&locked.table);
+    pthread_mutex_destroy(&locked.lock);
+
+    shardtable_init(&sharded, SHARDS, BENCH_KEYS / SHARDS, hash_key, match_key, NULL);
+    for (key = 1; key <= BENCH_KEYS; key += 2)
+      shardtable_insert(&sharded, (void *)key);
+
+    shard_time = run(threads, &sharded, shard_worker, &shard_ok);
+
+    shardtable_destroy(&sharded);
+
+    fprintf(stdout, "%2d | %-3s %6.1f Mops/s     | %-3s %6.1f Mops/s\n", threads, 
+      locked_ok ? "OK" : "BAD", BENCH_OPS / locked_time / 1e6, 
+      shard_ok ? "OK" : "BAD", BENCH_OPS / shard_time / 1e6);
+  }
+
+  return 0;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+static uint64_t hash_key(const void *key)
+{
+  uint64_t x = (uintptr_t)key;
+
+  // splitmix64 finalizer, so the top bits are as good as the bottom ones
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+
+static int match_key(const void *key1, const void *key2)
+{
+  return key1 == key2;
+}
+
+
+static uint32_t next_random(uint32_t *seed)
+{
+  uint32_t x = *seed;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return *seed = x;
+}
+
+
+static double now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+
+static double run(int threads, void *table, void *(*worker)(void *), int *ok)
+{
+  pthread_t ids[MAX_THREADS];
+  Worker_t workers[MAX_THREADS];
+  double start;
+  int share;
+  int i;
+
+  // The operations are dealt out in equal shares (the last thread takes the
+  // remainder)
+  share = BENCH_OPS / threads;
+  for (i = 0; i < threads; i++) {
+    workers[i].table = table;
+    workers[i].count = i == threads - 1 ? BENCH_OPS - i * share : share;
+    workers[i].seed = 2463534242u + 977u * i;
+    workers[i].bad = 0;
+  }
+
+  start = now();
+
+  for (i = 0; i < threads; i++)
+    pthread_create(&ids[i], NULL, worker, &workers[i]);
+  for (i = 0; i < threads; i++)
+    pthread_join(ids[i], NULL);
+
+  start = now() - start;
+
+  *ok = 1;
+  for (i = 0; i < threads; i++)
+    if (workers[i].bad != 0)
+      *ok = 0;
+
+  return start;
+}
+
+
+static void *locked_worker(void *arg)
+{
+  Worker_t *worker = (Worker_t *)arg;
+  LockedTable_t *locked = (LockedTable_t *)worker->table;
+  uint32_t r;
+  uintptr_t key;
+  void *data;
+  int i;
+
+  for (i = 0; i < worker->count; i++) {
+    r = next_random(&worker->seed);
+    key = 1 + (r >> 8) % BENCH_KEYS;
+    data = (void *)key;
+
+    pthread_mutex_lock(&locked->lock);
+    if (r % 100 < BENCH_READS) {
+      if (hashtable_lookup(&locked->table, &data) == 0 && data != (void *)key)
+        worker->bad++;
+    }
+    else if (r % 100 < BENCH_READS + (100 - BENCH_READS) / 2)
+      hashtable_insert(&locked->table, data);
+    else
+      hashtable_remove(&locked->table, &data);
+    pthread_mutex_unlock(&locked->lock);
+  }
+  return NULL;
+}
+
+
+static void *shard_worker(void *arg)
+{
+  Worker_t *worker = (Worker_t *)arg;
+  ShardTable_t *sharded = (ShardTable_t *)worker->table;
+  uint32_t r;
+  uintptr_t key;
+  void *data;
+  int i;
+
+  for (i = 0; i < worker->count; i++) {
+    r = next_random(&worker->seed);
+    key = 1 + (r >> 8) % BENCH_KEYS;
+    data = (void *)key;
+
+    if (r % 100 < BENCH_READS) {
+      if (shardtable_lookup(sharded, &data) == 0 && data != (void *)key)
+        worker->bad++;
+    }
+    else if (r % 100 < BENCH_READS + (100 - BENCH_READS) / 2)
+      shardtable_insert(sharded, data);
+    else
+      shardtable_remove(sharded, &data);
+  }
+  return NULL;
+}
@@ -0,0 +1,204 @@
+/**
+@file skiplist_example.c
+@brief 
+Example usage of skip list ADT
+
+The second half inserts the same BENCH_SIZE random keys into a skip list and
+into a DList_t kept sorted by scanning for each insert position, then times
+both and checks they hold the same keys in the same order.
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "skiplist.h"
+#include "dlist.h"
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+#define BENCH_SIZE 20000
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static int compare_int(const void *key1, const void *key2);
+static void print_skiplist(const SkipList_t *list);
+static double now(void);
+static void benchmark(void);
+
+// =============================================================================
+// Main Program
+// =============================================================================
+
+int main(int argc, char *argv[])
+{
+  SkipList_t list;
+  SkipList_Element_t *element;
+  int keys[] = { 42, 7, 19, 88, 3, 61, 25, 7, 50, 14 };
+  int key;
+  int *data;
+  int i;
+
+  // Initialize the skip list; the keys live in the array so nothing is freed
+  if (skiplist_init(&list, compare_int, NULL) != 0)
+    return 1;
+
+  for (i = 0; i < (int)(sizeof (keys) / sizeof (keys[0])); i++) {
+    if (skiplist_insert(&list, &keys[i]) == 1)
+      fprintf(stdout, "Key %d is already in the list\n", keys[i]);
+  }
+
+  print_skiplist(&list);
+
+  // Look up a key
+  key = 61;
+  data = &key;
+  if (skiplist_lookup(&list, (void **)&data) == 0)
+    fprintf(stdout, "Found %d\n", *data);
+
+  key = 62;
+  data = &key;
+  if (skiplist_lookup(&list, (void **)&data) != 0)
+    fprintf(stdout, "Did not find %d\n", key);
+
+  // Scan a range of keys starting from a lower bound
+  fprintf(stdout, "Keys in [20, 60):");
+
+  key = 20;
+  for (element = skiplist_lower_bound(&list, &key); element != NULL; 
+       element = skiplist_next(element)) {
+    if (*(int *)skiplist_data(element) >= 60)
+      break;
+    fprintf(stdout, " %d", *(int *)skiplist_data(element));
+  }
+  fprintf(stdout, "\n");
+
+  // Remove a few keys
+  fprintf(stdout, "Removing 3, 42 and 88\n");
+
+  key = 3;
+  data = &key;
+  skiplist_remove(&list, (void **)&data);
+  key = 42;
+  data = &key;
+  skiplist_remove(&list, (void **)&data);
+  key = 88;
+  data = &key;
+  skiplist_remove(&list, (void **)&data);
+
+  print_skiplist(&list);
+
+  // Destroy the skip list
+  fprintf(stdout, "Destroying the list\n");
+  skiplist_destroy(&list);
+
+  benchmark();
+
+  return 0;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+static int compare_int(const void *key1, const void *key2)
+{
+  int a = *(const int *)key1;
+  int b = *(const int *)key2;
+
+  return (a > b) - (a < b);
+}
+
+
+static void print_skiplist(const SkipList_t *list)
+{
+  SkipList_Element_t *element;
+  int i;
+
+  fprintf(stdout, "List size is %d\n", skiplist_size(list));
+
+  i = 0;
+  for (element = skiplist_head(list); element != NULL; element = skiplist_next(element))
+    fprintf(stdout, "list[%03d]: key=%03d\n", i++, *(int *)skiplist_data(element));
+}
+
+
+static double now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+
+static void benchmark(void)
+{
+  SkipList_t skiplist;
+  DList_t dlist;
+  SkipList_Element_t *selement;
+  DList_Element_t *element;
+  int *keys;
+  double start;
+  double stime;
+  double time;
+  int same;
+  int i;
+
+  fprintf(stdout, "\nInserting %d random keys in order\n", BENCH_SIZE);
+
+  if ((keys = (int *)malloc(BENCH_SIZE * sizeof (int))) == NULL)
+    return;
+
+  srand(1);
+  for (i = 0; i < BENCH_SIZE; i++)
+    keys[i] = rand();
+
+  // Skip list
+  skiplist_init(&skiplist, compare_int, NULL);
+
+  start = now();
+  for (i = 0; i < BENCH_SIZE; i++)
+    skiplist_insert(&skiplist, &keys[i]);
+  stime = now() - start;
+
+  // Sorted DList_t, scanning from the tail for the insert position
+  dlist_init(&dlist, NULL);
+
+  start = now();
+  for (i = 0; i < BENCH_SIZE; i++) {
+    for (element = dlist_tail(&dlist); element != NULL; element = dlist_prev(element))
+      if (compare_int(dlist_data(element), &keys[i]) <= 0)
+        break;
+
+    if (element != NULL && compare_int(dlist_data(element), &keys[i]) == 0)
+      continue;
+
+    if (element != NULL)
+      dlist_insert_next(&dlist, element, &keys[i]);
+    else
+      dlist_insert_prev(&dlist, dlist_head(&dlist), &keys[i]);
+  }
+  time = now() - start;
+
+  // Both should hold the same keys in the same order
+  same = skiplist_size(&skiplist) == dlist_size(&dlist);
+  selement = skiplist_head(&skiplist);
+  for (element = dlist_head(&dlist); same && element != NULL; element = dlist_next(element)) {
+    same = compare_int(skiplist_data(selement), dlist_data(element)) == 0;
+    selement = skiplist_next(selement);
+  }
+
+  fprintf(stdout, "SkipList_t:      %8.2f ms (%d keys)\n", stime * 1e3, skiplist_size(&skiplist));
+  fprintf(stdout, "Sorted DList_t:  %8.2f ms (%d keys)\n", time * 1e3, dlist_size(&dlist));
+  fprintf(stdout, "Orders %s\n", same ? "match" : "DIFFER");
+
+  skiplist_destroy(&skiplist);
+  dlist_destroy(&dlist);
+  free(keys);
+}
@@ -0,0 +1,246 @@
+/**
+@file spscqueue_bench.c
+@brief 
+Benchmark of lock-free single-producer/single-consumer queue ADT
+
+A producer thread hands BENCH_SIZE elements to a consumer thread, first through
+a mutex protected Queue_t, then through SPSCQueue_t one element at a time, and
+finally through SPSCQueue_t in bursts. A side that finds the queue full (or empty) yields the CPU so
+the benchmark stays meaningful on machines with few cores.
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "queue.h"
+#include "spscqueue.h"
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+#define BENCH_SIZE 4000000
+#define RING_SIZE  1024
+#define BURST_SIZE 32
+
+typedef struct LockedQueue_T {
+  pthread_mutex_t lock;
+  Queue_t queue;
+} LockedQueue_t;
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static double now(void);
+static double run(void *(*producer)(void *), void *(*consumer)(void *), void *arg);
+
+static void *locked_producer(void *arg);
+static void *locked_consumer(void *arg);
+static void *spsc_producer(void *arg);
+static void *spsc_consumer(void *arg);
+static void *spsc_burst_producer(void *arg);
+static void *spsc_burst_consumer(void *arg);
+
+// Sum of everything the consumer received, checked against the expected total
+static uint64_t checksum;
+
+// =============================================================================
+// Main Program
+// =============================================================================
+
+int main(int argc, char *argv[])
+{
+  LockedQueue_t locked;
+  SPSCQueue_t spsc;
+  uint64_t expected;
+  double elapsed;
+
+  expected = (uint64_t)BENCH_SIZE * (BENCH_SIZE + 1) / 2;
+
+  fprintf(stdout, "Passing %d elements between two threads\n", BENCH_SIZE);
+
+  // Mutex protected linked-list queue
+  pthread_mutex_init(&locked.lock, NULL);
+  queue_init(&locked.queue, NULL);
+
+  elapsed = run(locked_producer, locked_consumer, &locked);
+  fprintf(stdout, "Queue_t + mutex:     %s time=%.3fs (%.1f Mops/s)\n", 
+    checksum == expected ? "OK" : "BAD", elapsed, BENCH_SIZE / elapsed / 1e6);
+
+  queue_destroy(&locked.queue);
+  pthread_mutex_destroy(&locked.lock);
+
+  // Lock-free ring, one element at a time
+  spscqueue_init(&spsc, RING_SIZE, NULL);
+
+  elapsed = run(spsc_producer, spsc_consumer, &spsc);
+  fprintf(stdout, "SPSCQueue_t:         %s time=%.3fs (%.1f Mops/s)\n", 
+    checksum == expected ? "OK" : "BAD", elapsed, BENCH_SIZE / elapsed / 1e6);
+
+  spscqueue_destroy(&spsc);
+
+  // Lock-free ring, in bursts
+  spscqueue_init(&spsc, RING_SIZE, NULL);
+
+  elapsed = run(spsc_burst_producer, spsc_burst_consumer, &spsc);
+  fprintf(stdout, "SPSCQueue_t (burst): %s time=%.3fs (%.1f Mops/s)\n", 
+    checksum == expected ? "OK" : "BAD", elapsed, BENCH_SIZE / elapsed / 1e6);
+
+  spscqueue_destroy(&spsc);
+
+  return 0;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+static double now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+
+static double run(void *(*producer)(void *), void *(*consumer)(void *), void *arg)
+{
+  pthread_t threads[2];
+  double start;
+
+  checksum = 0;
+  start = now();
+
+  pthread_create(&threads[0], NULL, producer, arg);
+  pthread_create(&threads[1], NULL, consumer, arg);
+  pthread_join(threads[0], NULL);
+  pthread_join(threads[1], NULL);
+
+  return now() - start;
+}
+
+// The elements are the integers 1..BENCH_SIZE smuggled through the pointer
+
+static void *locked_producer(void *arg)
+{
+  LockedQueue_t *locked = (LockedQueue_t *)arg;
+  uintptr_t i;
+
+  for (i = 1; i <= BENCH_SIZE; i++) {
+    pthread_mutex_lock(&locked->lock);
+    queue_enqueue(&locked->queue, (void *)i);
+    pthread_mutex_unlock(&locked->lock);
+  }
+  return NULL;
+}
+
+
+static void *locked_consumer(void *arg)
+{
+  LockedQueue_t *locked = (LockedQueue_t *)arg;
+  void *data;
+  uint64_t sum = 0;
+  int count = 0;
+  int retval;
+
+  while (count < BENCH_SIZE) {
+    pthread_mutex_lock(&locked->lock);
+    retval = queue_dequeue(&locked->queue, &data);
+    pthread_mutex_unlock(&locked->lock);
+
+    if (retval == 0) {
+      sum += (uintptr_t)data;
+      count++;
+    }
+    else
+      sched_yield();
+  }
+  checksum = sum;
+  return NULL;
+}
+
+
+static void *spsc_producer(void *arg)
+{
+  SPSCQueue_t *queue = (SPSCQueue_t *)arg;
+  uintptr_t i;
+
+  for (i = 1; i <= BENCH_SIZE; i++) {
+    while (spscqueue_enqueue(queue, (void *)i) != 0)
+      sched_yield();
+  }
+  return NULL;
+}
+
+
+static void *spsc_consumer(void *arg)
+{
+  SPSCQueue_t *queue = (SPSCQueue_t *)arg;
+  void *data;
+  uint64_t sum = 0;
+  int count = 0;
+
+  while (count < BENCH_SIZE) {
+    if (spscqueue_dequeue(queue, &data) == 0) {
+      sum += (uintptr_t)data;
+      count++;
+    }
+    else
+      sched_yield();
+  }
+  checksum = sum;
+  return NULL;
+}
+
+
+static void *spsc_burst_producer(void *arg)
+{
+  SPSCQueue_t *queue = (SPSCQueue_t *)arg;
+  void *burst[BURST_SIZE];
+  uintptr_t next = 1;
+  int n;
+  int i;
+  int sent;
+
+  while (next <= BENCH_SIZE) {
+    n = BENCH_SIZE - next + 1 < BURST_SIZE ? BENCH_SIZE - next + 1 : BURST_SIZE;
+    for (i = 0; i < n; i++)
+      burst[i] = (void *)(next + i);
+
+    for (sent = spscqueue_enqueue_n(queue, burst, n); sent < n; ) {
+      sched_yield();
+      sent += spscqueue_enqueue_n(queue, burst + sent, n - sent);
+    }
+
+    next += n;
+  }
+  return NULL;
+}
+
+
+static void *spsc_burst_consumer(void *arg)
+{
+  SPSCQueue_t *queue = (SPSCQueue_t *)arg;
+  void *burst[BURST_SIZE];
+  uint64_t sum = 0;
+  int count = 0;
+  int n;
+  int i;
+
+  while (count < BENCH_SIZE) {
+    if ((n = spscqueue_dequeue_n(queue, burst, BURST_SIZE)) == 0)
+      sched_yield();
+    for (i = 0; i < n; i++)
+      sum += (uintptr_t)burst[i];
+    count += n;
+  }
+  checksum = sum;
+  return NULL;
+}
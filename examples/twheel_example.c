@@ -0,0 +1,194 @@
+/**
+@file twheel_example.c
+@brief 
+Example usage of hierarchical timer wheel ADT
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "dlist.h"
+#include "twheel.h"
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+#define BENCH_TIMERS 200000
+#define BENCH_TICKS  20000
+
+typedef struct Connection_T {
+  int id;
+  uint64_t deadline;
+  TWheel_Timer_t timer;
+  DList_Element_t *element; ///< Entry in the deadline list (list benchmark)
+} Connection_t;
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static void print_fired(TWheel_Timer_t *timer);
+static void count_fired(TWheel_Timer_t *timer);
+static void benchmark(void);
+
+static TWheel_t *bench_wheel;
+static int on_time;
+static int late;
+
+// =============================================================================
+// Main Program
+// =============================================================================
+
+int main(int argc, char *argv[])
+{
+  static const uint64_t delays[] = { 5, 1, 64, 3, 100, 4096, 2, 70, 5000, 7 };
+  TWheel_Timer_t timers[10];
+  TWheel_t wheel;
+  int fired;
+  int i;
+
+  // Initialize the wheel at tick 0
+  if (twheel_init(&wheel, 0) != 0)
+    return 1;
+
+  fprintf(stdout, "Scheduling 10 timers\n");
+
+  for (i = 0; i < 10; i++) {
+    twheel_timer_init(&timers[i], print_fired, &wheel);
+    if (twheel_schedule(&wheel, &timers[i], delays[i]) != 0)
+      return 1;
+  }
+
+  fprintf(stdout, "Pending timers: %d\n", twheel_size(&wheel));
+
+  fprintf(stdout, "Cancelling the timers due at 3 and 4096\n");
+  twheel_cancel(&wheel, &timers[3]);
+  twheel_cancel(&wheel, &timers[5]);
+
+  fprintf(stdout, "Moving the timer due at 7 to 80\n");
+  twheel_schedule(&wheel, &timers[9], 80);
+
+  fprintf(stdout, "Pending timers: %d\n", twheel_size(&wheel));
+
+  fprintf(stdout, "Advancing 6000 ticks\n");
+  fired = twheel_advance(&wheel, 6000);
+  fprintf(stdout, "Fired %d timers, now at tick %llu\n", fired, 
+    (unsigned long long)twheel_now(&wheel));
+
+  // Destroy the wheel
+  fprintf(stdout, "Destroying the wheel\n");
+  twheel_destroy(&wheel);
+
+  // Compare against scanning a list of deadlines on every tick
+  benchmark();
+
+  return 0;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+static void print_fired(TWheel_Timer_t *timer)
+{
+  TWheel_t *wheel = (TWheel_t *)timer->data;
+
+  fprintf(stdout, "tick %04llu: timer due at %04llu fired\n", 
+    (unsigned long long)twheel_now(wheel), (unsigned long long)timer->expires);
+}
+
+
+static void count_fired(TWheel_Timer_t *timer)
+{
+  Connection_t *connection = (Connection_t *)timer->data;
+
+  if (twheel_now(bench_wheel) == connection->deadline)
+    on_time++;
+  else
+    late++;
+}
+
+
+static void benchmark(void)
+{
+  Connection_t *connections;
+  DList_t deadlines;
+  DList_Element_t *element;
+  DList_Element_t *next;
+  TWheel_t wheel;
+  Connection_t *connection;
+  clock_t start;
+  uint64_t now;
+  void *data;
+  int expired;
+  int i;
+
+  // Every connection gets a timeout and nine in ten are cancelled half way
+  fprintf(stdout, "Benchmarking %d connection timeouts over %d ticks\n", 
+    BENCH_TIMERS, BENCH_TICKS);
+
+  if ((connections = (Connection_t *)malloc(BENCH_TIMERS * sizeof (Connection_t))) == NULL)
+    return;
+
+  srand(1);
+  for (i = 0; i < BENCH_TIMERS; i++) {
+    connections[i].id = i;
+    connections[i].deadline = 1 + rand() % BENCH_TICKS;
+  }
+
+  // Deadline list scanned on every tick
+  start = clock();
+  dlist_init(&deadlines, NULL);
+
+  for (i = 0; i < BENCH_TIMERS; i++) {
+    dlist_insert_next(&deadlines, dlist_tail(&deadlines), &connections[i]);
+    connections[i].element = dlist_tail(&deadlines);
+  }
+
+  for (i = 0; i < BENCH_TIMERS; i++) {
+    if (i % 10 != 0)
+      dlist_remove(&deadlines, connections[i].element, &data);
+  }
+
+  for (expired = 0, now = 1; now <= BENCH_TICKS; now++) {
+    for (element = dlist_head(&deadlines); element != NULL; element = next) {
+      next = dlist_next(element);
+      if (((Connection_t *)dlist_data(element))->deadline == now) {
+        dlist_remove(&deadlines, element, &data);
+        expired++;
+      }
+    }
+  }
+
+  dlist_destroy(&deadlines);
+  fprintf(stdout, "DList_t scan: expired=%d time=%.3fs\n", expired, 
+    (double)(clock() - start) / CLOCKS_PER_SEC);
+
+  // Timer wheel
+  start = clock();
+  twheel_init(&wheel, 0);
+  bench_wheel = &wheel;
+  on_time = late = 0;
+
+  for (i = 0; i < BENCH_TIMERS; i++) {
+    connection = &connections[i];
+    twheel_timer_init(&connection->timer, count_fired, connection);
+    twheel_schedule(&wheel, &connection->timer, connection->deadline);
+  }
+
+  for (i = 0; i < BENCH_TIMERS; i++) {
+    if (i % 10 != 0)
+      twheel_cancel(&wheel, &connections[i].timer);
+  }
+
+  expired = twheel_advance(&wheel, BENCH_TICKS);
+
+  twheel_destroy(&wheel);
+  fprintf(stdout, "TWheel_t:     expired=%d time=%.3fs (on time=%d late=%d)\n", 
+    expired, (double)(clock() - start) / CLOCKS_PER_SEC, on_time, late);
+
+  free(connections);
+}
@@ -0,0 +1,211 @@
+/**
+@file ulist_example.c
+@brief 
+Example usage of unrolled linked-list ADT
+
+The second half builds a list of BENCH_SIZE elements as a UList_t and as a
+List_t, then times summing the elements by scanning each list. The list
+elements are made in a shuffled allocation order, as they would be in a
+long-running program, so the List_t scan cannot ride on neighbouring
+allocations.
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "list.h"
+#include "ulist.h"
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+#define BENCH_SIZE   1000000
+#define BENCH_PASSES 10
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static void print_ulist(const UList_t *list);
+static double now(void);
+static void benchmark(void);
+
+// =============================================================================
+// Main Program
+// =============================================================================
+
+int main(int argc, char *argv[])
+{
+  UList_t list;
+  UList_Position_t position;
+  void *data;
+  intptr_t i;
+
+  // Initialize the unrolled linked-list
+  ulist_init(&list, NULL);
+
+  // Append 1..20, carrying the position of the last element along
+  ulist_insert_next(&list, NULL, (void *)1);
+  ulist_first(&list, &position);
+
+  for (i = 2; i <= 20; i++) {
+    if (ulist_insert_next(&list, &position, (void *)i) != 0)
+      return 1;
+  }
+
+  print_ulist(&list);
+
+  // Insert into the middle of a full node, which splits it
+  ulist_first(&list, &position);
+  ulist_next(&position);
+
+  fprintf(stdout, "Inserting 100 after %d\n", (int)(intptr_t)ulist_data(&position));
+  if (ulist_insert_next(&list, &position, (void *)100) != 0)
+    return 1;
+
+  print_ulist(&list);
+
+  // Remove elements after the head until nodes have to be merged
+  ulist_first(&list, &position);
+
+  fprintf(stdout, "Removing 8 elements after %d\n", (int)(intptr_t)ulist_data(&position));
+  for (i = 0; i < 8; i++) {
+    if (ulist_remove_next(&list, &position, &data) != 0)
+      return 1;
+  }
+
+  print_ulist(&list);
+
+  // Destroy the list
+  fprintf(stdout, "Destroying the list\n");
+  ulist_destroy(&list);
+
+  benchmark();
+
+  return 0;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+static void print_ulist(const UList_t *list)
+{
+  UList_Node_t *node;
+  int i;
+
+  fprintf(stdout, "List size is %d\n", ulist_size(list));
+
+  for (node = ulist_head(list); node != NULL; node = ulist_node_next(node)) {
+    fprintf(stdout, "  [");
+    for (i = 0; i < ulist_node_count(node); i++)
+      fprintf(stdout, " %3d", (int)(intptr_t)ulist_node_data(node, i));
+    fprintf(stdout, " ]\n");
+  }
+}
+
+
+static double now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+
+static void benchmark(void)
+{
+  UList_t ulist;
+  UList_Position_t position;
+  UList_Node_t *node;
+  List_t list;
+  List_Element_t *element;
+  List_Element_t **shuffle;
+  List_Element_t *swap;
+  uint64_t usum;
+  uint64_t psum;
+  uint64_t sum;
+  double utime;
+  double ptime;
+  double time;
+  double start;
+  int pass;
+  int i;
+  int j;
+
+  fprintf(stdout, "\nSumming %d elements %d times\n", BENCH_SIZE, BENCH_PASSES);
+
+  ulist_init(&ulist, NULL);
+  ulist_insert_next(&ulist, NULL, (void *)(uintptr_t)0);
+  ulist_first(&ulist, &position);
+  for (i = 1; i < BENCH_SIZE; i++)
+    ulist_insert_next(&ulist, &position, (void *)(uintptr_t)i);
+
+  // Build the List_t, then relink its elements in a shuffled memory order
+  list_init(&list, NULL);
+  for (i = BENCH_SIZE - 1; i >= 0; i--)
+    list_insert_next(&list, NULL, (void *)(uintptr_t)i);
+
+  if ((shuffle = (List_Element_t **)malloc(BENCH_SIZE * sizeof (List_Element_t *))) == NULL)
+    return;
+
+  for (i = 0, element = list_head(&list); i < BENCH_SIZE; i++, element = list_next(element))
+    shuffle[i] = element;
+
+  srand(1);
+  for (i = BENCH_SIZE - 1; i > 0; i--) {
+    j = rand() % (i + 1);
+    swap = shuffle[i];
+    shuffle[i] = shuffle[j];
+    shuffle[j] = swap;
+  }
+
+  for (i = 0; i < BENCH_SIZE - 1; i++)
+    shuffle[i]->next = shuffle[i + 1];
+  shuffle[BENCH_SIZE - 1]->next = NULL;
+  list.head = shuffle[0];
+  list.tail = shuffle[BENCH_SIZE - 1];
+  free(shuffle);
+
+  // Scan node by node
+  start = now();
+  usum = 0;
+  for (pass = 0; pass < BENCH_PASSES; pass++)
+    for (node = ulist_head(&ulist); node != NULL; node = ulist_node_next(node))
+      for (i = 0; i < ulist_node_count(node); i++)
+        usum += (uintptr_t)ulist_node_data(node, i);
+  utime = now() - start;
+
+  // Scan element by element through a position
+  start = now();
+  psum = 0;
+  for (pass = 0; pass < BENCH_PASSES; pass++) {
+    ulist_first(&ulist, &position);
+    do {
+      psum += (uintptr_t)ulist_data(&position);
+    } while (ulist_next(&position) == 0);
+  }
+  ptime = now() - start;
+
+  start = now();
+  sum = 0;
+  for (pass = 0; pass < BENCH_PASSES; pass++)
+    for (element = list_head(&list); element != NULL; element = list_next(element))
+      sum += (uintptr_t)list_data(element);
+  time = now() - start;
+
+  fprintf(stdout, "UList_t (nodes):     %6.2f ns/element (sum %llu)\n", 
+    utime * 1e9 / ((double)BENCH_SIZE * BENCH_PASSES), (unsigned long long)usum);
+  fprintf(stdout, "UList_t (positions): %6.2f ns/element (sum %llu)\n", 
+    ptime * 1e9 / ((double)BENCH_SIZE * BENCH_PASSES), (unsigned long long)psum);
+  fprintf(stdout, "List_t:              %6.2f ns/element (sum %llu)\n", 
+    time * 1e9 / ((double)BENCH_SIZE * BENCH_PASSES), (unsigned long long)sum);
+
+  ulist_destroy(&ulist);
+  list_destroy(&list);
+}
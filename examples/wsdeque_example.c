@@ -0,0 +1,313 @@
+/**
+@file wsdeque_example.c
+@brief 
+Example usage of work-stealing deque ADT
+
+The second half of the example runs a small work-stealing thread pool. A task
+sums a function over a range of integers; while a range is larger than
+TASK_GRAIN a task splits it, spawns the upper half as a new task and carries on
+with the lower half. Each worker owns a deque it pushes to and pops from, and
+steals from the others when it runs dry. The same tasks are then run with all
+workers sharing one mutex protected Queue_t.
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "queue.h"
+#include "wsdeque.h"
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+#define POOL_THREADS 4
+#define TASK_RANGE   (1 << 24)
+#define TASK_GRAIN   64
+
+typedef struct Task_T {
+  int lo; ///< First integer of the range
+  int hi; ///< One past the last integer of the range
+} Task_t;
+
+typedef struct Scheduler_T Scheduler_t;
+
+typedef struct Worker_T {
+  Scheduler_t *scheduler;
+  int id;
+  WSDeque_t deque;  ///< Tasks spawned by this worker (work-stealing only)
+  uint64_t sum;     ///< Partial result
+  int steals;       ///< Tasks this worker took from others
+} Worker_t;
+
+struct Scheduler_T {
+  atomic_int pending; ///< Tasks spawned but not yet finished
+
+  pthread_mutex_t lock; ///< Protects _queue_ (shared queue only)
+  Queue_t queue;
+
+  Worker_t workers[POOL_THREADS];
+};
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static double now(void);
+static uint64_t leaf(int lo, int hi);
+static Task_t *task_new(int lo, int hi);
+
+static void *stealing_worker(void *arg);
+static void *shared_worker(void *arg);
+static double run_pool(Scheduler_t *scheduler, void *(*worker)(void *), uint64_t *sum);
+
+// =============================================================================
+// Main Program
+// =============================================================================
+
+int main(int argc, char *argv[])
+{
+  Scheduler_t scheduler;
+  WSDeque_t deque;
+  uint64_t expected;
+  uint64_t sum;
+  double elapsed;
+  int *data;
+  int steals;
+  int i;
+
+  // Initialize the deque with a small array so it has to grow
+  wsdeque_init(&deque, 4, free);
+
+  fprintf(stdout, "Pushing 10 elements onto the bottom\n");
+
+  for (i = 0; i < 10; i++) {
+    if ((data = (int *)malloc(sizeof(int))) == NULL)
+      return 1;
+
+    *data = i + 1;
+
+    if (wsdeque_push_bottom(&deque, data) != 0)
+      return 1;
+  }
+
+  fprintf(stdout, "Deque size is %d\n", wsdeque_size(&deque));
+
+  fprintf(stdout, "Popping 3 elements off the bottom\n");
+
+  for (i = 0; i < 3; i++) {
+    if (wsdeque_pop_bottom(&deque, (void **)&data) != 0)
+      return 1;
+
+    fprintf(stdout, "popped=%03d\n", *data);
+    free(data);
+  }
+
+  fprintf(stdout, "Stealing 3 elements off the top\n");
+
+  for (i = 0; i < 3; i++) {
+    if (wsdeque_steal(&deque, (void **)&data) != 0)
+      return 1;
+
+    fprintf(stdout, "stolen=%03d\n", *data);
+    free(data);
+  }
+
+  fprintf(stdout, "Deque size is %d\n", wsdeque_size(&deque));
+
+  // Destroy the deque (frees the 4 elements left)
+  fprintf(stdout, "Destroying the deque\n");
+  wsdeque_destroy(&deque);
+
+  // Run the same task tree on both schedulers
+  fprintf(stdout, "Summing over %d integers in tasks of %d with %d threads\n", 
+    TASK_RANGE, TASK_GRAIN, POOL_THREADS);
+
+  expected = leaf(0, TASK_RANGE);
+
+  elapsed = run_pool(&scheduler, shared_worker, &sum);
+  fprintf(stdout, "Shared Queue_t + mutex: %s time=%.3fs\n", 
+    sum == expected ? "OK" : "BAD", elapsed);
+
+  elapsed = run_pool(&scheduler, stealing_worker, &sum);
+
+  for (steals = 0, i = 0; i < POOL_THREADS; i++)
+    steals += scheduler.workers[i].steals;
+
+  fprintf(stdout, "Work-stealing deques:   %s time=%.3fs (steals=%d)\n", 
+    sum == expected ? "OK" : "BAD", elapsed, steals);
+
+  return 0;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+static double now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+
+static uint64_t leaf(int lo, int hi)
+{
+  uint64_t sum = 0;
+  uint64_t x;
+  int i;
+
+  for (i = lo; i < hi; i++) {
+    x = (uint64_t)i * 0x9e3779b97f4a7c15ULL;
+    sum += x ^ (x >> 29);
+  }
+  return sum;
+}
+
+
+static Task_t *task_new(int lo, int hi)
+{
+  Task_t *task;
+
+  if ((task = (Task_t *)malloc(sizeof (Task_t))) == NULL)
+    abort();
+
+  task->lo = lo;
+  task->hi = hi;
+
+  return task;
+}
+
+
+static double run_pool(Scheduler_t *scheduler, void *(*worker)(void *), uint64_t *sum)
+{
+  pthread_t ids[POOL_THREADS];
+  double start;
+  int i;
+
+  atomic_init(&scheduler->pending, 1);
+  pthread_mutex_init(&scheduler->lock, NULL);
+  queue_init(&scheduler->queue, free);
+
+  for (i = 0; i < POOL_THREADS; i++) {
+    scheduler->workers[i].scheduler = scheduler;
+    scheduler->workers[i].id = i;
+    scheduler->workers[i].sum = 0;
+    scheduler->workers[i].steals = 0;
+    wsdeque_init(&scheduler->workers[i].deque, 8, free);
+  }
+
+  // The root task goes wherever worker 0 looks first
+  if (worker == stealing_worker)
+    wsdeque_push_bottom(&scheduler->workers[0].deque, task_new(0, TASK_RANGE));
+  else
+    queue_enqueue(&scheduler->queue, task_new(0, TASK_RANGE));
+
+  start = now();
+
+  for (i = 0; i < POOL_THREADS; i++)
+    pthread_create(&ids[i], NULL, worker, &scheduler->workers[i]);
+  for (i = 0; i < POOL_THREADS; i++)
+    pthread_join(ids[i], NULL);
+
+  start = now() - start;
+
+  for (*sum = 0, i = 0; i < POOL_THREADS; i++) {
+    *sum += scheduler->workers[i].sum;
+    wsdeque_destroy(&scheduler->workers[i].deque);
+  }
+
+  queue_destroy(&scheduler->queue);
+  pthread_mutex_destroy(&scheduler->lock);
+
+  return start;
+}
+
+
+static void *stealing_worker(void *arg)
+{
+  Worker_t *self = (Worker_t *)arg;
+  Scheduler_t *scheduler = self->scheduler;
+  Task_t *task;
+  int victim;
+  int mid;
+  int i;
+
+  while (atomic_load(&scheduler->pending) > 0) {
+    // Newest local work first, then the oldest work of the others
+    if (wsdeque_pop_bottom(&self->deque, (void **)&task) != 0) {
+      for (task = NULL, i = 1; i < POOL_THREADS && task == NULL; i++) {
+        victim = (self->id + i) % POOL_THREADS;
+        while (wsdeque_steal(&scheduler->workers[victim].deque, (void **)&task) > 0)
+          ;
+      }
+
+      if (task == NULL) {
+        sched_yield();
+        continue;
+      }
+      self->steals++;
+    }
+
+    // Split off the upper half until the range is small enough
+    while (task->hi - task->lo > TASK_GRAIN) {
+      mid = task->lo + (task->hi - task->lo) / 2;
+      atomic_fetch_add(&scheduler->pending, 1);
+      wsdeque_push_bottom(&self->deque, task_new(mid, task->hi));
+      task->hi = mid;
+    }
+
+    self->sum += leaf(task->lo, task->hi);
+    free(task);
+
+    atomic_fetch_sub(&scheduler->pending, 1);
+  }
+  return NULL;
+}
+
+
+static void *shared_worker(void *arg)
+{
+  Worker_t *self = (Worker_t *)arg;
+  Scheduler_t *scheduler = self->scheduler;
+  Task_t *task;
+  int retval;
+  int mid;
+
+  while (atomic_load(&scheduler->pending) > 0) {
+    pthread_mutex_lock(&scheduler->lock);
+    retval = queue_dequeue(&scheduler->queue, (void **)&task);
+    pthread_mutex_unlock(&scheduler->lock);
+
+    if (retval != 0) {
+      sched_yield();
+      continue;
+    }
+
+    // Split off the upper half until the range is small enough
+    while (task->hi - task->lo > TASK_GRAIN) {
+      mid = task->lo + (task->hi - task->lo) / 2;
+      atomic_fetch_add(&scheduler->pending, 1);
+
+      pthread_mutex_lock(&scheduler->lock);
+      queue_enqueue(&scheduler->queue, task_new(mid, task->hi));
+      pthread_mutex_unlock(&scheduler->lock);
+
+      task->hi = mid;
+    }
+
+    self->sum += leaf(task->lo, task->hi);
+    free(task);
+
+    atomic_fetch_sub(&scheduler->pending, 1);
+  }
+  return NULL;
+}
@@ -0,0 +1,80 @@
+/** 
+@file alloc.h
+@brief 
+Definitions of a pluggable memory allocator interface
+
+The containers allocate their internal elements through an *Allocator_t*. A
+container initialized without an allocator (NULL) uses _malloc_ and _free_.
+
+An allocator without a _free_ function releases all of its memory at once
+(e.g. an arena). Containers using such an allocator skip releasing elements
+one at a time, so destroying them is O(1) when they have no _destroy_ function.
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#ifndef ALLOC_h
+#define ALLOC_h
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdlib.h>
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+/**
+@struct Allocator_t
+Generic memory allocator
+*/
+typedef struct Allocator_T {
+  void *(*alloc)(void *context, size_t size); ///< Allocate _size_ bytes (NULL on failure)
+  void (*free)(void *context, void *ptr);     ///< Release memory from _alloc_ (NULL if bulk)
+
+  void *context; ///< Passed to each call (e.g. the pool memory comes from)
+
+} Allocator_t;
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/**
+Function to allocate memory from an allocator (or _malloc_ if it is NULL)
+
+@param [in] *allocator  The allocator to use
+@param [in]  size       The number of bytes to allocate
+
+@return pointer to the memory allocated, otherwise NULL
+*/
+static inline void *allocator_alloc(const Allocator_t *allocator, size_t size)
+{
+  return allocator == NULL ? malloc(size) : allocator->alloc(allocator->context, size);
+}
+
+/**
+Function to release memory to an allocator (or _free_ if it is NULL)
+
+@param [in] *allocator  The allocator the memory came from
+@param [in] *ptr        The memory to release
+*/
+static inline void allocator_free(const Allocator_t *allocator, void *ptr)
+{
+  if (allocator == NULL)
+    free(ptr);
+  else if (allocator->free != NULL)
+    allocator->free(allocator->context, ptr);
+}
+
+/**
+MACRO that determines whether an allocator releases its memory all at once
+*/
+#define allocator_is_bulk(allocator) ((allocator) != NULL && (allocator)->free == NULL ? 1 : 0)
+
+#ifdef __cplusplus
+}
+#endif
+#endif // ALLOC_h
@@ -0,0 +1,134 @@
+/**
+@file arena.c
+
+See header
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena.h"
+
+// -----------------------------------------------------------------------------
+// Local Definitions
+// -----------------------------------------------------------------------------
+
+/**
+Alignment of each allocation (enough for pointers, doubles and 64-bit integers)
+*/
+#define ARENA_ALIGN 16
+
+/**
+MACRO that rounds _n_ up to a multiple of the alignment
+*/
+#define arena_round(n) ((((n) + ARENA_ALIGN - 1) / ARENA_ALIGN) * ARENA_ALIGN)
+
+/**
+Size of the chunk header, rounded up so the first allocation is aligned
+*/
+#define ARENA_HEADER_SIZE arena_round(sizeof (Arena_Chunk_t))
+
+// -----------------------------------------------------------------------------
+// Local Function Prototypes
+// -----------------------------------------------------------------------------
+
+static void *arena_allocator_alloc(void *context, size_t size);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+int arena_init(Arena_t *arena, size_t chunk_size)
+{
+  if (chunk_size == 0)
+    return -1;
+
+  arena->chunk_size = arena_round(chunk_size);
+
+  arena->next = NULL;
+  arena->end = NULL;
+  arena->chunks = NULL;
+
+  // Memory is only ever released in bulk
+  arena->allocator.alloc = arena_allocator_alloc;
+  arena->allocator.free = NULL;
+  arena->allocator.context = arena;
+
+  return 0;
+}
+
+
+void arena_destroy(Arena_t *arena)
+{
+  Arena_Chunk_t *chunk;
+
+  // Free each chunk
+  while ((chunk = arena->chunks) != NULL) {
+    arena->chunks = chunk->next;
+    free(chunk);
+  }
+
+  // No operations permitted at this point -- clear memory as precaution
+  memset(arena, 0, sizeof (Arena_t));
+}
+
+
+void arena_reset(Arena_t *arena)
+{
+  Arena_Chunk_t *chunk;
+
+  if (arena->chunks == NULL)
+    return;
+
+  // Free every chunk but the newest
+  while ((chunk = arena->chunks->next) != NULL) {
+    arena->chunks->next = chunk->next;
+    free(chunk);
+  }
+
+  // Start over at the beginning of the newest chunk
+  arena->next = (char *)arena->chunks + ARENA_HEADER_SIZE;
+  arena->end = arena->next + arena->chunks->size;
+}
+
+
+void *arena_alloc(Arena_t *arena, size_t size)
+{
+  Arena_Chunk_t *chunk;
+  size_t chunk_size;
+  void *ptr;
+
+  size = arena_round(size == 0 ? 1 : size);
+
+  // Add a chunk if the request does not fit in the current one
+  if (arena->next == NULL || (size_t)(arena->end - arena->next) < size) {
+    chunk_size = size > arena->chunk_size ? size : arena->chunk_size;
+
+    if ((chunk = (Arena_Chunk_t *)malloc(ARENA_HEADER_SIZE + chunk_size)) == NULL)
+      return NULL;
+
+    chunk->size = chunk_size;
+    chunk->next = arena->chunks;
+    arena->chunks = chunk;
+
+    arena->next = (char *)chunk + ARENA_HEADER_SIZE;
+    arena->end = arena->next + chunk_size;
+  }
+
+  // Bump the pointer
+  ptr = arena->next;
+  arena->next += size;
+
+  return ptr;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+static void *arena_allocator_alloc(void *context, size_t size)
+{
+  return arena_alloc((Arena_t *)context, size);
+}
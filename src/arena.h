@@ -0,0 +1,130 @@
+/** 
+@file arena.h
+@brief 
+Definitions of an arena (region) allocator
+
+An arena hands out memory by bumping a pointer through large chunks and never
+releases individual allocations. Everything allocated from the arena is
+released at once by *arena_reset()* or *arena_destroy()*.
+
+Containers whose elements come from *arena_allocator()* and whose _destroy_
+function is NULL are destroyed in O(1), regardless of the number of elements.
+If the user data is allocated from the same arena as well, a whole scratch
+structure is torn down with a single call.
+
+The arena is not thread safe; each arena should be used by one thread at a time.
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#ifndef ARENA_h
+#define ARENA_h
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdlib.h>
+
+#include "alloc.h"
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+/**
+@struct Arena_Chunk_t
+Header of a contiguous chunk of arena memory
+*/
+typedef struct Arena_Chunk_T {
+  struct Arena_Chunk_T *next; ///< Pointer to the previously allocated chunk
+  size_t size;                ///< Usable size of the chunk in bytes
+
+} Arena_Chunk_t;
+
+/**
+@struct Arena_t
+Arena allocator
+*/
+typedef struct Arena_T {
+  size_t chunk_size; ///< Default usable size of each chunk
+
+  char *next;            ///< Next free byte in the newest chunk
+  char *end;             ///< End of the newest chunk
+  Arena_Chunk_t *chunks; ///< All chunks allocated so far (newest first)
+
+  Allocator_t allocator; ///< Allocator interface handing out arena memory
+
+} Arena_t;
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/**
+Function to initialize an arena
+
+@pre
+Must be called before arena can be used by any other operation
+
+Memory is obtained in chunks of _chunk_size_ bytes. Requests larger than a
+chunk get a chunk of their own. No memory is allocated until the first request.
+
+Complexity: O(1)
+
+@param [out] *arena       The arena to init
+@param [in]   chunk_size  The size of each chunk in bytes
+
+@return 0 if arena init successful, otherwise -1
+*/
+int arena_init(Arena_t *arena, size_t chunk_size);
+
+/**
+Function to destroy an arena
+
+Releases every chunk of the arena. All memory handed out by the arena becomes
+invalid, so any container using the arena must not be used afterwards.
+
+Complexity: O(c), where *c* is the number of chunks allocated
+
+@param [in,out] *arena  The arena to destroy
+*/
+void arena_destroy(Arena_t *arena);
+
+/**
+Function to release everything allocated from an arena but keep it usable
+
+The newest chunk is kept for reuse, so an arena reset after every request
+settles into not calling _malloc_ at all.
+
+Complexity: O(c), where *c* is the number of chunks allocated
+
+@param [in,out] *arena  The arena to reset
+*/
+void arena_reset(Arena_t *arena);
+
+/**
+Function to allocate memory from an arena
+
+The memory is aligned for any fundamental type.
+
+Complexity: O(1) amortized
+
+@param [in,out] *arena  The arena to allocate from
+@param [in]      size   The number of bytes to allocate
+
+@return pointer to the memory allocated, otherwise NULL
+*/
+void *arena_alloc(Arena_t *arena, size_t size);
+
+/**
+MACRO that evaluates to an *Allocator_t* handing out memory from the arena
+
+The allocator has no _free_ function, memory is released with the arena.
+*/
+#define arena_allocator(arena) ((const Allocator_t *)&(arena)->allocator)
+
+#ifdef __cplusplus
+}
+#endif
+#endif // ARENA_h
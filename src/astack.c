@@ -0,0 +1,70 @@
+/**
+@file astack.c
+
+See header
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "astack.h"
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void astack_init(AStack_t *stack, void (*destroy)(void *data))
+{
+  // Initialize the stack, starting out in the inline buffer
+  stack->size = 0;
+  stack->capacity = ASTACK_INLINE_SIZE;
+  stack->destroy = destroy;
+  stack->items = stack->inline_items;
+}
+
+
+void astack_destroy(AStack_t *stack)
+{
+  int i;
+
+  // Destroy each element, top of the stack first
+  if (stack->destroy != NULL) {
+    for (i = stack->size - 1; i >= 0; i--)
+      stack->destroy(stack->items[i]);
+  }
+
+  // Free the array if the stack outgrew the inline buffer
+  if (stack->items != stack->inline_items)
+    free(stack->items);
+
+  // No operations permitted at this point -- clear memory as precaution
+  memset(stack, 0, sizeof (AStack_t));
+}
+
+
+int astack_grow(AStack_t *stack)
+{
+  void **items;
+  int capacity;
+
+  capacity = stack->capacity * 2;
+
+  if (stack->items == stack->inline_items) {
+    // Move off the inline buffer onto the heap
+    if ((items = (void **)malloc(capacity * sizeof (void *))) == NULL)
+      return -1;
+
+    memcpy(items, stack->inline_items, stack->size * sizeof (void *));
+  }
+  else {
+    if ((items = (void **)realloc(stack->items, capacity * sizeof (void *))) == NULL)
+      return -1;
+  }
+
+  stack->items = items;
+  stack->capacity = capacity;
+
+  return 0;
+}
@@ -0,0 +1,154 @@
+/** 
+@file astack.h
+@brief 
+Definitions of a generic array-backed stack ADT
+
+The stack keeps its elements in a contiguous array of pointers that doubles in
+size as needed. The first ASTACK_INLINE_SIZE elements are stored inside the
+stack itself, so shallow stacks never touch the heap. Push and pop are defined
+inline and only call out of line when the array has to grow.
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#ifndef ASTACK_h
+#define ASTACK_h
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdlib.h>
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+/**
+The number of elements stored inside the stack before the heap is used (at
+least 1)
+*/
+#ifndef ASTACK_INLINE_SIZE
+#define ASTACK_INLINE_SIZE 16
+#endif
+
+/**
+@struct AStack_t
+Generic array-backed stack
+
+@note
+While the elements fit in the inline buffer _items_ points into the stack
+itself, so an initialized stack must not be copied or moved.
+*/
+typedef struct AStack_T {
+  int size;     ///< Number of elements in stack
+  int capacity; ///< Number of elements that fit before growing
+
+  void (*destroy)(void *data);
+
+  void **items; ///< Elements, bottom of the stack first
+
+  void *inline_items[ASTACK_INLINE_SIZE]; ///< Storage used until the stack grows
+
+} AStack_t;
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/**
+Function to initialize an array-backed stack
+
+@pre
+Must be called before stack can be used by any other operation
+
+The _destroy_ argument provides a way to free dynamically allocated data when
+*astack_destroy* is called. For a stack containing data that should not be 
+freed, _destroy_ should be set to NULL.
+
+Complexity: O(1)
+
+@param [out] *stack    The stack to init
+@param [in] (*destroy) Function pointer to free data element memory
+*/
+void astack_init(AStack_t *stack, void (*destroy)(void *data));
+
+/**
+Function to destroy an array-backed stack
+
+The *astack_destroy* operation removes all elements from the stack and calls
+the function passed as _destroy_ to *astack_init* once for each element as it
+is removed, provided _destroy_ was not set to NULL.
+
+Complexity: O(n) (O(1) if _destroy_ is NULL)
+
+@param [in,out] *stack  The stack to destroy
+*/
+void astack_destroy(AStack_t *stack);
+
+/**
+Function to double the capacity of an array-backed stack
+
+Called by *astack_push()* when the stack is full; there is normally no need
+to call it directly.
+
+Complexity: O(n)
+
+@param [in,out] *stack  The stack to grow
+
+@return 0 if the stack grew, otherwise -1
+*/
+int astack_grow(AStack_t *stack);
+
+/**
+Function to push an element to the top of the stack
+
+Complexity: O(1) amortized
+
+@param [in,out] *stack  The stack to push element onto
+@param [in]     *data   The data to push
+
+@return 0 if stack push was successful, otherwise -1
+*/
+static inline int astack_push(AStack_t *stack, const void *data)
+{
+  if (stack->size == stack->capacity && astack_grow(stack) != 0)
+    return -1;
+
+  stack->items[stack->size++] = (void *)data;
+  return 0;
+}
+
+/**
+Function to pop an element off the top of the stack
+
+Complexity: O(1)
+
+@param [in,out] *stack  The stack to pop the element from
+@param [out]    **data  The data popped off the stack
+
+@return 0 if stack pop was successful, otherwise -1
+*/
+static inline int astack_pop(AStack_t *stack, void **data)
+{
+  if (stack->size == 0)
+    return -1;
+
+  *data = stack->items[--stack->size];
+  return 0;
+}
+
+/**
+MACRO that provides mechanism to inspect the element at top of stack
+*/
+#define astack_peek(stack) ((stack)->size == 0 ? NULL : (stack)->items[(stack)->size - 1])
+
+/**
+MACRO that evaluates to the number of elements in the stack
+*/
+#define astack_size(stack) ((stack)->size)
+
+#ifdef __cplusplus
+}
+#endif
+#endif // ASTACK_h
@@ -16,10 +16,18 @@ See header
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 void clist_init(CList_t *list, void (*destroy)(void *data))
+{
+  clist_init_allocator(list, destroy, NULL);
+}
+
+
+void clist_init_allocator(CList_t *list, void (*destroy)(void *data), 
+                            const Allocator_t *allocator)
 {
   // Initialize the list
   list->size = 0;
   list->destroy = destroy;
+  list->allocator = allocator;
   list->head = NULL;
 }
 
@@ -28,9 +36,13 @@ void clist_destroy(CList_t *list)
 {
   void *data;
 
+  // Nothing to release per element if the allocator releases memory in bulk
+  if (list->destroy == NULL && allocator_is_bulk(list->allocator))
+    list->size = 0;
+
   // Remove each element in list
   while (clist_size(list) > 0) {
-    if (clist_remove_next(list, list->head, (void**)&data) == 0 && clist_destroy != NULL) {
+    if (clist_remove_next(list, list->head, (void**)&data) == 0 && list->destroy != NULL) {
       list->destroy(data);
     }
   }
@@ -45,7 +57,7 @@ int clist_insert_next(CList_t *list, CList_Element_t *element, const void *data)
   CList_Element_t *new_element;
 
   // Allocate storage for the element
-  if ((new_element = (CList_Element_t *)malloc(sizeof (CList_Element_t))) == NULL) {
+  if ((new_element = (CList_Element_t *)allocator_alloc(list->allocator, sizeof (CList_Element_t))) == NULL) {
     return -1;
   }
 
@@ -98,10 +110,106 @@ int clist_remove_next(CList_t *list, CList_Element_t *element, void **data)
   }
 
   // Free storage allocated by the abstract datatype
-  free (old_element);
+  allocator_free(list->allocator, old_element);
 
   // Adjust the size of the list
   list->size--;
 
   return 0;
 }
+
+
+int clist_concat(CList_t *list, CList_t *other)
+{
+  if (list == other)
+    return -1;
+
+  if (clist_size(other) == 0)
+    return 0;
+
+  return clist_splice_next(list, list->head, other, other->head);
+}
+
+
+int clist_splice_next(CList_t *list, CList_Element_t *element, 
+                      CList_t *other, CList_Element_t *last)
+{
+  CList_Element_t *next;
+
+  // Elements must go back to the allocator they came from
+  if (list == other || list->allocator != other->allocator)
+    return -1;
+
+  if (last == NULL || clist_size(other) == 0)
+    return -1;
+
+  // Do not allow a NULL element unless the list is empty
+  if (element == NULL && clist_size(list) != 0)
+    return -1;
+
+  if (clist_size(list) == 0) {
+    // The other ring becomes the list, starting just after last
+
+    list->head = last->next;
+  }
+  else {
+    // Exchanging the successors of two elements in separate rings joins them
+
+    next = element->next;
+    element->next = last->next;
+    last->next = next;
+  }
+
+  list->size += other->size;
+
+  // The other list is left empty
+  other->head = NULL;
+  other->size = 0;
+
+  return 0;
+}
+
+
+int clist_split(CList_t *list, CList_Element_t *element, CList_Element_t *last, 
+                CList_t *other)
+{
+  CList_Element_t *first;
+  CList_Element_t *walk;
+  int moves_head;
+  int count;
+
+  if (list == other || element == NULL || last == NULL || element == last)
+    return -1;
+
+  if (clist_size(list) == 0)
+    return -1;
+
+  // Count the elements to move, making sure last is found before element
+  first = element->next;
+  moves_head = 0;
+  count = 1;
+  for (walk = first; walk != last; walk = walk->next) {
+    if (walk == element)
+      return -1;
+    if (walk == list->head)
+      moves_head = 1;
+    count++;
+  }
+  if (last == list->head)
+    moves_head = 1;
+
+  clist_init_allocator(other, list->destroy, list->allocator);
+
+  // Exchanging the successors of two elements in the same ring splits it
+  element->next = last->next;
+  last->next = first;
+
+  other->head = first;
+  other->size = count;
+
+  if (moves_head)
+    list->head = element;
+  list->size -= count;
+
+  return 0;
+}
@@ -18,6 +18,8 @@ extern "C"
 
 #include <stdlib.h>
 
+#include "alloc.h"
+
 // -----------------------------------------------------------------------------
 // Definitions
 // -----------------------------------------------------------------------------
@@ -42,6 +44,8 @@ typedef struct CList_T {
   int (*match)(const void *a, const void *b);
   void (*destroy)(void *data);
 
+  const Allocator_t *allocator; ///< Allocator for elements (NULL for malloc)
+
   CList_Element_t *head; ///< Pointer to first element in list
 
 } CList_t;
@@ -69,6 +73,22 @@ Complexity: O(1)
 */
 void clist_init(CList_t *list, void (*destroy)(void *data));
 
+/**
+Function to initialize a circular linked-list whose elements come from an allocator
+
+Same as *clist_init()*, except the elements of the circular linked-list are allocated
+from _allocator_ rather than with _malloc_. The allocator must remain valid
+until the circular linked-list is destroyed. Passing NULL is equivalent to *clist_init()*.
+
+Complexity: O(1)
+
+@param [out] *list       The circular linked-list to init
+@param [in] (*destroy)   Function pointer to free data element memory
+@param [in]  *allocator  The allocator to take elements from
+*/
+void clist_init_allocator(CList_t *list, void (*destroy)(void *data), 
+                            const Allocator_t *allocator);
+
 /**
 Function to destroy a circular linked-list
 
@@ -80,6 +100,10 @@ as it is removed, provided _destroy_ was not set to NULL.
 No operation is permitted after *clist_destroy()* is called unless *clist_init()*
 is called again. 
 
+If _destroy_ is NULL and the elements come from an allocator that releases its
+memory in bulk (see *arena_allocator()*), no element needs to be visited and
+the circular linked-list is destroyed in O(1).
+
 Complexity: O(n)
 
 @param [in,out] *list  The circular linked-list to destroy
@@ -120,6 +144,73 @@ Complexity: O(1)
 */
 int clist_remove_next(CList_t *list, CList_Element_t *element, void **data);
 
+/**
+Function to move all the elements of one circular linked-list into another
+
+Joins the ring of _other_ into the ring of _list_ just after the head of
+_list_, leaving _other_ empty. Nothing is allocated or freed. Both lists must
+take their elements from the same allocator.
+
+Neither ring knows the element before its head, so the rings are joined by
+exchanging the successors of the two heads. Walking from the head of _list_
+then gives that head, the elements of _other_ starting just after its head and
+ending with its head, and then the rest of _list_. Each list keeps its own
+circular order. Use *clist_splice_next()* to choose where the ring of _other_
+starts.
+
+Complexity: O(1)
+
+@param [in,out] *list   The circular linked-list to add to
+@param [in,out] *other  The circular linked-list whose elements are moved
+
+@return 0 if concatenating the lists was successful, otherwise -1
+*/
+int clist_concat(CList_t *list, CList_t *other);
+
+/**
+Function to move all the elements of one circular linked-list into another at
+a given place
+
+Joins the ring of _other_ into the ring of _list_ just after _element_, leaving
+_other_ empty. The elements of _other_ follow _element_ in their circular order,
+starting just after _last_ and ending with _last_; pass the element before the
+head of _other_ as _last_ to keep its head first. When _list_ is empty,
+_element_ should be NULL. Nothing is allocated or freed. Both lists must take
+their elements from the same allocator.
+
+Complexity: O(1)
+
+@param [in,out] *list     The circular linked-list to add to
+@param [in]     *element  Pointer to element to insert after
+@param [in,out] *other    The circular linked-list whose elements are moved
+@param [in]     *last     Pointer to the element of _other_ to come last
+
+@return 0 if splicing the lists was successful, otherwise -1
+*/
+int clist_splice_next(CList_t *list, CList_Element_t *element, 
+                      CList_t *other, CList_Element_t *last);
+
+/**
+Function to split a circular linked-list
+
+Moves the elements just past _element_ up to and including _last_ into _other_,
+which is initialized like _list_ by this function and has the first element
+moved as its head. If the head of _list_ is moved, _element_ becomes the new
+head. Nothing is allocated or freed, but the elements moved are walked to count
+them.
+
+Complexity: O(k) for k elements moved
+
+@param [in,out] *list     The circular linked-list to split
+@param [in]     *element  Pointer to element just before the elements to move
+@param [in]     *last     Pointer to last element to move (not _element_)
+@param [out]    *other    The circular linked-list to receive the elements
+
+@return 0 if splitting the list was successful, otherwise -1
+*/
+int clist_split(CList_t *list, CList_Element_t *element, CList_Element_t *last, 
+                CList_t *other);
+
 /**
 MACRO that evaluates to the number of elements in the circular linked-list
 */
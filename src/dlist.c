@@ -11,15 +11,39 @@ See header
 
 #include "dlist.h"
 
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+/**
+Number of merge bins used by *dlist_sort()*, enough for any list an int can count
+*/
+#define DLIST_SORT_BINS 32
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static DList_Element_t *dlist_merge(DList_Element_t *a, DList_Element_t *b, 
+  int (*compare)(const void *key1, const void *key2));
+
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // Public Functions
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 void dlist_init(DList_t *list, void (*destroy)(void *data))
+{
+  dlist_init_allocator(list, destroy, NULL);
+}
+
+
+void dlist_init_allocator(DList_t *list, void (*destroy)(void *data), 
+                            const Allocator_t *allocator)
 {
   // Initialize the list
   list->size = 0;
   list->destroy = destroy;
+  list->allocator = allocator;
   list->head = NULL;
   list->tail = NULL;
 }
@@ -29,6 +53,10 @@ void dlist_destroy(DList_t *list)
 {
   void *data;
 
+  // Nothing to release per element if the allocator releases memory in bulk
+  if (list->destroy == NULL && allocator_is_bulk(list->allocator))
+    list->size = 0;
+
   // Remove each element in list
   while (dlist_size(list) > 0) {
     if (dlist_remove(list, dlist_tail(list), (void**)&data) == 0 && list->destroy != NULL) {
@@ -50,7 +78,7 @@ int dlist_insert_next(DList_t *list, DList_Element_t *element, const void *data)
     return -1;
 
   // Allocate storage for the element
-  if ((new_element = (DList_Element_t *)malloc(sizeof (DList_Element_t))) == NULL) {
+  if ((new_element = (DList_Element_t *)allocator_alloc(list->allocator, sizeof (DList_Element_t))) == NULL) {
     return -1;
   }
 
@@ -95,7 +123,7 @@ int dlist_insert_prev(DList_t *list, DList_Element_t *element, const void *data)
     return -1;
 
   // Allocate storage for the element
-  if ((new_element = (DList_Element_t *)malloc(sizeof (DList_Element_t))) == NULL) {
+  if ((new_element = (DList_Element_t *)allocator_alloc(list->allocator, sizeof (DList_Element_t))) == NULL) {
     return -1;
   }
 
@@ -163,10 +191,270 @@ int dlist_remove(DList_t *list, DList_Element_t *element, void **data)
   }
 
   // Free storage allocated by the abstract datatype
-  free (element);
+  allocator_free(list->allocator, element);
 
   // Adjust the size of the list
   list->size--;
 
   return 0;
 }
+
+
+int dlist_move_prev(DList_t *list, DList_Element_t *element, DList_Element_t *target)
+{
+  // Do not allow NULL elements
+  if (element == NULL || target == NULL)
+    return -1;
+
+  // Already in place
+  if (element == target || element->next == target)
+    return 0;
+
+  // Unlink the element from its current position
+  if (element->prev == NULL)
+    list->head = element->next;
+  else
+    element->prev->next = element->next;
+
+  if (element->next == NULL)
+    list->tail = element->prev;
+  else
+    element->next->prev = element->prev;
+
+  // Link it back in just before the target
+  element->next = target;
+  element->prev = target->prev;
+
+  if (target->prev == NULL)
+    list->head = element;
+  else
+    target->prev->next = element;
+
+  target->prev = element;
+
+  return 0;
+}
+
+
+int dlist_concat(DList_t *list, DList_t *other)
+{
+  // Elements must go back to the allocator they came from
+  if (list == other || list->allocator != other->allocator)
+    return -1;
+
+  if (dlist_size(other) == 0)
+    return 0;
+
+  if (dlist_size(list) == 0)
+    list->head = other->head;
+  else {
+    list->tail->next = other->head;
+    other->head->prev = list->tail;
+  }
+
+  list->tail = other->tail;
+  list->size += other->size;
+
+  // The other list is left empty
+  other->head = NULL;
+  other->tail = NULL;
+  other->size = 0;
+
+  return 0;
+}
+
+
+int dlist_splice_next(DList_t *list, DList_Element_t *element, 
+                      DList_t *other, DList_Element_t *first, DList_Element_t *last)
+{
+  DList_Element_t *walk;
+  int count;
+
+  // Elements must go back to the allocator they came from
+  if (list == other || list->allocator != other->allocator)
+    return -1;
+
+  if (first == NULL || last == NULL || dlist_size(other) == 0)
+    return -1;
+
+  // Count the range, unless it is the whole list
+  if (first == other->head && last == other->tail)
+    count = other->size;
+  else {
+    count = 1;
+    for (walk = first; walk != last; walk = walk->next) {
+      if (walk->next == NULL)
+        return -1;
+      count++;
+    }
+  }
+
+  // Unlink the range from the other list
+  if (first->prev == NULL)
+    other->head = last->next;
+  else
+    first->prev->next = last->next;
+
+  if (last->next == NULL)
+    other->tail = first->prev;
+  else
+    last->next->prev = first->prev;
+
+  other->size -= count;
+
+  // Link the range into the list
+  if (element == NULL) {
+    first->prev = NULL;
+    last->next = list->head;
+
+    if (list->head == NULL)
+      list->tail = last;
+    else
+      list->head->prev = last;
+
+    list->head = first;
+  }
+  else {
+    first->prev = element;
+    last->next = element->next;
+
+    if (element->next == NULL)
+      list->tail = last;
+    else
+      element->next->prev = last;
+
+    element->next = first;
+  }
+
+  list->size += count;
+
+  return 0;
+}
+
+
+int dlist_split(DList_t *list, DList_Element_t *element, DList_t *other)
+{
+  DList_Element_t *first;
+  DList_Element_t *walk;
+  int count;
+
+  if (list == other)
+    return -1;
+
+  dlist_init_allocator(other, list->destroy, list->allocator);
+
+  first = element == NULL ? list->head : element->next;
+  if (first == NULL)
+    return 0;
+
+  count = 0;
+  for (walk = first; walk != NULL; walk = walk->next)
+    count++;
+
+  other->head = first;
+  other->tail = list->tail;
+  other->size = count;
+  first->prev = NULL;
+
+  if (element == NULL)
+    list->head = NULL;
+  else
+    element->next = NULL;
+
+  list->tail = element;
+  list->size -= count;
+
+  return 0;
+}
+
+
+int dlist_sort(DList_t *list, int (*compare)(const void *key1, const void *key2))
+{
+  DList_Element_t *bins[DLIST_SORT_BINS];
+  DList_Element_t *element;
+  DList_Element_t *next;
+  DList_Element_t *run;
+  int used;
+  int i;
+
+  if (compare == NULL)
+    return -1;
+
+  if (dlist_size(list) < 2)
+    return 0;
+
+  // Bin i holds a sorted run of 2^i elements taken from the list before the
+  // elements in any lower bin; like a binary counter, each new element is
+  // merged with the bins it carries into
+  used = 0;
+  for (element = list->head; element != NULL; element = next) {
+    next = element->next;
+
+    element->next = NULL;
+    run = element;
+
+    for (i = 0; i < used && bins[i] != NULL; i++) {
+      run = dlist_merge(bins[i], run, compare);
+      bins[i] = NULL;
+    }
+
+    if (i == used)
+      used++;
+    bins[i] = run;
+  }
+
+  // Merge what is left in the bins, earlier (higher) bins first in each merge
+  run = NULL;
+  for (i = 0; i < used; i++) {
+    if (bins[i] != NULL)
+      run = run == NULL ? bins[i] : dlist_merge(bins[i], run, compare);
+  }
+
+  // The merges only link forward, so restore the backward links and the tail
+  list->head = run;
+  run->prev = NULL;
+  for (element = run; element->next != NULL; element = element->next)
+    element->next->prev = element;
+  list->tail = element;
+
+  return 0;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+/**
+Merge two sorted, NULL terminated chains of elements into one
+
+Only the _next_ links are set. On ties the element from _a_ comes first, which
+keeps the sort stable as long as _a_ holds the earlier elements.
+
+@param [in,out] *a         The chain of earlier elements
+@param [in,out] *b         The chain of later elements
+@param [in]    (*compare)  Function pointer to order the data of two elements
+
+@return the head of the merged chain
+*/
+static DList_Element_t *dlist_merge(DList_Element_t *a, DList_Element_t *b, 
+  int (*compare)(const void *key1, const void *key2))
+{
+  DList_Element_t head;
+  DList_Element_t *last = &head;
+
+  while (a != NULL && b != NULL) {
+    if (compare(a->data, b->data) <= 0) {
+      last->next = a;
+      a = a->next;
+    }
+    else {
+      last->next = b;
+      b = b->next;
+    }
+    last = last->next;
+  }
+
+  last->next = a != NULL ? a : b;
+
+  return head.next;
+}
@@ -18,6 +18,8 @@ extern "C"
 
 #include <stdlib.h>
 
+#include "alloc.h"
+
 // -----------------------------------------------------------------------------
 // Definitions
 // -----------------------------------------------------------------------------
@@ -44,6 +46,8 @@ typedef struct DList_T {
   int (*match)(const void *a, const void *b);
   void (*destroy)(void *data);
 
+  const Allocator_t *allocator; ///< Allocator for elements (NULL for malloc)
+
   DList_Element_t *head; ///< Pointer to first element in list
   DList_Element_t *tail; ///< Pointer to last element in list
 
@@ -72,6 +76,22 @@ Complexity: O(1)
 */
 void dlist_init(DList_t *list, void (*destroy)(void *data));
 
+/**
+Function to initialize a doubly linked-list whose elements come from an allocator
+
+Same as *dlist_init()*, except the elements of the doubly linked-list are allocated
+from _allocator_ rather than with _malloc_. The allocator must remain valid
+until the doubly linked-list is destroyed. Passing NULL is equivalent to *dlist_init()*.
+
+Complexity: O(1)
+
+@param [out] *list       The doubly linked-list to init
+@param [in] (*destroy)   Function pointer to free data element memory
+@param [in]  *allocator  The allocator to take elements from
+*/
+void dlist_init_allocator(DList_t *list, void (*destroy)(void *data), 
+                            const Allocator_t *allocator);
+
 /**
 Function to destroy a doubly linked-list
 
@@ -83,6 +103,10 @@ it is removed, provided _destroy_ was not set to NULL.
 No operation is permitted after *dlist_destroy()* is called unless *dlist_init()*
 is called again. 
 
+If _destroy_ is NULL and the elements come from an allocator that releases its
+memory in bulk (see *arena_allocator()*), no element needs to be visited and
+the doubly linked-list is destroyed in O(1).
+
 Complexity: O(n)
 
 @param [in,out] *list  The doubly linked-list to destroy
@@ -141,6 +165,100 @@ Complexity: O(1)
 */
 int dlist_remove(DList_t *list, DList_Element_t *element, void **data);
 
+/**
+Function to move an element of a doubly linked-list just before another
+
+Relinks _element_ so it sits just before _target_ in the same doubly
+linked-list. Nothing is allocated or freed, so moving an element to the head
+(pass the current head as _target_) is a cheap way to keep a list in order of
+recent use.
+
+Complexity: O(1)
+
+@param [in,out] *list     The doubly linked-list holding both elements
+@param [in]     *element  Pointer to element to move
+@param [in]     *target   Pointer to element to move before
+
+@return 0 if moving the element was successful, otherwise -1
+*/
+int dlist_move_prev(DList_t *list, DList_Element_t *element, DList_Element_t *target);
+
+/**
+Function to move all the elements of one doubly linked-list to the end of
+another
+
+The elements of _other_ are linked in after the tail of _list_, leaving _other_
+empty. Nothing is allocated or freed. Both lists must take their elements from
+the same allocator.
+
+Complexity: O(1)
+
+@param [in,out] *list   The doubly linked-list to append to
+@param [in,out] *other  The doubly linked-list whose elements are moved
+
+@return 0 if concatenating the lists was successful, otherwise -1
+*/
+int dlist_concat(DList_t *list, DList_t *other);
+
+/**
+Function to move a range of elements from one doubly linked-list into another
+
+Unlinks the elements of _other_ from _first_ up to and including _last_, and
+links them in just after _element_ in _list_. If _element_ is NULL the range is
+inserted at the head of _list_. Nothing is allocated or freed. Both lists must
+take their elements from the same allocator.
+
+The range is walked to count its elements, unless it is the whole of _other_.
+
+Complexity: O(1) for a whole list, otherwise O(k) for k elements moved
+
+@param [in,out] *list     The doubly linked-list to insert the range into
+@param [in]     *element  Pointer to element to insert after
+@param [in,out] *other    The doubly linked-list to take the range from
+@param [in]     *first    Pointer to first element of the range
+@param [in]     *last     Pointer to last element of the range
+
+@return 0 if splicing the range was successful, otherwise -1
+*/
+int dlist_splice_next(DList_t *list, DList_Element_t *element, 
+                      DList_t *other, DList_Element_t *first, DList_Element_t *last);
+
+/**
+Function to split a doubly linked-list after an element
+
+Moves the elements just past _element_ to the end of the list into _other_,
+which is initialized like _list_ by this function. If _element_ is NULL, every
+element is moved. Nothing is allocated or freed, but the elements moved are
+walked to count them.
+
+Complexity: O(m) for m elements moved
+
+@param [in,out] *list     The doubly linked-list to split
+@param [in]     *element  Pointer to last element to keep in _list_
+@param [out]    *other    The doubly linked-list to receive the remaining elements
+
+@return 0 if splitting the list was successful, otherwise -1
+*/
+int dlist_split(DList_t *list, DList_Element_t *element, DList_t *other);
+
+/**
+Function to sort a doubly linked-list
+
+Sorts the elements into the order given by _compare_, which is called with the
+data of two elements and returns a negative, zero or positive value as for
+_qsort_. The sort is a bottom-up merge sort that relinks the existing elements,
+so nothing is allocated, and it is stable: elements comparing equal keep their
+relative order.
+
+Complexity: O(n log n)
+
+@param [in,out] *list     The doubly linked-list to sort
+@param [in]    (*compare) Function pointer to order the data of two elements
+
+@return 0 if sorting the list was successful, otherwise -1
+*/
+int dlist_sort(DList_t *list, int (*compare)(const void *key1, const void *key2));
+
 /**
 MACRO that evaluates to the number of elements in the doubly linked-list
 */
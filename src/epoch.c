@@ -0,0 +1,276 @@
+/**
+@file epoch.c
+
+See header
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "epoch.h"
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static int epoch_try_advance(Epoch_t *epoch);
+static int epoch_reclaim(Epoch_Record_t *record, unsigned global);
+static void epoch_drain(Epoch_Record_t *record, Epoch_Limbo_t *limbo);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void epoch_init(Epoch_t *epoch)
+{
+  atomic_init(&epoch->global, 0);
+  atomic_init(&epoch->records, NULL);
+}
+
+
+void epoch_destroy(Epoch_t *epoch)
+{
+  Epoch_Record_t *record;
+  Epoch_Record_t *next;
+  int i;
+
+  record = atomic_load(&epoch->records);
+
+  while (record != NULL) {
+    next = record->next;
+
+    // No thread is left, so everything still in limbo is safe
+    for (i = 0; i < EPOCH_LIMBO_LISTS; i++) {
+      epoch_drain(record, &record->limbo[i]);
+      free(record->limbo[i].items);
+    }
+    free(record);
+
+    record = next;
+  }
+
+  // No operations permitted at this point -- clear memory as precaution
+  memset(epoch, 0, sizeof (Epoch_t));
+}
+
+
+Epoch_Record_t *epoch_register(Epoch_t *epoch)
+{
+  Epoch_Record_t *record;
+  Epoch_Record_t *head;
+  int unused;
+
+  // Adopt the record of a thread which has left
+  for (record = atomic_load(&epoch->records); record != NULL; record = record->next) {
+    unused = 0;
+    if (atomic_load_explicit(&record->in_use, memory_order_relaxed) == 0 && 
+        atomic_compare_exchange_strong(&record->in_use, &unused, 1))
+      return record;
+  }
+
+  // Otherwise push a new one onto the domain
+  record = (Epoch_Record_t *)aligned_alloc(EPOCH_CACHE_LINE, sizeof (Epoch_Record_t));
+  if (record == NULL)
+    return NULL;
+
+  memset(record, 0, sizeof (Epoch_Record_t));
+  atomic_init(&record->state, 0);
+  atomic_init(&record->in_use, 1);
+  record->domain = epoch;
+  record->next_poll = EPOCH_RETIRE_THRESHOLD;
+
+  head = atomic_load(&epoch->records);
+  do {
+    record->next = head;
+  } while (!atomic_compare_exchange_weak(&epoch->records, &head, record));
+
+  return record;
+}
+
+
+void epoch_unregister(Epoch_Record_t *record)
+{
+  epoch_synchronize(record);
+
+  atomic_store_explicit(&record->state, 0, memory_order_release);
+  atomic_store_explicit(&record->in_use, 0, memory_order_release);
+}
+
+
+void epoch_enter(Epoch_Record_t *record)
+{
+  unsigned global;
+
+  if (record->nesting++ > 0)
+    return;
+
+  // Announce the epoch before touching any shared node; the full fence keeps
+  // the loads that follow from moving ahead of the store, which a seq_cst
+  // store alone does not do for acquire loads. It pairs with the fence in
+  // *epoch_try_advance()*
+  global = atomic_load(&record->domain->global);
+  atomic_store_explicit(&record->state, (global << 1) | 1, memory_order_relaxed);
+  atomic_thread_fence(memory_order_seq_cst);
+}
+
+
+void epoch_exit(Epoch_Record_t *record)
+{
+  if (--record->nesting > 0)
+    return;
+
+  atomic_store_explicit(&record->state, 0, memory_order_release);
+}
+
+
+void epoch_retire(Epoch_Record_t *record, void *ptr, 
+  void (*reclaim)(void *ptr, void *context), void *context)
+{
+  Epoch_Limbo_t *limbo;
+  Epoch_Retired_t *items;
+  unsigned global;
+  int capacity;
+
+  global = atomic_load(&record->domain->global);
+  limbo = &record->limbo[global & (EPOCH_LIMBO_LISTS - 1)];
+
+  // A list last used EPOCH_LIMBO_LISTS epochs ago only holds safe nodes
+  if (limbo->size > 0 && limbo->epoch != global)
+    epoch_drain(record, limbo);
+  limbo->epoch = global;
+
+  if (limbo->size == limbo->capacity) {
+    capacity = limbo->capacity > 0 ? 2 * limbo->capacity : EPOCH_RETIRE_THRESHOLD;
+    items = (Epoch_Retired_t *)realloc(limbo->items, capacity * sizeof (Epoch_Retired_t));
+
+    if (items == NULL) {
+      // Out of memory -- wait out a grace period and reclaim right now
+      epoch_synchronize(record);
+      reclaim(ptr, context);
+      return;
+    }
+
+    limbo->items = items;
+    limbo->capacity = capacity;
+  }
+
+  limbo->items[limbo->size].ptr = ptr;
+  limbo->items[limbo->size].reclaim = reclaim;
+  limbo->items[limbo->size].context = context;
+  limbo->size++;
+
+  // While some thread holds the epoch back, do not rescan on every retire
+  if (++record->retired >= record->next_poll)
+    epoch_poll(record);
+}
+
+
+int epoch_poll(Epoch_Record_t *record)
+{
+  int reclaimed;
+
+  epoch_try_advance(record->domain);
+
+  reclaimed = epoch_reclaim(record, atomic_load(&record->domain->global));
+  record->next_poll = record->retired + EPOCH_RETIRE_THRESHOLD;
+
+  return reclaimed;
+}
+
+
+void epoch_synchronize(Epoch_Record_t *record)
+{
+  unsigned start;
+  unsigned global;
+
+  // Every node retired so far is tagged with at most the current epoch, so
+  // two advances from here make all of them safe
+  start = atomic_load(&record->domain->global);
+
+  while ((global = atomic_load(&record->domain->global)) - start < 2) {
+    if (!epoch_try_advance(record->domain))
+      sched_yield();
+  }
+
+  epoch_reclaim(record, global);
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+/**
+Advance the global epoch if every thread in a critical section has seen it
+
+@param [in,out] *epoch  The domain
+
+@return nonzero if the global epoch moved on (by this or another thread)
+*/
+static int epoch_try_advance(Epoch_t *epoch)
+{
+  Epoch_Record_t *record;
+  unsigned global;
+  unsigned state;
+
+  global = atomic_load(&epoch->global);
+
+  // Either this scan sees a reader's announcement, or the reader sees every
+  // unlink made before it
+  atomic_thread_fence(memory_order_seq_cst);
+
+  for (record = atomic_load(&epoch->records); record != NULL; record = record->next) {
+    state = atomic_load(&record->state);
+    if ((state & 1) && state != ((global << 1) | 1))
+      return 0;
+  }
+
+  // Losing the race means somebody else advanced it, which is as good
+  atomic_compare_exchange_strong(&epoch->global, &global, global + 1);
+
+  return 1;
+}
+
+
+/**
+Reclaim the limbo lists of a record that are at least two epochs old
+
+@param [in,out] *record  The record
+@param [in]      global  The current global epoch
+
+@return the number of nodes reclaimed
+*/
+static int epoch_reclaim(Epoch_Record_t *record, unsigned global)
+{
+  int reclaimed = 0;
+  int i;
+
+  for (i = 0; i < EPOCH_LIMBO_LISTS; i++) {
+    if (record->limbo[i].size > 0 && global - record->limbo[i].epoch >= 2) {
+      reclaimed += record->limbo[i].size;
+      epoch_drain(record, &record->limbo[i]);
+    }
+  }
+
+  return reclaimed;
+}
+
+
+/**
+Run the reclaim callback of every node in a limbo list and empty it
+
+@param [in,out] *record  The record owning the list
+@param [in,out] *limbo   The list to drain
+*/
+static void epoch_drain(Epoch_Record_t *record, Epoch_Limbo_t *limbo)
+{
+  int i;
+
+  for (i = 0; i < limbo->size; i++)
+    limbo->items[i].reclaim(limbo->items[i].ptr, limbo->items[i].context);
+
+  record->retired -= limbo->size;
+  limbo->size = 0;
+}
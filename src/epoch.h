@@ -0,0 +1,236 @@
+/** 
+@file epoch.h
+@brief 
+Definitions of epoch-based memory reclamation for lock-free ADTs
+
+A lock-free reader may still hold a pointer to a node that another thread has
+just unlinked, so the node cannot be freed (or reused) straight away. Threads
+taking part register a record with an Epoch_t domain and bracket every access
+to shared nodes with *epoch_enter* / *epoch_exit*. Unlinked nodes are handed to
+*epoch_retire*, which parks them in per-record limbo lists tagged with the
+global epoch. The global epoch only advances once every thread inside a
+critical section has observed it, so two advances after a node was retired no
+thread can still reference it and its reclaim callback is run.
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#ifndef EPOCH_h
+#define EPOCH_h
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdatomic.h>
+#include <stdlib.h>
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+/**
+The assumed size of a cache line, used to keep the records of threads apart
+*/
+#ifndef EPOCH_CACHE_LINE
+#define EPOCH_CACHE_LINE 64
+#endif
+
+/**
+Number of pending retired nodes on a record that triggers a reclaim attempt
+*/
+#ifndef EPOCH_RETIRE_THRESHOLD
+#define EPOCH_RETIRE_THRESHOLD 64
+#endif
+
+/**
+Number of limbo lists per record (a power of two, at least 3)
+*/
+#define EPOCH_LIMBO_LISTS 4
+
+/**
+@struct Epoch_Retired_t
+Node waiting for it to be safe to reclaim
+*/
+typedef struct Epoch_Retired_T {
+  void *ptr;
+  void (*reclaim)(void *ptr, void *context);
+  void *context;
+} Epoch_Retired_t;
+
+/**
+@struct Epoch_Limbo_t
+Nodes retired during a single epoch
+*/
+typedef struct Epoch_Limbo_T {
+  unsigned epoch; ///< Global epoch at the time the nodes were retired
+  int size;
+  int capacity;
+  Epoch_Retired_t *items;
+} Epoch_Limbo_t;
+
+/**
+@struct Epoch_Record_t
+Per-thread participation in an epoch domain
+*/
+typedef struct Epoch_Record_T {
+  _Alignas(EPOCH_CACHE_LINE)
+  atomic_uint state; ///< Announced epoch << 1 | 1 while in a critical section
+
+  atomic_int in_use; ///< Nonzero while a thread owns the record
+
+  int nesting; ///< Depth of nested *epoch_enter* calls
+  int retired; ///< Number of nodes in the limbo lists
+  int next_poll; ///< Value of _retired_ at which to attempt reclamation
+
+  struct Epoch_T *domain;
+  struct Epoch_Record_T *next;
+
+  Epoch_Limbo_t limbo[EPOCH_LIMBO_LISTS];
+
+} Epoch_Record_t;
+
+/**
+@struct Epoch_t
+Epoch domain shared by the threads using a lock-free ADT
+*/
+typedef struct Epoch_T {
+  _Alignas(EPOCH_CACHE_LINE)
+  atomic_uint global; ///< Global epoch
+
+  _Alignas(EPOCH_CACHE_LINE)
+  _Atomic(Epoch_Record_t *) records; ///< Every record ever registered
+
+} Epoch_t;
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/**
+Function to initialize an epoch domain
+
+@pre
+Must be called before domain can be used by any other operation
+
+Complexity: O(1)
+
+@param [out] *epoch  The domain to init
+*/
+void epoch_init(Epoch_t *epoch);
+
+/**
+Function to destroy an epoch domain
+
+Runs the reclaim callback of every node still in limbo and frees the records.
+
+@pre
+Every record must have been unregistered
+
+Complexity: O(n)
+
+@param [in,out] *epoch  The domain to destroy
+*/
+void epoch_destroy(Epoch_t *epoch);
+
+/**
+Function to obtain a record for the calling thread
+
+Reuses the record of a thread that has unregistered when there is one.
+
+Complexity: O(t) where t is the number of records ever registered
+
+@param [in,out] *epoch  The domain to join
+
+@return the record, or NULL if memory could not be allocated
+*/
+Epoch_Record_t *epoch_register(Epoch_t *epoch);
+
+/**
+Function to give up a record
+
+Waits until every node the record retired has been reclaimed, so the reclaim
+callbacks never run after the caller has gone.
+
+@pre
+The record must not be inside a critical section
+
+@param [in,out] *record  The record to give up
+*/
+void epoch_unregister(Epoch_Record_t *record);
+
+/**
+Function to start a critical section
+
+Shared nodes may only be dereferenced between *epoch_enter* and *epoch_exit*.
+Calls may be nested.
+
+Complexity: O(1)
+
+@param [in,out] *record  The calling thread's record
+*/
+void epoch_enter(Epoch_Record_t *record);
+
+/**
+Function to end a critical section
+
+Complexity: O(1)
+
+@param [in,out] *record  The calling thread's record
+*/
+void epoch_exit(Epoch_Record_t *record);
+
+/**
+Function to defer reclaiming a node until no thread can reference it
+
+The node must already be unreachable for threads entering a critical section
+from now on. Once it is safe, _reclaim_ is called with _ptr_ and _context_ by
+the thread owning _record_.
+
+@pre
+If memory for the limbo list cannot be allocated, the call falls back to
+*epoch_synchronize*, so it should be made outside a critical section
+
+Complexity: O(1) amortized
+
+@param [in,out] *record   The calling thread's record
+@param [in]     *ptr      The node to reclaim
+@param [in]   (*reclaim)  Function pointer to reclaim the node
+@param [in]     *context  Extra argument passed to _reclaim_
+*/
+void epoch_retire(Epoch_Record_t *record, void *ptr, 
+  void (*reclaim)(void *ptr, void *context), void *context);
+
+/**
+Function to try to advance the global epoch and reclaim what has become safe
+
+Called automatically from *epoch_retire* each time EPOCH_RETIRE_THRESHOLD more
+nodes are pending than after the previous attempt.
+
+Complexity: O(t) where t is the number of records
+
+@param [in,out] *record  The calling thread's record
+
+@return the number of nodes reclaimed
+*/
+int epoch_poll(Epoch_Record_t *record);
+
+/**
+Function to wait until every node retired on the record has been reclaimed
+
+@pre
+The record must not be inside a critical section
+
+@param [in,out] *record  The calling thread's record
+*/
+void epoch_synchronize(Epoch_Record_t *record);
+
+/**
+MACRO that evaluates to the number of nodes the record has waiting in limbo
+*/
+#define epoch_pending(record) ((record)->retired)
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EPOCH_h
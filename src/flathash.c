@@ -0,0 +1,378 @@
+/** 
+@file flathash.c
+
+See header
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__) && !defined(FLATHASH_NO_SSE2)
+#include <emmintrin.h>
+#define FLATHASH_USE_SSE2
+#endif
+
+#include "flathash.h"
+
+// -----------------------------------------------------------------------------
+// Local Definitions
+// -----------------------------------------------------------------------------
+
+#define CTRL_EMPTY   ((signed char)-128) ///< Slot has never been used
+#define CTRL_DELETED ((signed char)-2)   ///< Slot held an element that was removed
+
+// -----------------------------------------------------------------------------
+// Local Function Prototypes
+// -----------------------------------------------------------------------------
+
+static uint64_t flathash_mix(const FlatHash_t *fhash, const void *data);
+
+static unsigned int group_match(const signed char *ctrl, signed char h2);
+static unsigned int group_empty(const signed char *ctrl);
+static unsigned int group_available(const signed char *ctrl);
+static int lowest_bit(unsigned int mask);
+
+static int flathash_find(const FlatHash_t *fhash, const void *data, uint64_t hash, int *avail);
+static int flathash_available(const FlatHash_t *fhash, uint64_t hash);
+static int flathash_rehash(FlatHash_t *fhash, int capacity);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+int flathash_init(FlatHash_t *fhash, int capacity, 
+                  uint64_t (*hash)(const void *key),
+                  int (*match)(const void *a, const void *b),
+                  void (*destroy)(void *data))
+{
+  int slots;
+
+  // Round the capacity up to a power of two of at least one group
+  slots = FLATHASH_GROUP_SIZE;
+  while (slots < capacity)
+    slots *= 2;
+
+  // Allocate space for the control bytes and slots
+  if ((fhash->ctrl = (signed char *)malloc(slots)) == NULL)
+    return -1;
+
+  if ((fhash->slots = (void **)malloc(slots * sizeof (void *))) == NULL) {
+    free(fhash->ctrl);
+    return -1;
+  }
+
+  memset(fhash->ctrl, CTRL_EMPTY, slots);
+
+  fhash->capacity = slots;
+  fhash->hash = hash;
+  fhash->match = match;
+  fhash->destroy = destroy;
+  fhash->size = 0;
+  fhash->deleted = 0;
+
+  return 0;
+}
+
+
+void flathash_destroy(FlatHash_t *fhash)
+{
+  int i;
+
+  // Destroy each element
+  if (fhash->destroy != NULL) {
+    for (i = 0; i < fhash->capacity; i++) {
+      if (flathash_is_used(fhash, i))
+        fhash->destroy(fhash->slots[i]);
+    }
+  }
+
+  // Free memory allocated for the hash table
+  free(fhash->ctrl);
+  free(fhash->slots);
+
+  // No operations permitted at this point -- clear memory as precaution
+  memset(fhash, 0, sizeof (FlatHash_t));
+}
+
+
+int flathash_insert(FlatHash_t *fhash, const void *data)
+{
+  uint64_t hash;
+  int capacity;
+  int slot;
+
+  hash = flathash_mix(fhash, data);
+
+  // Do nothing if the data is already in the table
+  if (flathash_find(fhash, data, hash, &slot) >= 0)
+    return 1;
+
+  // Keep the table at most 7/8 full so every probe sequence reaches an empty slot
+  if (fhash->size + fhash->deleted + 1 > fhash->capacity - fhash->capacity / 8) {
+    // Rehash in place if tombstones account for much of the load
+    capacity = fhash->capacity;
+    if ((fhash->size + 1) * 2 > capacity - capacity / 8)
+      capacity *= 2;
+
+    if (flathash_rehash(fhash, capacity) != 0)
+      return -1;
+
+    slot = flathash_available(fhash, hash);
+  }
+
+  // Store the data in the first available slot on the probe sequence
+  if (fhash->ctrl[slot] == CTRL_DELETED)
+    fhash->deleted--;
+
+  fhash->ctrl[slot] = (signed char)(hash & 0x7f);
+  fhash->slots[slot] = (void *)data;
+  fhash->size++;
+
+  return 0;
+}
+
+
+int flathash_remove(FlatHash_t *fhash, void **data)
+{
+  int slot;
+
+  // Search for the data
+  if ((slot = flathash_find(fhash, *data, flathash_mix(fhash, *data), NULL)) < 0)
+    return -1;
+
+  *data = fhash->slots[slot];
+
+  // A group with an empty slot never caused a probe to continue past it, so
+  // the slot can be marked empty rather than leaving a tombstone
+  if (group_empty(&fhash->ctrl[slot & ~(FLATHASH_GROUP_SIZE - 1)]) != 0) {
+    fhash->ctrl[slot] = CTRL_EMPTY;
+  }
+  else {
+    fhash->ctrl[slot] = CTRL_DELETED;
+    fhash->deleted++;
+  }
+
+  fhash->size--;
+
+  return 0;
+}
+
+
+int flathash_lookup(const FlatHash_t *fhash, void **data)
+{
+  int slot;
+
+  // Search for the data
+  if ((slot = flathash_find(fhash, *data, flathash_mix(fhash, *data), NULL)) < 0)
+    return -1;
+
+  // Pass back the data from the table
+  *data = fhash->slots[slot];
+  return 0;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+/**
+Function to compute the user hash and spread its bits
+
+The low 7 bits are stored in the control byte and the remaining bits select the
+group where probing starts, so both need to be well distributed.
+*/
+static uint64_t flathash_mix(const FlatHash_t *fhash, const void *data)
+{
+  uint64_t h = fhash->hash(data);
+
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+
+  return h;
+}
+
+
+/**
+Function to get a bitmask of the slots in a group whose control byte is _h2_
+*/
+static unsigned int group_match(const signed char *ctrl, signed char h2)
+{
+#ifdef FLATHASH_USE_SSE2
+  __m128i group = _mm_loadu_si128((const __m128i *)ctrl);
+  return (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(h2)));
+#else
+  unsigned int mask = 0;
+  int i;
+
+  for (i = 0; i < FLATHASH_GROUP_SIZE; i++) {
+    if (ctrl[i] == h2)
+      mask |= 1U << i;
+  }
+  return mask;
+#endif
+}
+
+
+/**
+Function to get a bitmask of the empty slots in a group
+*/
+static unsigned int group_empty(const signed char *ctrl)
+{
+  return group_match(ctrl, CTRL_EMPTY);
+}
+
+
+/**
+Function to get a bitmask of the empty or deleted slots in a group
+*/
+static unsigned int group_available(const signed char *ctrl)
+{
+#ifdef FLATHASH_USE_SSE2
+  // Empty and deleted are the only control bytes with the sign bit set
+  return (unsigned int)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)ctrl));
+#else
+  unsigned int mask = 0;
+  int i;
+
+  for (i = 0; i < FLATHASH_GROUP_SIZE; i++) {
+    if (ctrl[i] < 0)
+      mask |= 1U << i;
+  }
+  return mask;
+#endif
+}
+
+
+/**
+Function to get the index of the lowest set bit in a non-zero mask
+*/
+static int lowest_bit(unsigned int mask)
+{
+#if defined(__GNUC__)
+  return __builtin_ctz(mask);
+#else
+  int i = 0;
+  while ((mask & 1U) == 0) {
+    mask >>= 1;
+    i++;
+  }
+  return i;
+#endif
+}
+
+
+/**
+Function to search the table for an element matching _data_
+
+Groups are visited in triangular order, which covers every group when the
+number of groups is a power of two. The search ends at the first group with an
+empty slot. If _avail_ is not NULL it receives the first empty or deleted slot
+seen along the way.
+
+@returns the slot of the matching element, otherwise -1
+*/
+static int flathash_find(const FlatHash_t *fhash, const void *data, uint64_t hash, int *avail)
+{
+  const signed char *ctrl;
+  unsigned int groups;
+  unsigned int group;
+  unsigned int mask;
+  unsigned int i;
+  int slot;
+
+  groups = (unsigned int)fhash->capacity / FLATHASH_GROUP_SIZE;
+  group = (unsigned int)(hash >> 7) & (groups - 1);
+
+  if (avail != NULL)
+    *avail = -1;
+
+  for (i = 0; i < groups; i++) {
+    ctrl = &fhash->ctrl[group * FLATHASH_GROUP_SIZE];
+
+    // Only compare the slots whose control byte matches the hash
+    for (mask = group_match(ctrl, (signed char)(hash & 0x7f)); mask != 0; mask &= mask - 1) {
+      slot = group * FLATHASH_GROUP_SIZE + lowest_bit(mask);
+      if (fhash->match(data, fhash->slots[slot]))
+        return slot;
+    }
+
+    if (avail != NULL && *avail < 0 && (mask = group_available(ctrl)) != 0)
+      *avail = group * FLATHASH_GROUP_SIZE + lowest_bit(mask);
+
+    if (group_empty(ctrl) != 0)
+      break;
+
+    group = (group + i + 1) & (groups - 1);
+  }
+
+  // Return that the data was not found
+  return -1;
+}
+
+
+/**
+Function to find the first empty or deleted slot on the probe sequence
+*/
+static int flathash_available(const FlatHash_t *fhash, uint64_t hash)
+{
+  unsigned int groups;
+  unsigned int group;
+  unsigned int mask;
+  unsigned int i;
+
+  groups = (unsigned int)fhash->capacity / FLATHASH_GROUP_SIZE;
+  group = (unsigned int)(hash >> 7) & (groups - 1);
+
+  for (i = 0; i < groups; i++) {
+    if ((mask = group_available(&fhash->ctrl[group * FLATHASH_GROUP_SIZE])) != 0)
+      return group * FLATHASH_GROUP_SIZE + lowest_bit(mask);
+
+    group = (group + i + 1) & (groups - 1);
+  }
+
+  return -1;
+}
+
+
+/**
+Function to move every element into freshly allocated arrays of _capacity_ slots
+
+@returns 0 if successful, otherwise -1 (the table is left unchanged)
+*/
+static int flathash_rehash(FlatHash_t *fhash, int capacity)
+{
+  FlatHash_t old;
+  uint64_t hash;
+  int slot;
+  int i;
+
+  old = *fhash;
+
+  if (flathash_init(fhash, capacity, old.hash, old.match, old.destroy) != 0) {
+    *fhash = old;
+    return -1;
+  }
+
+  // Reinsert each element, no matching is needed since they are all distinct
+  for (i = 0; i < old.capacity; i++) {
+    if (!flathash_is_used(&old, i))
+      continue;
+
+    hash = flathash_mix(fhash, old.slots[i]);
+    slot = flathash_available(fhash, hash);
+
+    fhash->ctrl[slot] = (signed char)(hash & 0x7f);
+    fhash->slots[slot] = old.slots[i];
+  }
+  fhash->size = old.size;
+
+  free(old.ctrl);
+  free(old.slots);
+
+  return 0;
+}
@@ -0,0 +1,161 @@
+/** 
+@file flathash.h
+@brief 
+Definitions of a generic open-addressing hash table
+
+The table keeps one control byte per slot alongside a flat array of data
+pointers. The control bytes are scanned a group of FLATHASH_GROUP_SIZE slots at
+a time (using SSE2 when available), and only slots whose control byte matches
+7 bits of the hash are compared with the user _match_ function. This layout is
+modeled after the "Swiss Table" design.
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#ifndef FLATHASH_h
+#define FLATHASH_h
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <stdlib.h>
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+/**
+The number of slots whose control bytes are examined at once
+*/
+#define FLATHASH_GROUP_SIZE 16
+
+/**
+@struct FlatHash_t
+Generic open-addressing hash table
+*/
+typedef struct FlatHash_T {
+  int capacity; ///< The number of slots (a power of two, multiple of group size)
+
+  uint64_t (*hash)(const void *key);
+  int (*match)(const void *a, const void *b);
+  void (*destroy)(void *data);
+
+  int size;    ///< The number of elements in the hash table
+  int deleted; ///< The number of slots holding a tombstone
+
+  signed char *ctrl; ///< Control byte for each slot (empty, deleted or hash bits)
+  void **slots;      ///< Flat array of data pointers
+
+} FlatHash_t;
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/**
+Function to initialize an open-addressing hash table
+
+@pre
+Must be called before hash table can be used by any other operation
+
+The initial number of slots is _capacity_ rounded up to a power of two (and at
+least one group). The table grows automatically as elements are inserted. The
+function pointer _hash_ specifies a user-defined hash function. The function
+pointer _match_ specifies a user-defined to determine whether two keys match.
+The _destroy_ argument provides a way to free dynamically allocated data when
+*flathash_destroy* is called. 
+
+Complexity: O(m), where *m* is the number of slots in the hash table
+
+@param [out] *fhash    The hash table to init
+@param [in]   capacity The initial number of slots in the hash table
+@param [in]  *hash     Pointer to user hash function
+@param [in]  *match    Pointer to user hash key comparison function
+@param [in]  *destroy  Pointer to function to free element memory
+
+@returns 0 if hash table init successful, otherwise -1
+*/
+int flathash_init(FlatHash_t *fhash, int capacity, 
+                  uint64_t (*hash)(const void *key),
+                  int (*match)(const void *a, const void *b),
+                  void (*destroy)(void *data));
+
+/**
+Function to destroy an open-addressing hash table
+
+The *flathash_destroy* operation removes all elements from hash table and calls
+the function passed as _destroy_ to *flathash_init* once for each element as it
+is removed, provided _destroy_ was not set to NULL.
+
+Complexity: O(m), where *m* is the number of slots in the hash table
+
+@param [in,out] *fhash  The hash table to destroy
+*/
+void flathash_destroy(FlatHash_t *fhash);
+
+/**
+Function to insert an element into an open-addressing hash table
+
+The table doubles in size once it is 7/8 full (counting tombstones left behind
+by *flathash_remove()*).
+
+Complexity: O(1) amortized
+
+@param [in,out] *fhash  The hash table to insert into
+@param [in]     *data   The data to insert
+
+@returns 0 if inserting the element was successful, 1 if the element was already
+in the hash table, otherwise -1
+*/
+int flathash_insert(FlatHash_t *fhash, const void *data);
+
+/**
+Function to remove an element from an open-addressing hash table
+
+Complexity: O(1)
+
+@param [in,out] *fhash  The hash table remove data from
+@param [in,out] **data  The key to remove, upon return the data removed
+
+@returns 0 if removing the element was successful, otherwise -1
+*/
+int flathash_remove(FlatHash_t *fhash, void **data);
+
+/**
+Function to determine if an element is contained within the hash table
+
+Complexity: O(1)
+
+@param [in]     *fhash  The hash table to lookup
+@param [in,out] **data  The key to find, upon return the matching data
+
+@returns 0 if the element was found in the hash table, otherwise -1
+*/
+int flathash_lookup(const FlatHash_t *fhash, void **data);
+
+/**
+MACRO that evaluates to the number of elements in the hash table
+*/
+#define flathash_size(fhash) ((fhash)->size)
+
+/**
+MACRO that evaluates to the number of slots in the hash table
+*/
+#define flathash_capacity(fhash) ((fhash)->capacity)
+
+/**
+MACRO that determines whether the given slot holds an element
+*/
+#define flathash_is_used(fhash, slot) ((fhash)->ctrl[(slot)] >= 0 ? 1 : 0)
+
+/**
+MACRO that evaluates to the data stored in the given slot
+*/
+#define flathash_data(fhash, slot) ((fhash)->slots[(slot)])
+
+#ifdef __cplusplus
+}
+#endif
+#endif // FLATHASH_h
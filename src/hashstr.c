@@ -6,8 +6,36 @@ See header
 @author Justin Hadella (pitchnogle@gmail.com)
 */
 
+#include <string.h>
+
 #include "hashstr.h"
 
+// -----------------------------------------------------------------------------
+// Local Definitions
+// -----------------------------------------------------------------------------
+
+/**
+Odd 64-bit constants with balanced bits used to mix the input
+*/
+static const uint64_t secret[4] = {
+  0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL,
+  0x8ebc6af09c88c6e3ULL, 0x589965cc75374cc3ULL
+};
+
+/**
+Seed used by hashstr64_cstr()
+*/
+static uint64_t default_seed = 0;
+
+// -----------------------------------------------------------------------------
+// Local Function Prototypes
+// -----------------------------------------------------------------------------
+
+static uint64_t read64(const unsigned char *p);
+static uint64_t read32(const unsigned char *p);
+static void mul128(uint64_t *a, uint64_t *b);
+static uint64_t mix(uint64_t a, uint64_t b);
+
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // Public Functions
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -35,3 +63,141 @@ unsigned int hashstr(const void *key)
 
   return val;
 }
+
+
+uint64_t hashstr64(const void *key, size_t len, uint64_t seed)
+{
+  const unsigned char *p;
+  uint64_t seed1;
+  uint64_t seed2;
+  uint64_t a;
+  uint64_t b;
+  size_t i;
+
+  p = (const unsigned char *)key;
+  seed ^= mix(seed ^ secret[0], secret[1]);
+
+  if (len <= 16) {
+    // Short keys are read as (possibly overlapping) 32-bit words
+    if (len >= 4) {
+      a = (read32(p) << 32) | read32(p + ((len >> 3) << 2));
+      b = (read32(p + len - 4) << 32) | read32(p + len - 4 - ((len >> 3) << 2));
+    }
+    else if (len > 0) {
+      a = ((uint64_t)p[0] << 16) | ((uint64_t)p[len >> 1] << 8) | p[len - 1];
+      b = 0;
+    }
+    else {
+      a = 0;
+      b = 0;
+    }
+  }
+  else {
+    i = len;
+
+    // Long keys are consumed 48 bytes at a time in three independent lanes
+    if (i > 48) {
+      seed1 = seed;
+      seed2 = seed;
+      do {
+        seed = mix(read64(p) ^ secret[1], read64(p + 8) ^ seed);
+        seed1 = mix(read64(p + 16) ^ secret[2], read64(p + 24) ^ seed1);
+        seed2 = mix(read64(p + 32) ^ secret[3], read64(p + 40) ^ seed2);
+        p += 48;
+        i -= 48;
+      } while (i > 48);
+
+      seed ^= seed1 ^ seed2;
+    }
+
+    while (i > 16) {
+      seed = mix(read64(p) ^ secret[1], read64(p + 8) ^ seed);
+      p += 16;
+      i -= 16;
+    }
+
+    // The last 16 bytes of the key (overlapping what was already consumed)
+    a = read64(p + i - 16);
+    b = read64(p + i - 8);
+  }
+
+  a ^= secret[1];
+  b ^= seed;
+  mul128(&a, &b);
+
+  return mix(a ^ secret[0] ^ len, b ^ secret[1]);
+}
+
+
+uint64_t hashstr64_cstr(const void *key)
+{
+  return hashstr64(key, strlen((const char *)key), default_seed);
+}
+
+
+void hashstr64_set_seed(uint64_t seed)
+{
+  default_seed = seed;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+/**
+Function to read an unaligned 64-bit little-endian word
+*/
+static uint64_t read64(const unsigned char *p)
+{
+  return (uint64_t)p[0]         | ((uint64_t)p[1] << 8)  |
+         ((uint64_t)p[2] << 16) | ((uint64_t)p[3] << 24) |
+         ((uint64_t)p[4] << 32) | ((uint64_t)p[5] << 40) |
+         ((uint64_t)p[6] << 48) | ((uint64_t)p[7] << 56);
+}
+
+
+/**
+Function to read an unaligned 32-bit little-endian word
+*/
+static uint64_t read32(const unsigned char *p)
+{
+  return (uint64_t)p[0]         | ((uint64_t)p[1] << 8)  |
+         ((uint64_t)p[2] << 16) | ((uint64_t)p[3] << 24);
+}
+
+
+/**
+Function to compute the full 128-bit product of _a_ and _b_
+
+Upon return _a_ holds the low 64 bits and _b_ the high 64 bits.
+*/
+static void mul128(uint64_t *a, uint64_t *b)
+{
+#if defined(__SIZEOF_INT128__)
+  __uint128_t r = (__uint128_t)*a * *b;
+
+  *a = (uint64_t)r;
+  *b = (uint64_t)(r >> 64);
+#else
+  uint64_t ha = *a >> 32, la = (uint32_t)*a;
+  uint64_t hb = *b >> 32, lb = (uint32_t)*b;
+  uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+  uint64_t t = rl + (rm0 << 32);
+  uint64_t c = t < rl;
+  uint64_t lo = t + (rm1 << 32);
+
+  c += lo < t;
+  *a = lo;
+  *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+
+/**
+Function to fold the 128-bit product of _a_ and _b_ into 64 bits
+*/
+static uint64_t mix(uint64_t a, uint64_t b)
+{
+  mul128(&a, &b);
+  return a ^ b;
+}
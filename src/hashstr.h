@@ -1,7 +1,7 @@
 /** 
 @file hashstr.h
 @brief 
-Definitions of a hash function for strings
+Definitions of hash functions for strings
 
 @note
 Code based on content from "Mastering Algorithms with C" (O'Reilly 1999)
@@ -16,6 +16,9 @@ extern "C"
 {
 #endif
 
+#include <stddef.h>
+#include <stdint.h>
+
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // Public Functions
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -28,6 +31,47 @@ Hash function for use with strings
 */
 unsigned int hashstr(const void *key);
 
+/**
+Seeded 64-bit hash function for arbitrary byte strings
+
+The key is consumed 16 bytes per step (48 bytes per step with three
+independent lanes for long keys) using 64x64->128 bit multiplies, following
+the design of wyhash. Unlike *hashstr()* the key does not have to be NUL
+terminated and all 64 bits of the result are well distributed.
+
+Choosing a random _seed_ per process (or per table) makes it impractical for
+clients to craft keys that collide, which defends hash tables against
+algorithmic complexity (HashDoS) attacks.
+
+@param [in] *key  The key to compute a hash for
+@param [in]  len  The length of the key in bytes
+@param [in]  seed Seed to perturb the hash with
+@return the 64-bit hash for given key
+*/
+uint64_t hashstr64(const void *key, size_t len, uint64_t seed);
+
+/**
+Hash function for use with NUL terminated strings
+
+Equivalent to *hashstr64()* on the string (without its terminator) using the
+seed set by *hashstr64_set_seed()*. The signature matches the _hash_ argument
+of *hashtable_init()* and *flathash_init()*.
+
+@param [in] *key  The key to compute a hash for (a string)
+@return the 64-bit hash for given string
+*/
+uint64_t hashstr64_cstr(const void *key);
+
+/**
+Function to set the seed used by *hashstr64_cstr()*
+
+The seed should be set once, before any hash table using *hashstr64_cstr()* is
+populated, since changing it changes every hash. The default seed is 0.
+
+@param [in] seed  The new seed
+*/
+void hashstr64_set_seed(uint64_t seed);
+
 #ifdef __cplusplus
 }
 #endif
@@ -11,119 +11,563 @@ See header
 
 #include "hashtable.h"
 
+// -----------------------------------------------------------------------------
+// Local Definitions
+// -----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#define hashtable_prefetch(addr) __builtin_prefetch(addr)
+#else
+#define hashtable_prefetch(addr) ((void)(addr))
+#endif
+
+// -----------------------------------------------------------------------------
+// Local Function Prototypes
+// -----------------------------------------------------------------------------
+
+static int hashtable_bucket(uint64_t hash, int buckets);
+static HashTable_Element_t **hashtable_home(HashTable_t *htable, uint64_t hash);
+static HashTable_Element_t **hashtable_find(HashTable_t *htable, const void *data, uint64_t hash);
+static int hashtable_link(HashTable_t *htable, const void *data, uint64_t hash);
+static void hashtable_destroy_chains(HashTable_t *htable, HashTable_Element_t **table, int buckets);
+
+static int hashtable_insert_hashed(HashTable_t *htable, const void *data, uint64_t hash);
+static int hashtable_remove_hashed(HashTable_t *htable, void **data, uint64_t hash);
+static int hashtable_lookup_hashed(HashTable_t *htable, void **data, uint64_t hash);
+static void hashtable_prefetch_batch(HashTable_t *htable, void **data, int n, uint64_t *hashes);
+
+static int hashtable_resize(HashTable_t *htable, int buckets);
+static void hashtable_rehash_step(HashTable_t *htable);
+static void hashtable_check_load(HashTable_t *htable);
+
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // Public Functions
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 int hashtable_init(HashTable_t *htable, int buckets, 
-                   int (*hash)(const void *key),
+                   uint64_t (*hash)(const void *key),
                    int (*match)(const void *a, const void *b),
                    void (*destroy)(void *data))
 {
-  int i;
+  return hashtable_init_allocator(htable, buckets, hash, match, destroy, NULL);
+}
+
 
-  // Allocate space for the hash table
-  if ((htable->table = (List_t*)malloc(buckets * sizeof (List_t))) == NULL)
+int hashtable_init_allocator(HashTable_t *htable, int buckets, 
+                             uint64_t (*hash)(const void *key),
+                             int (*match)(const void *a, const void *b),
+                             void (*destroy)(void *data),
+                             const Allocator_t *allocator)
+{
+  // Allocate space for the hash table, every bucket starts out empty
+  if ((htable->table = (HashTable_Element_t **)calloc(buckets, sizeof (HashTable_Element_t *))) == NULL)
     return -1;
   
-  // Initialize the buckets
   htable->buckets = buckets;
-  for (i = 0; i < htable->buckets; i++)
-    list_init(&htable->table[i], destroy);
-  
   htable->hash = hash;
   htable->match = match;
   htable->destroy = destroy;
+  htable->allocator = allocator;
   htable->size = 0;
 
+  // The table is fixed size until a load factor is set
+  htable->grow_load = 0;
+  htable->shrink_load = 0;
+  htable->min_buckets = buckets;
+
+  htable->rehash_index = -1;
+  htable->rehash_buckets = 0;
+  htable->rehash_table = NULL;
+
   return 0;
 }
 
 
 void hashtable_destroy(HashTable_t *htable)
 {
-  // Destroy each bucket
-  int i;
-  for (i = 0; i < htable->buckets; i++)
-    list_destroy(&htable->table[i]);
+  // Destroy each bucket of both tables
+  hashtable_destroy_chains(htable, htable->table, htable->buckets);
 
-  // Free memory allocated for the hash table
-  free(htable->table);
+  if (htable->rehash_table != NULL)
+    hashtable_destroy_chains(htable, htable->rehash_table, htable->rehash_buckets);
 
   // No operations permitted at this point -- clear memory as precaution
   memset(htable, 0, sizeof (HashTable_t));
 }
 
 
+int hashtable_set_load_factor(HashTable_t *htable, double grow, double shrink)
+{
+  // Shrinking must leave the table comfortably below the growth threshold
+  if (grow < 0 || shrink < 0 || (shrink > 0 && shrink * 2 >= grow))
+    return -1;
+
+  htable->grow_load = grow;
+  htable->shrink_load = shrink;
+
+  return 0;
+}
+
+
 int hashtable_insert(HashTable_t *htable, const void *data)
 {
-  void *tmp;
-  int bucket;
+  return hashtable_insert_hashed(htable, data, htable->hash(data));
+}
+
+
+int hashtable_remove(HashTable_t *htable, void **data)
+{
+  return hashtable_remove_hashed(htable, data, htable->hash(*data));
+}
+
+
+int hashtable_lookup(HashTable_t *htable, void **data)
+{
+  return hashtable_lookup_hashed(htable, data, htable->hash(*data));
+}
+
+
+int hashtable_upsert(HashTable_t *htable, void **data)
+{
+  HashTable_Element_t **link;
+  void *old;
+  uint64_t hash;
   int retval;
 
-  // Do nothing if the data is already in the table
-  tmp = (void*)data;
-  if (hashtable_lookup(htable, &tmp) == 0)
+  hashtable_rehash_step(htable);
+
+  hash = htable->hash(*data);
+
+  // Replace a matching element in place, it necessarily hashes the same
+  if ((link = hashtable_find(htable, *data, hash)) != NULL) {
+    old = hashtable_data(*link);
+    hashtable_data(*link) = *data;
+    *data = old;
     return 1;
+  }
 
-  // Calculate the hash
-  bucket = htable->hash(data) % htable->buckets;
+  // Otherwise insert the data into the bucket for its hash
+  if ((retval = hashtable_link(htable, *data, hash)) != 0)
+    return retval;
 
-  // Insert the data into the bucket
-  if ((retval = list_insert_next(&htable->table[bucket], NULL, data)) == 0)
-    htable->size++;
-  
-  return retval;
+  *data = NULL;
+  return 0;
 }
 
 
-int hashtable_remove(HashTable_t *htable, void **data)
+int hashtable_get_or_insert_with(HashTable_t *htable, void **data,
+                                 void *(*factory)(const void *key))
 {
-  List_Element_t *element;
-  List_Element_t *prev;
-  int bucket;
+  HashTable_Element_t **link;
+  void *created;
+  uint64_t hash;
 
-  // Calculate the hash
-  bucket = htable->hash(*data) % htable->buckets;
-
-  // Search for the data in the bucket
-  prev = NULL;
-  for (element = list_head(&htable->table[bucket]); element != NULL; element = list_next(element)) {
-    if (htable->match(*data, list_data(element))) {
-      // Remove the data from the bucket
-      if (list_remove_next(&htable->table[bucket], prev, data) == 0) {
-        htable->size--;
-        return 0;
-      }
-      else {
-        return -1;
-      }
+  hashtable_rehash_step(htable);
+
+  hash = htable->hash(*data);
+
+  // Pass back the matching element if there is one
+  if ((link = hashtable_find(htable, *data, hash)) != NULL) {
+    *data = hashtable_data(*link);
+    return 1;
+  }
+
+  // Otherwise create the element and insert it without searching again
+  if ((created = factory(*data)) == NULL)
+    return -1;
+
+  if (hashtable_link(htable, created, hash) != 0) {
+    if (htable->destroy != NULL)
+      htable->destroy(created);
+    return -1;
+  }
+
+  *data = created;
+  return 0;
+}
+
+
+int hashtable_insert_many(HashTable_t *htable, void **data, int n, int *results)
+{
+  uint64_t hashes[HASHTABLE_BATCH_SIZE];
+  int count;
+  int retval;
+  int batch;
+  int i;
+  int j;
+
+  count = 0;
+  for (i = 0; i < n; i += batch) {
+    batch = (n - i < HASHTABLE_BATCH_SIZE) ? n - i : HASHTABLE_BATCH_SIZE;
+    hashtable_prefetch_batch(htable, &data[i], batch, hashes);
+
+    for (j = 0; j < batch; j++) {
+      if ((retval = hashtable_insert_hashed(htable, data[i + j], hashes[j])) == 0)
+        count++;
+      if (results != NULL)
+        results[i + j] = retval;
+    }
+  }
+
+  return count;
+}
+
+
+int hashtable_remove_many(HashTable_t *htable, void **data, int n, int *results)
+{
+  uint64_t hashes[HASHTABLE_BATCH_SIZE];
+  int count;
+  int retval;
+  int batch;
+  int i;
+  int j;
+
+  count = 0;
+  for (i = 0; i < n; i += batch) {
+    batch = (n - i < HASHTABLE_BATCH_SIZE) ? n - i : HASHTABLE_BATCH_SIZE;
+    hashtable_prefetch_batch(htable, &data[i], batch, hashes);
+
+    for (j = 0; j < batch; j++) {
+      if ((retval = hashtable_remove_hashed(htable, &data[i + j], hashes[j])) == 0)
+        count++;
+      if (results != NULL)
+        results[i + j] = retval;
+    }
+  }
+
+  return count;
+}
+
+
+int hashtable_lookup_many(HashTable_t *htable, void **data, int n, int *results)
+{
+  uint64_t hashes[HASHTABLE_BATCH_SIZE];
+  int count;
+  int retval;
+  int batch;
+  int i;
+  int j;
+
+  count = 0;
+  for (i = 0; i < n; i += batch) {
+    batch = (n - i < HASHTABLE_BATCH_SIZE) ? n - i : HASHTABLE_BATCH_SIZE;
+    hashtable_prefetch_batch(htable, &data[i], batch, hashes);
+
+    for (j = 0; j < batch; j++) {
+      if ((retval = hashtable_lookup_hashed(htable, &data[i + j], hashes[j])) == 0)
+        count++;
+      if (results != NULL)
+        results[i + j] = retval;
+    }
+  }
+
+  return count;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+/**
+Function to calculate the bucket for _hash_ in a table with _buckets_ buckets
+*/
+static int hashtable_bucket(uint64_t hash, int buckets)
+{
+  return (int)(hash % (uint64_t)buckets);
+}
+
+
+/**
+Function to get the bucket new elements with the given hash are inserted into
+
+New elements go into the new table while rehashing.
+*/
+static HashTable_Element_t **hashtable_home(HashTable_t *htable, uint64_t hash)
+{
+  if (hashtable_is_rehashing(htable))
+    return &htable->rehash_table[hashtable_bucket(hash, htable->rehash_buckets)];
+  else
+    return &htable->table[hashtable_bucket(hash, htable->buckets)];
+}
+
+
+/**
+Function to search both tables for an element matching _data_
+
+The user _match_ function is only called for elements whose cached hash equals
+_hash_.
+
+@returns the link (bucket head or _next_ field) pointing at the matching 
+element, otherwise NULL
+*/
+static HashTable_Element_t **hashtable_find(HashTable_t *htable, const void *data, uint64_t hash)
+{
+  HashTable_Element_t **link;
+  int pass;
+
+  for (pass = 0; pass < 2; pass++) {
+    if (pass == 0)
+      link = &htable->table[hashtable_bucket(hash, htable->buckets)];
+    else if (hashtable_is_rehashing(htable))
+      link = &htable->rehash_table[hashtable_bucket(hash, htable->rehash_buckets)];
+    else
+      break;
+
+    // Search for the data in the bucket
+    for (; *link != NULL; link = &(*link)->next) {
+      if ((*link)->hash == hash && htable->match(data, hashtable_data(*link)))
+        return link;
     }
-    prev = element;
   }
 
   // Return that the data was not found
-  return -1;
+  return NULL;
 }
 
 
-int hashtable_lookup(HashTable_t *htable, void **data)
+/**
+Function to add a new element to the bucket for _hash_
+
+@returns 0 if successful, otherwise -1
+*/
+static int hashtable_link(HashTable_t *htable, const void *data, uint64_t hash)
+{
+  HashTable_Element_t **head;
+  HashTable_Element_t *new_element;
+
+  // Allocate storage for the element
+  if ((new_element = (HashTable_Element_t *)allocator_alloc(htable->allocator, sizeof (HashTable_Element_t))) == NULL)
+    return -1;
+
+  // Insert the element at the head of its bucket
+  head = hashtable_home(htable, hash);
+
+  new_element->data = (void *)data;
+  new_element->hash = hash;
+  new_element->next = *head;
+  *head = new_element;
+
+  htable->size++;
+  hashtable_check_load(htable);
+
+  return 0;
+}
+
+
+/**
+Function to free every chain of _table_ and then the table itself
+*/
+static void hashtable_destroy_chains(HashTable_t *htable, HashTable_Element_t **table, int buckets)
+{
+  HashTable_Element_t *element;
+  HashTable_Element_t *next;
+  int i;
+
+  // Nothing to release per element if the allocator releases memory in bulk
+  if (htable->destroy != NULL || !allocator_is_bulk(htable->allocator)) {
+    for (i = 0; i < buckets; i++) {
+      for (element = table[i]; element != NULL; element = next) {
+        next = element->next;
+
+        if (htable->destroy != NULL)
+          htable->destroy(element->data);
+
+        allocator_free(htable->allocator, element);
+      }
+    }
+  }
+
+  free(table);
+}
+
+
+/**
+Function to insert _data_ whose hash has already been computed
+*/
+static int hashtable_insert_hashed(HashTable_t *htable, const void *data, uint64_t hash)
+{
+  hashtable_rehash_step(htable);
+
+  // Do nothing if the data is already in the table
+  if (hashtable_find(htable, data, hash) != NULL)
+    return 1;
+
+  // Insert the data into the bucket
+  return hashtable_link(htable, data, hash);
+}
+
+
+/**
+Function to remove _data_ whose hash has already been computed
+*/
+static int hashtable_remove_hashed(HashTable_t *htable, void **data, uint64_t hash)
+{
+  HashTable_Element_t **link;
+  HashTable_Element_t *old_element;
+
+  hashtable_rehash_step(htable);
+
+  // Search for the data
+  if ((link = hashtable_find(htable, *data, hash)) == NULL)
+    return -1;
+
+  // Unlink the element from its bucket
+  old_element = *link;
+  *link = old_element->next;
+
+  *data = old_element->data;
+  allocator_free(htable->allocator, old_element);
+
+  htable->size--;
+  hashtable_check_load(htable);
+
+  return 0;
+}
+
+
+/**
+Function to look up _data_ whose hash has already been computed
+*/
+static int hashtable_lookup_hashed(HashTable_t *htable, void **data, uint64_t hash)
+{
+  HashTable_Element_t **link;
+
+  hashtable_rehash_step(htable);
+
+  // Search for the data
+  if ((link = hashtable_find(htable, *data, hash)) == NULL)
+    return -1;
+
+  // Pass back the data from the table
+  *data = hashtable_data(*link);
+  return 0;
+}
+
+
+/**
+Function to hash a batch of keys and prefetch the memory needed to resolve them
+
+The bucket heads for the whole batch are requested first, then the first
+element of each bucket, so the misses of each stage overlap one another.
+*/
+static void hashtable_prefetch_batch(HashTable_t *htable, void **data, int n, uint64_t *hashes)
 {
-  List_Element_t *element;
+  HashTable_Element_t **heads[HASHTABLE_BATCH_SIZE];
   int bucket;
+  int i;
+
+  // Hash the batch and prefetch the bucket heads
+  for (i = 0; i < n; i++) {
+    hashes[i] = htable->hash(data[i]);
+
+    // Buckets already migrated by a resize only exist in the new table
+    bucket = hashtable_bucket(hashes[i], htable->buckets);
+    if (hashtable_is_rehashing(htable) && bucket < htable->rehash_index)
+      heads[i] = &htable->rehash_table[hashtable_bucket(hashes[i], htable->rehash_buckets)];
+    else
+      heads[i] = &htable->table[bucket];
+
+    hashtable_prefetch(heads[i]);
+  }
+
+  // Prefetch the first element of each bucket
+  for (i = 0; i < n; i++) {
+    if (*heads[i] != NULL)
+      hashtable_prefetch(*heads[i]);
+  }
+}
+
+
+/**
+Function to begin migrating the hash table into a table with _buckets_ buckets
+
+@returns 0 if the new table was allocated, otherwise -1
+*/
+static int hashtable_resize(HashTable_t *htable, int buckets)
+{
+  if ((htable->rehash_table = (HashTable_Element_t **)calloc(buckets, sizeof (HashTable_Element_t *))) == NULL)
+    return -1;
+
+  htable->rehash_buckets = buckets;
+  htable->rehash_index = 0;
 
-  // Calculate the hash
-  bucket = htable->hash(*data) % htable->buckets;
+  return 0;
+}
+
+
+/**
+Function to migrate a few buckets into the new table during a resize
+*/
+static void hashtable_rehash_step(HashTable_t *htable)
+{
+  HashTable_Element_t *element;
+  HashTable_Element_t **dst;
+  int moved;
+  int empty_visits;
+
+  if (!hashtable_is_rehashing(htable))
+    return;
 
-  // Search for the data in the bucket
-  for (element = list_head(&htable->table[bucket]); element != NULL; element = list_next(element)) {
-    if (htable->match(*data, list_data(element))) {
-      // Pass back the data from the table
-      *data = list_data(element);
-      return 0;
+  moved = 0;
+  empty_visits = HASHTABLE_REHASH_STEP * 10;
+
+  while (moved < HASHTABLE_REHASH_STEP && htable->rehash_index < htable->buckets) {
+    if ((element = htable->table[htable->rehash_index]) == NULL) {
+      htable->rehash_index++;
+      if (--empty_visits == 0)
+        break;
+      continue;
     }
+
+    // Relink each element into its new bucket using the cached hash
+    while (element != NULL) {
+      htable->table[htable->rehash_index] = element->next;
+
+      dst = &htable->rehash_table[hashtable_bucket(element->hash, htable->rehash_buckets)];
+      element->next = *dst;
+      *dst = element;
+
+      element = htable->table[htable->rehash_index];
+    }
+
+    htable->rehash_index++;
+    moved++;
   }
 
-  // Return that the data was not found
-  return -1;
+  // Swap in the new table once the old one has been drained
+  if (htable->rehash_index == htable->buckets) {
+    free(htable->table);
+
+    htable->table = htable->rehash_table;
+    htable->buckets = htable->rehash_buckets;
+
+    htable->rehash_table = NULL;
+    htable->rehash_buckets = 0;
+    htable->rehash_index = -1;
+  }
+}
+
+
+/**
+Function to start a resize if the load factor crossed a configured threshold
+*/
+static void hashtable_check_load(HashTable_t *htable)
+{
+  int buckets;
+
+  if (htable->grow_load <= 0 || hashtable_is_rehashing(htable))
+    return;
+
+  if (htable->size > htable->grow_load * htable->buckets) {
+    // A failed allocation simply leaves the table at its current size
+    hashtable_resize(htable, htable->buckets * 2);
+  }
+  else if (htable->size < htable->shrink_load * htable->buckets &&
+           htable->buckets > htable->min_buckets) {
+    buckets = htable->buckets / 2;
+    if (buckets < htable->min_buckets)
+      buckets = htable->min_buckets;
+
+    hashtable_resize(htable, buckets);
+  }
 }
@@ -16,23 +16,72 @@ extern "C"
 {
 #endif
 
+#include <stdint.h>
 #include <stdlib.h>
 
-#include "list.h"
+#include "alloc.h"
 
 // -----------------------------------------------------------------------------
 // Definitions
 // -----------------------------------------------------------------------------
 
+/**
+The maximum number of non-empty buckets migrated by each operation while the
+hash table is rehashing. Each operation also visits at most ten times as many
+empty buckets, so the extra work done by a single call stays bounded.
+*/
+#ifndef HASHTABLE_REHASH_STEP
+#define HASHTABLE_REHASH_STEP 1
+#endif
+
+/**
+The number of keys the batch operations hash and prefetch before resolving
+them. Large enough to keep many cache misses in flight, small enough that the
+prefetched lines are still in cache when they are used.
+*/
+#ifndef HASHTABLE_BATCH_SIZE
+#define HASHTABLE_BATCH_SIZE 16
+#endif
+
+/**
+@struct HashTable_Element_t
+Element in one of the chains of a hash table
+
+The hash of the data is computed once on insertion and kept with the element,
+so searching a chain only calls the user _match_ function when the full 64-bit
+hashes agree, and resizing never needs to call the user _hash_ function.
+*/
+typedef struct HashTable_Element_T {
+  void *data;                       ///< Pointer to data
+  uint64_t hash;                    ///< Cached hash of the data
+
+  struct HashTable_Element_T *next; ///< Pointer to next element in the chain
+
+} HashTable_Element_t;
+
+/**
+@struct HashTable_t
+Generic chained hash table
+*/
 typedef struct HashTable_T {
   int buckets; ///< The number of buckets in the hash table
 
-  int (*hash)(const void *key);
+  uint64_t (*hash)(const void *key);
   int (*match)(const void *a, const void *b);
   void (*destroy)(void *data);
 
+  const Allocator_t *allocator; ///< Allocator for elements (NULL for malloc)
+
   int size;       ///< The number of elements in the hash table
-  List_t *table;  ///< The hash table itself is a pointer to array of linked-lists
+  HashTable_Element_t **table; ///< Array of chains, one per bucket
+
+  double grow_load;   ///< Load factor above which the table doubles (0 = fixed)
+  double shrink_load; ///< Load factor below which the table halves (0 = never)
+  int min_buckets;    ///< The table never shrinks below this number of buckets
+
+  int rehash_index;     ///< Next bucket of _table_ to migrate (-1 if not rehashing)
+  int rehash_buckets;   ///< The number of buckets in _rehash_table_
+  HashTable_Element_t **rehash_table; ///< The table being migrated into while rehashing
 
 } HashTable_t;
 
@@ -47,11 +96,15 @@ Function to initialize a chained hash table
 Must be called before hash table can be used by any other operation
 
 The number of buckets allocated in the hash table is specified by _buckets_. The
-function pointer _hash_ specifies a user-defined hash function. The function
+function pointer _hash_ specifies a user-defined hash function returning a 64-bit
+hash (the bucket is the hash modulo the number of buckets). The function
 pointer _match_ specifies a user-defined to determine whether two keys match.
 The _destroy_ argument provides a way to free dynamically allocated data when
 *hashtable_destroy* is called. 
 
+The hash table is initialized with a fixed number of buckets. Automatic resizing
+can be enabled afterwards with *hashtable_set_load_factor()*.
+
 Complexity: O(m), where *m* is the number of buckets in the hash table
 
 @param [out] *htable  The hash table to init
@@ -63,10 +116,35 @@ Complexity: O(m), where *m* is the number of buckets in the hash table
 @returns 0 if hash table init successful, otherwise -1
 */
 int hashtable_init(HashTable_t *htable, int buckets, 
-                   int (*hash)(const void *key),
+                   uint64_t (*hash)(const void *key),
                    int (*match)(const void *a, const void *b),
                    void (*destroy)(void *data));
 
+/**
+Function to initialize a chained hash table whose elements come from an allocator
+
+Same as *hashtable_init()*, except the elements of the chains are allocated
+from _allocator_ rather than with _malloc_ (the bucket array itself still uses
+_malloc_). The allocator must remain valid until the hash table is destroyed.
+Passing NULL is equivalent to *hashtable_init()*.
+
+Complexity: O(m), where *m* is the number of buckets in the hash table
+
+@param [out] *htable     The hash table to init
+@param [in]   buckets    The number of buckets in the hash table
+@param [in]  *hash       Pointer to user hash function
+@param [in]  *match      Pointer to user hash key comparison function
+@param [in]  *destroy    Pointer to function to free element memory
+@param [in]  *allocator  The allocator to take elements from
+
+@returns 0 if hash table init successful, otherwise -1
+*/
+int hashtable_init_allocator(HashTable_t *htable, int buckets, 
+                             uint64_t (*hash)(const void *key),
+                             int (*match)(const void *a, const void *b),
+                             void (*destroy)(void *data),
+                             const Allocator_t *allocator);
+
 /**
 Function to destroy a chained hash table
 
@@ -74,12 +152,42 @@ The *hashtable_destroy* operation removes all elements from  hash table and
 calls the function passed as _destroy_ to *hashtable_init* once for each element
 as it is removed, provided _destroy_ was not set to NULL.
 
+If _destroy_ is NULL and the elements come from an allocator that releases its
+memory in bulk (see *arena_allocator()*), no element needs to be visited and
+the hash table is destroyed in O(1).
+
 Complexity: O(m), where *m* is the number of buckets in the hash table
 
 @param [in,out] *htable  The hash table to destroy
 */
 void hashtable_destroy(HashTable_t *htable);
 
+/**
+Function to enable automatic resizing of a chained hash table
+
+Once the load factor (elements per bucket) rises above _grow_, the number of
+buckets is doubled. If _shrink_ is non-zero, the number of buckets is halved
+whenever the load factor drops below _shrink_, but never below the number of
+buckets given to *hashtable_init()*.
+
+Resizing is incremental: the new table is allocated up front, and then
+*hashtable_insert()*, *hashtable_remove()* and *hashtable_lookup()* each migrate
+a few buckets (see HASHTABLE_REHASH_STEP) until the old table is empty. This
+way no single operation pays for rehashing the whole table. Elements are
+relinked into their new buckets, so no memory is allocated per element.
+
+Setting _grow_ to 0 restores the default fixed size behavior.
+
+Complexity: O(1)
+
+@param [in,out] *htable  The hash table to configure
+@param [in]      grow    Load factor that triggers growth (0 disables resizing)
+@param [in]      shrink  Load factor that triggers shrinking (0 to never shrink)
+
+@returns 0 if successful, otherwise -1 (_shrink_ must be less than half of _grow_)
+*/
+int hashtable_set_load_factor(HashTable_t *htable, double grow, double shrink);
+
 /**
 Function to insert an element into a chained hash table
 
@@ -117,11 +225,144 @@ Complexity: O(1)
 */
 int hashtable_lookup(HashTable_t *htable, void **data);
 
+/**
+Function to insert an element into a chained hash table, replacing any match
+
+Unlike *hashtable_insert()*, an element already in the table that matches
+_data_ is replaced in place. The key is hashed once and its bucket is searched
+once. Upon return _data_ points to the element that was replaced, which is now
+owned by the caller, or NULL if no element was replaced.
+
+Complexity: O(1)
+
+@param [in,out] *htable  The hash table to insert into
+@param [in,out] **data   The data to insert, upon return the data replaced
+
+@returns 0 if the element was inserted, 1 if it replaced an existing element,
+otherwise -1
+*/
+int hashtable_upsert(HashTable_t *htable, void **data);
+
+/**
+Function to find an element in a chained hash table, creating it if absent
+
+The key is hashed once and its bucket is searched once. If no element matches
+_data_, _factory_ is called with the key to create the element, which is then
+inserted into the bucket that was just searched. This suits the common "update
+if present, otherwise create" pattern such as counting or aggregation. Upon
+return _data_ points to the existing or newly created element.
+
+The element returned by _factory_ must match the key it was created from. If
+it cannot be inserted it is freed with the _destroy_ function (if any).
+
+Complexity: O(1)
+
+@param [in,out] *htable   The hash table to search and insert into
+@param [in,out] **data    The key to find, upon return the matching element
+@param [in]     *factory  Function to create an element for the given key
+
+@returns 1 if the element was found, 0 if it was created, otherwise -1 (which
+includes _factory_ returning NULL)
+*/
+int hashtable_get_or_insert_with(HashTable_t *htable, void **data,
+                                 void *(*factory)(const void *key));
+
+/**
+Function to insert many elements into a chained hash table
+
+Equivalent to calling *hashtable_insert()* for each of the _n_ elements of
+_data_, but the keys are processed in batches of HASHTABLE_BATCH_SIZE: the
+whole batch is hashed first and software prefetches are issued for each bucket
+and its first element before any chain is walked. This lets the cache misses
+for the batch overlap instead of being taken one after another.
+
+Complexity: O(n)
+
+@param [in,out] *htable   The hash table to insert into
+@param [in]     **data    Array of the data to insert
+@param [in]       n       The number of elements in _data_
+@param [out]    *results  Optional array receiving the *hashtable_insert()*
+                          result for each element (may be NULL)
+
+@returns the number of elements inserted
+*/
+int hashtable_insert_many(HashTable_t *htable, void **data, int n, int *results);
+
+/**
+Function to remove many elements from a chained hash table
+
+Equivalent to calling *hashtable_remove()* for each of the _n_ elements of
+_data_, batched and prefetched as described for *hashtable_insert_many()*. Each
+element of _data_ that was removed is replaced with the data removed.
+
+Complexity: O(n)
+
+@param [in,out] *htable   The hash table remove data from
+@param [in,out] **data    Array of keys to remove, upon return the data removed
+@param [in]       n       The number of elements in _data_
+@param [out]    *results  Optional array receiving the *hashtable_remove()*
+                          result for each element (may be NULL)
+
+@returns the number of elements removed
+*/
+int hashtable_remove_many(HashTable_t *htable, void **data, int n, int *results);
+
+/**
+Function to look up many elements in a chained hash table
+
+Equivalent to calling *hashtable_lookup()* for each of the _n_ elements of
+_data_, batched and prefetched as described for *hashtable_insert_many()*. Each
+element of _data_ that was found is replaced with the matching data.
+
+Complexity: O(n)
+
+@param [in,out] *htable   The hash table to lookup
+@param [in,out] **data    Array of keys to find, upon return the matching data
+@param [in]       n       The number of elements in _data_
+@param [out]    *results  Optional array receiving the *hashtable_lookup()*
+                          result for each element (may be NULL)
+
+@returns the number of elements found
+*/
+int hashtable_lookup_many(HashTable_t *htable, void **data, int n, int *results);
+
 /**
 MACRO that evaluates to the number of elements in the hash table
 */
 #define hashtable_size(htable) ((htable)->size)
 
+/**
+MACRO that evaluates to the number of buckets in the hash table
+
+While the table is rehashing this is the size of the table being migrated from.
+*/
+#define hashtable_buckets(htable) ((htable)->buckets)
+
+/**
+MACRO that determines whether the hash table is in the middle of a resize
+*/
+#define hashtable_is_rehashing(htable) ((htable)->rehash_index >= 0 ? 1 : 0)
+
+/**
+MACRO that evaluates to the first element in the given bucket of the hash table
+*/
+#define hashtable_head(htable, bucket) ((htable)->table[(bucket)])
+
+/**
+MACRO that evaluates to the data stored in given element of the hash table
+*/
+#define hashtable_data(element) ((element)->data)
+
+/**
+MACRO that evaluates to the cached hash of given element of the hash table
+*/
+#define hashtable_hash(element) ((element)->hash)
+
+/**
+MACRO that evaluates to the next element in the same bucket of the hash table
+*/
+#define hashtable_next(element) ((element)->next)
+
 #ifdef __cplusplus
 }
 #endif
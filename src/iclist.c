@@ -0,0 +1,97 @@
+/**
+@file iclist.c
+
+See header
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "iclist.h"
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void iclist_init(ICList_t *list, void (*destroy)(ICList_Element_t *element))
+{
+  // Initialize the list
+  list->size = 0;
+  list->destroy = destroy;
+  list->head = NULL;
+}
+
+
+void iclist_destroy(ICList_t *list)
+{
+  ICList_Element_t *element;
+
+  // The list owns no memory, so the elements only need visiting to destroy them
+  if (list->destroy != NULL) {
+    while (iclist_size(list) > 0) {
+      if (iclist_remove_next(list, iclist_head(list), &element) == 0)
+        list->destroy(element);
+    }
+  }
+
+  // No operations permitted at this point -- clear memory as precaution
+  memset(list, 0, sizeof (ICList_t));
+}
+
+
+int iclist_insert_next(ICList_t *list, ICList_Element_t *element, ICList_Element_t *new_element)
+{
+  // Do not allow a NULL element unless the list is empty
+  if ((element == NULL && iclist_size(list) != 0) || new_element == NULL)
+    return -1;
+
+  if (iclist_size(list) == 0) {
+    // Insert into empty list
+
+    new_element->next = new_element;
+    list->head = new_element;
+  }
+  else {
+    // Insert into a non-empty list
+
+    new_element->next = element->next;
+    element->next = new_element;
+  }
+
+  // Adjust the size
+  list->size++;
+
+  return 0;
+}
+
+
+int iclist_remove_next(ICList_t *list, ICList_Element_t *element, ICList_Element_t **old_element)
+{
+  // Check for empty list!
+  if (iclist_size(list) == 0 || element == NULL)
+    return -1;
+
+  *old_element = element->next;
+
+  if (element->next == element) {
+    // Remove the last element
+
+    list->head = NULL;
+  }
+  else {
+    // Remove an element other than the last element
+
+    element->next = element->next->next;
+    if (*old_element == iclist_head(list))
+      list->head = (*old_element)->next;
+  }
+
+  (*old_element)->next = NULL;
+
+  // Adjust the size of the list
+  list->size--;
+
+  return 0;
+}
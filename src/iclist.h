@@ -0,0 +1,146 @@
+/** 
+@file iclist.h
+@brief 
+Definitions of an intrusive circular linked-list ADT
+
+Unlike CList_t, the list does not allocate an element holding a pointer to the
+data. Instead the user's struct embeds an ICList_Element_t, and the list links
+those embedded elements into a ring. Inserting and removing are pure pointer
+updates that cannot fail for lack of memory. The struct holding an element is
+recovered with *iclist_entry()*.
+
+An element can be in at most one list through a given member at a time. Its
+memory must stay valid for as long as it remains in the list.
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#ifndef ICLIST_h
+#define ICLIST_h
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include <stdlib.h>
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+/**
+@struct ICList_Element_t
+Intrusive circular linked-list element, embedded in the user's struct
+*/
+typedef struct ICList_Element_T {
+  struct ICList_Element_T *next; ///< Pointer to next element in list
+
+} ICList_Element_t;
+
+/**
+@struct ICList_t
+Intrusive circular linked-list
+*/
+typedef struct ICList_T {
+  int size; ///< Number of elements in list
+
+  void (*destroy)(ICList_Element_t *element);
+
+  ICList_Element_t *head; ///< Pointer to first element in list
+
+} ICList_t;
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/**
+Function to initialize an intrusive circular linked-list
+
+@pre
+Must be called before list can be used by any other operation
+
+The _destroy_ argument is called by *iclist_destroy* with each element still in
+the list, and would typically recover the struct with *iclist_entry()* and free
+it. For a list whose elements should not be freed, _destroy_ should be set to
+NULL.
+
+Complexity: O(1)
+
+@param [out] *list     The circular linked-list to init
+@param [in] (*destroy) Function pointer to free the struct holding an element
+*/
+void iclist_init(ICList_t *list, void (*destroy)(ICList_Element_t *element));
+
+/**
+Function to destroy an intrusive circular linked-list
+
+Removes all elements from the circular linked-list, calling the function passed
+as _destroy_ to *iclist_init* once for each element, provided _destroy_ was not
+set to NULL.
+
+Complexity: O(n) (O(1) if _destroy_ is NULL)
+
+@param [in,out] *list  The circular linked-list to destroy
+*/
+void iclist_destroy(ICList_t *list);
+
+/**
+Function to insert an element into an intrusive circular linked-list
+
+Links _new_element_ just after _element_. When inserting into an empty list,
+_element_ is ignored and _new_element_ becomes the head.
+
+Complexity: O(1)
+
+@param [in,out] *list         The circular linked-list to insert element into
+@param [in]     *element      Pointer to element to insert after
+@param [in]     *new_element  The element to insert
+
+@return 0 if inserting into list was successful, otherwise -1
+*/
+int iclist_insert_next(ICList_t *list, ICList_Element_t *element, ICList_Element_t *new_element);
+
+/**
+Function to remove an element from an intrusive circular linked-list
+
+Unlinks the element just past _element_. Upon return _old_element_ points to
+the element that was removed, which now belongs to the caller again.
+
+Complexity: O(1)
+
+@param [in,out] *list          The circular linked-list to remove element from
+@param [in]     *element       Pointer to element to remove after
+@param [out]    **old_element  The element removed
+
+@return 0 if removing from list was successful, otherwise -1
+*/
+int iclist_remove_next(ICList_t *list, ICList_Element_t *element, ICList_Element_t **old_element);
+
+/**
+MACRO that evaluates to the number of elements in the circular linked-list
+*/
+#define iclist_size(list) ((list)->size)
+
+/**
+MACRO that evaluates to the element at the head of a circular linked-list
+*/
+#define iclist_head(list) ((list)->head)
+
+/**
+MACRO that evaluates to the next element given an element in a circular 
+linked-list
+*/
+#define iclist_next(element) ((element)->next)
+
+/**
+MACRO that evaluates to the struct of _type_ whose _member_ is _element_
+*/
+#define iclist_entry(element, type, member) \
+  ((type *)((char *)(element) - offsetof(type, member)))
+
+#ifdef __cplusplus
+}
+#endif
+#endif // ICLIST_h
@@ -0,0 +1,150 @@
+/**
+@file idlist.c
+
+See header
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "idlist.h"
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void idlist_init(IDList_t *list, void (*destroy)(IDList_Element_t *element))
+{
+  // Initialize the list
+  list->size = 0;
+  list->destroy = destroy;
+  list->head = NULL;
+  list->tail = NULL;
+}
+
+
+void idlist_destroy(IDList_t *list)
+{
+  IDList_Element_t *element;
+
+  // The list owns no memory, so the elements only need visiting to destroy them
+  if (list->destroy != NULL) {
+    while (idlist_size(list) > 0) {
+      element = idlist_tail(list);
+      if (idlist_remove(list, element) == 0)
+        list->destroy(element);
+    }
+  }
+
+  // No operations permitted at this point -- clear memory as precaution
+  memset(list, 0, sizeof (IDList_t));
+}
+
+
+int idlist_insert_next(IDList_t *list, IDList_Element_t *element, IDList_Element_t *new_element)
+{
+  // Do not allow a NULL element unless the list is empty
+  if ((element == NULL && idlist_size(list) != 0) || new_element == NULL)
+    return -1;
+
+  if (idlist_size(list) == 0) {
+    // Insert into empty list
+
+    list->head = new_element;
+    list->head->prev = NULL;
+    list->head->next = NULL;
+    list->tail = new_element;
+  }
+  else {
+    // Insert into non-empty list
+
+    new_element->next = element->next;
+    new_element->prev = element;
+
+    if (element->next == NULL)
+      list->tail = new_element;
+    else
+      element->next->prev = new_element;
+
+    element->next = new_element;
+  }
+
+  // Adjust the size
+  list->size++;
+
+  return 0;
+}
+
+
+int idlist_insert_prev(IDList_t *list, IDList_Element_t *element, IDList_Element_t *new_element)
+{
+  // Do not allow a NULL element unless the list is empty
+  if ((element == NULL && idlist_size(list) != 0) || new_element == NULL)
+    return -1;
+
+  if (idlist_size(list) == 0) {
+    // Insert into empty list
+
+    list->head = new_element;
+    list->head->prev = NULL;
+    list->head->next = NULL;
+    list->tail = new_element;
+  }
+  else {
+    // Insert into non-empty list
+
+    new_element->next = element;
+    new_element->prev = element->prev;
+
+    if (element->prev == NULL)
+      list->head = new_element;
+    else
+      element->prev->next = new_element;
+
+    element->prev = new_element;
+  }
+
+  // Adjust the size
+  list->size++;
+
+  return 0;
+}
+
+
+int idlist_remove(IDList_t *list, IDList_Element_t *element)
+{
+  // Do not allow a NULL element or removal from empty list
+  if (element == NULL || idlist_size(list) == 0)
+    return -1;
+
+  if (element == list->head) {
+    // Remove from the head of the list
+
+    list->head = element->next;
+
+    if (list->head == NULL)
+      list->tail = NULL;
+    else
+      element->next->prev = NULL;
+  }
+  else {
+    // Remove from somewhere but the head
+
+    element->prev->next = element->next;
+
+    if (element->next == NULL)
+      list->tail = element->prev;
+    else
+      element->next->prev = element->prev;
+  }
+
+  element->prev = NULL;
+  element->next = NULL;
+
+  // Adjust the size of the list
+  list->size--;
+
+  return 0;
+}
@@ -0,0 +1,184 @@
+/** 
+@file idlist.h
+@brief 
+Definitions of an intrusive doubly linked-list ADT
+
+Unlike DList_t, the list does not allocate an element holding a pointer to the
+data. Instead the user's struct embeds an IDList_Element_t, and the list links
+those embedded elements together. Inserting and removing are pure pointer
+updates that cannot fail for lack of memory, and an object that knows it is in
+a list can unlink itself in O(1) without a search. The struct holding an
+element is recovered with *idlist_entry()*.
+
+An element can be in at most one list through a given member at a time. Its
+memory must stay valid for as long as it remains in the list.
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#ifndef IDLIST_h
+#define IDLIST_h
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include <stdlib.h>
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+/**
+@struct IDList_Element_t
+Intrusive doubly linked-list element, embedded in the user's struct
+*/
+typedef struct IDList_Element_T {
+  struct IDList_Element_T *prev; ///< Pointer to previous element in list
+  struct IDList_Element_T *next; ///< Pointer to next element in list
+
+} IDList_Element_t;
+
+/**
+@struct IDList_t
+Intrusive doubly linked-list
+*/
+typedef struct IDList_T {
+  int size; ///< Number of elements in list
+
+  void (*destroy)(IDList_Element_t *element);
+
+  IDList_Element_t *head; ///< Pointer to first element in list
+  IDList_Element_t *tail; ///< Pointer to last element in list
+
+} IDList_t;
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/**
+Function to initialize an intrusive doubly linked-list
+
+@pre
+Must be called before list can be used by any other operation
+
+The _destroy_ argument is called by *idlist_destroy* with each element still in
+the list, and would typically recover the struct with *idlist_entry()* and free
+it. For a list whose elements should not be freed, _destroy_ should be set to
+NULL.
+
+Complexity: O(1)
+
+@param [out] *list     The doubly linked-list to init
+@param [in] (*destroy) Function pointer to free the struct holding an element
+*/
+void idlist_init(IDList_t *list, void (*destroy)(IDList_Element_t *element));
+
+/**
+Function to destroy an intrusive doubly linked-list
+
+Removes all elements from the doubly linked-list, calling the function passed
+as _destroy_ to *idlist_init* once for each element, provided _destroy_ was not
+set to NULL.
+
+Complexity: O(n) (O(1) if _destroy_ is NULL)
+
+@param [in,out] *list  The doubly linked-list to destroy
+*/
+void idlist_destroy(IDList_t *list);
+
+/**
+Function to insert an element into an intrusive doubly linked-list
+
+Links _new_element_ just after _element_. When inserting into an empty list,
+_element_ should point to NULL.
+
+Complexity: O(1)
+
+@param [in,out] *list         The doubly linked-list to insert element into
+@param [in]     *element      Pointer to element to insert after
+@param [in]     *new_element  The element to insert
+
+@return 0 if inserting into list was successful, otherwise -1
+*/
+int idlist_insert_next(IDList_t *list, IDList_Element_t *element, IDList_Element_t *new_element);
+
+/**
+Function to insert an element into an intrusive doubly linked-list
+
+Links _new_element_ just before _element_. When inserting into an empty list,
+_element_ should point to NULL.
+
+Complexity: O(1)
+
+@param [in,out] *list         The doubly linked-list to insert element into
+@param [in]     *element      Pointer to element to insert before
+@param [in]     *new_element  The element to insert
+
+@return 0 if inserting into list was successful, otherwise -1
+*/
+int idlist_insert_prev(IDList_t *list, IDList_Element_t *element, IDList_Element_t *new_element);
+
+/**
+Function to remove an element from an intrusive doubly linked-list
+
+Unlinks _element_, which now belongs to the caller again.
+
+Complexity: O(1)
+
+@param [in,out] *list     The doubly linked-list to remove element from
+@param [in]     *element  Pointer to element to remove
+
+@return 0 if removing from list was successful, otherwise -1
+*/
+int idlist_remove(IDList_t *list, IDList_Element_t *element);
+
+/**
+MACRO that evaluates to the number of elements in the doubly linked-list
+*/
+#define idlist_size(list) ((list)->size)
+
+/**
+MACRO that evaluates to the element at the head of a doubly linked-list
+*/
+#define idlist_head(list) ((list)->head)
+
+/**
+MACRO that evaluates to the element at the tail of a doubly linked-list
+*/
+#define idlist_tail(list) ((list)->tail)
+
+/**
+MACRO that determines whether element is the head of doubly linked-list
+*/
+#define idlist_is_head(element) ((element)->prev == NULL ? 1 : 0)
+
+/**
+MACRO that determines whether element is the tail of doubly linked-list
+*/
+#define idlist_is_tail(element) ((element)->next == NULL ? 1 : 0)
+
+/**
+MACRO that evaluates to the next element given an element in a doubly 
+linked-list
+*/
+#define idlist_next(element) ((element)->next)
+
+/**
+MACRO that evaluates to the previous element given an element in a doubly 
+linked-list
+*/
+#define idlist_prev(element) ((element)->prev)
+
+/**
+MACRO that evaluates to the struct of _type_ whose _member_ is _element_
+*/
+#define idlist_entry(element, type, member) \
+  ((type *)((char *)(element) - offsetof(type, member)))
+
+#ifdef __cplusplus
+}
+#endif
+#endif // IDLIST_h
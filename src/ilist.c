@@ -0,0 +1,111 @@
+/**
+@file ilist.c
+
+See header
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "ilist.h"
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void ilist_init(IList_t *list, void (*destroy)(IList_Element_t *element))
+{
+  // Initialize the list
+  list->size = 0;
+  list->destroy = destroy;
+  list->head = NULL;
+  list->tail = NULL;
+}
+
+
+void ilist_destroy(IList_t *list)
+{
+  IList_Element_t *element;
+
+  // The list owns no memory, so the elements only need visiting to destroy them
+  if (list->destroy != NULL) {
+    while (ilist_size(list) > 0) {
+      if (ilist_remove_next(list, NULL, &element) == 0)
+        list->destroy(element);
+    }
+  }
+
+  // No operations permitted at this point -- clear memory as precaution
+  memset(list, 0, sizeof (IList_t));
+}
+
+
+int ilist_insert_next(IList_t *list, IList_Element_t *element, IList_Element_t *new_element)
+{
+  // Do not allow a NULL element to insert
+  if (new_element == NULL)
+    return -1;
+
+  if (element == NULL) {
+    // Insert at the head of the list
+
+    if (ilist_size(list) == 0)
+      list->tail = new_element;
+
+    new_element->next = list->head;
+    list->head = new_element;
+  }
+  else {
+    // Insert somewhere other than at the head
+
+    if (element->next == NULL)
+      list->tail = new_element;
+
+    new_element->next = element->next;
+    element->next = new_element;
+  }
+
+  // Adjust the size
+  list->size++;
+
+  return 0;
+}
+
+
+int ilist_remove_next(IList_t *list, IList_Element_t *element, IList_Element_t **old_element)
+{
+  // Check for empty list!
+  if (ilist_size(list) == 0)
+    return -1;
+
+  if (element == NULL) {
+    // Remove from the head of the linked-list
+
+    *old_element = list->head;
+    list->head = list->head->next;
+
+    if (ilist_size(list) == 1)
+      list->tail = NULL;
+  }
+  else {
+    // Remove from somewhere other than the head
+
+    if (element->next == NULL)
+      return -1;
+
+    *old_element = element->next;
+    element->next = element->next->next;
+
+    if (element->next == NULL)
+      list->tail = element;
+  }
+
+  (*old_element)->next = NULL;
+
+  // Adjust the size of the list
+  list->size--;
+
+  return 0;
+}
@@ -0,0 +1,163 @@
+/** 
+@file ilist.h
+@brief 
+Definitions of an intrusive linked-list ADT
+
+Unlike List_t, the list does not allocate an element holding a pointer to the
+data. Instead the user's struct embeds an IList_Element_t, and the list links
+those embedded elements together. Inserting and removing are pure pointer
+updates that cannot fail for lack of memory, and walking the list touches one
+cache line per element rather than the element and then its data. The struct
+holding an element is recovered with *ilist_entry()*.
+
+An element can be in at most one list through a given member at a time. Its
+memory must stay valid for as long as it remains in the list.
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#ifndef ILIST_h
+#define ILIST_h
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include <stdlib.h>
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+/**
+@struct IList_Element_t
+Intrusive linked-list element, embedded in the user's struct
+*/
+typedef struct IList_Element_T {
+  struct IList_Element_T *next; ///< Pointer to next element in list
+
+} IList_Element_t;
+
+/**
+@struct IList_t
+Intrusive linked-list
+*/
+typedef struct IList_T {
+  int size; ///< Number of elements in list
+
+  void (*destroy)(IList_Element_t *element);
+
+  IList_Element_t *head; ///< Pointer to first element in list
+  IList_Element_t *tail; ///< Pointer to last element in list
+
+} IList_t;
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/**
+Function to initialize an intrusive linked-list
+
+@pre
+Must be called before list can be used by any other operation
+
+The _destroy_ argument is called by *ilist_destroy* with each element still in
+the list, and would typically recover the struct with *ilist_entry()* and free
+it. For a list whose elements should not be freed, _destroy_ should be set to
+NULL.
+
+Complexity: O(1)
+
+@param [out] *list     The linked-list to init
+@param [in] (*destroy) Function pointer to free the struct holding an element
+*/
+void ilist_init(IList_t *list, void (*destroy)(IList_Element_t *element));
+
+/**
+Function to destroy an intrusive linked-list
+
+Removes all elements from the linked-list, calling the function passed as
+_destroy_ to *ilist_init* once for each element, provided _destroy_ was not set
+to NULL.
+
+Complexity: O(n) (O(1) if _destroy_ is NULL)
+
+@param [in,out] *list  The linked-list to destroy
+*/
+void ilist_destroy(IList_t *list);
+
+/**
+Function to insert an element into an intrusive linked-list
+
+Links _new_element_ just after _element_. If _element_ is NULL, the new element
+is inserted at the head of the list.
+
+Complexity: O(1)
+
+@param [in,out] *list         The linked-list to insert element into
+@param [in]     *element      Pointer to element to insert after
+@param [in]     *new_element  The element to insert
+
+@return 0 if inserting into list was successful, otherwise -1
+*/
+int ilist_insert_next(IList_t *list, IList_Element_t *element, IList_Element_t *new_element);
+
+/**
+Function to remove an element from an intrusive linked-list
+
+Unlinks the element just past _element_. If _element_ is NULL, the element at
+the head of the list is removed. Upon return _old_element_ points to the
+element that was removed, which now belongs to the caller again.
+
+Complexity: O(1)
+
+@param [in,out] *list          The linked-list to remove element from
+@param [in]     *element       Pointer to element to remove after
+@param [out]    **old_element  The element removed
+
+@return 0 if removing from list was successful, otherwise -1
+*/
+int ilist_remove_next(IList_t *list, IList_Element_t *element, IList_Element_t **old_element);
+
+/**
+MACRO that evaluates to the number of elements in the linked-list
+*/
+#define ilist_size(list) ((list)->size)
+
+/**
+MACRO that evaluates to the element at the head of a linked-list
+*/
+#define ilist_head(list) ((list)->head)
+
+/**
+MACRO that evaluates to the element at the tail of a linked-list
+*/
+#define ilist_tail(list) ((list)->tail)
+
+/**
+MACRO that determines whether element is the head of linked-list
+*/
+#define ilist_is_head(list, element) ((element) == (list)->head ? 1 : 0)
+
+/**
+MACRO that determines whether element is the tail of linked-list
+*/
+#define ilist_is_tail(element) ((element)->next == NULL ? 1 : 0)
+
+/**
+MACRO that evaluates to the next element given an element in a linked-list
+*/
+#define ilist_next(element) ((element)->next)
+
+/**
+MACRO that evaluates to the struct of _type_ whose _member_ is _element_
+*/
+#define ilist_entry(element, type, member) \
+  ((type *)((char *)(element) - offsetof(type, member)))
+
+#ifdef __cplusplus
+}
+#endif
+#endif // ILIST_h
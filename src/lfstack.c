@@ -0,0 +1,324 @@
+/**
+@file lfstack.c
+
+See header
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "lfstack.h"
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+#define LFSTACK_EMPTY 0
+#define LFSTACK_TAKEN UINT32_MAX
+
+#define LFSTACK_INDEX(head) ((uint32_t)(head))
+#define LFSTACK_TAG(head)   ((uint32_t)((head) >> 32))
+#define LFSTACK_PACK(tag, index) (((uint64_t)(tag) << 32) | (index))
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LFSTACK_PAUSE() __builtin_ia32_pause()
+#else
+#define LFSTACK_PAUSE()
+#endif
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static int lfstack_try_push(LFStack_t *stack, _Atomic(uint64_t) *head, uint32_t index);
+static int lfstack_try_pop(LFStack_t *stack, _Atomic(uint64_t) *head, uint32_t *index);
+static uint32_t lfstack_take_free(LFStack_t *stack);
+static void lfstack_give_free(LFStack_t *stack, uint32_t index);
+static int lfstack_offer(LFStack_t *stack, uint32_t index);
+static uint32_t lfstack_claim(LFStack_t *stack);
+static _Atomic(uint32_t) *lfstack_random_slot(LFStack_t *stack);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+int lfstack_init(LFStack_t *stack, int capacity, void (*destroy)(void *data))
+{
+  int i;
+
+  if (capacity <= 0 || (uint32_t)capacity >= LFSTACK_TAKEN)
+    return -1;
+
+  stack->elements = (LFStack_Element_t *)malloc(capacity * sizeof (LFStack_Element_t));
+  if (stack->elements == NULL)
+    return -1;
+
+  // Chain every element onto the free stack
+  for (i = 0; i < capacity; i++) {
+    stack->elements[i].data = NULL;
+    atomic_init(&stack->elements[i].next, i + 1 < capacity ? i + 2 : 0);
+  }
+
+  for (i = 0; i < LFSTACK_ELIMINATION_SIZE; i++)
+    atomic_init(&stack->elimination[i].value, LFSTACK_EMPTY);
+
+  atomic_init(&stack->head, LFSTACK_PACK(0, 0));
+  atomic_init(&stack->free, LFSTACK_PACK(0, 1));
+
+  stack->capacity = capacity;
+  stack->destroy = destroy;
+
+  return 0;
+}
+
+
+void lfstack_destroy(LFStack_t *stack)
+{
+  uint32_t index;
+
+  // Destroy each element still in the stack
+  if (stack->destroy != NULL) {
+    index = LFSTACK_INDEX(atomic_load(&stack->head));
+
+    while (index != 0) {
+      stack->destroy(stack->elements[index - 1].data);
+      index = atomic_load(&stack->elements[index - 1].next);
+    }
+  }
+
+  free(stack->elements);
+
+  // No operations permitted at this point -- clear memory as precaution
+  memset(stack, 0, sizeof (LFStack_t));
+}
+
+
+int lfstack_push(LFStack_t *stack, const void *data)
+{
+  uint32_t index;
+
+  if ((index = lfstack_take_free(stack)) == 0)
+    return -1;
+
+  stack->elements[index - 1].data = (void *)data;
+
+  // Alternate between the head and the elimination array until one works
+  while (!lfstack_try_push(stack, &stack->head, index)) {
+    if (lfstack_offer(stack, index))
+      break;
+  }
+
+  return 0;
+}
+
+
+int lfstack_pop(LFStack_t *stack, void **data)
+{
+  uint32_t index;
+  int retval;
+
+  // Alternate between the head and the elimination array until one works
+  while ((retval = lfstack_try_pop(stack, &stack->head, &index)) < 0) {
+    if ((index = lfstack_claim(stack)) != 0)
+      break;
+  }
+
+  if (retval == 0)
+    return -1;
+
+  *data = stack->elements[index - 1].data;
+
+  lfstack_give_free(stack, index);
+
+  return 0;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+/**
+Make one attempt to push an element onto a tagged stack
+
+@param [in,out] *stack  The stack owning the elements
+@param [in,out] *head   The tagged head to push onto
+@param [in]      index  Index + 1 of the element
+
+@return nonzero if the element was pushed, 0 if the CAS lost a race
+*/
+static int lfstack_try_push(LFStack_t *stack, _Atomic(uint64_t) *head, uint32_t index)
+{
+  uint64_t old_head;
+
+  old_head = atomic_load_explicit(head, memory_order_relaxed);
+  atomic_store_explicit(&stack->elements[index - 1].next, LFSTACK_INDEX(old_head), 
+    memory_order_relaxed);
+
+  return atomic_compare_exchange_weak_explicit(head, &old_head, 
+    LFSTACK_PACK(LFSTACK_TAG(old_head) + 1, index), 
+    memory_order_release, memory_order_relaxed);
+}
+
+
+/**
+Make one attempt to pop an element off a tagged stack
+
+The element below the top is read before the CAS, so it may be stale if the
+top was popped and pushed back meanwhile, but then the tag has changed too
+and the CAS fails.
+
+@param [in,out] *stack  The stack owning the elements
+@param [in,out] *head   The tagged head to pop from
+@param [out]    *index  Index + 1 of the popped element
+
+@return 1 if an element was popped, 0 if the stack is empty, -1 if the CAS lost
+a race
+*/
+static int lfstack_try_pop(LFStack_t *stack, _Atomic(uint64_t) *head, uint32_t *index)
+{
+  uint64_t old_head;
+  uint32_t next;
+
+  old_head = atomic_load_explicit(head, memory_order_acquire);
+  if ((*index = LFSTACK_INDEX(old_head)) == 0)
+    return 0;
+
+  next = atomic_load_explicit(&stack->elements[*index - 1].next, memory_order_relaxed);
+
+  if (atomic_compare_exchange_weak_explicit(head, &old_head, 
+      LFSTACK_PACK(LFSTACK_TAG(old_head) + 1, next), 
+      memory_order_acquire, memory_order_relaxed))
+    return 1;
+
+  return -1;
+}
+
+
+/**
+Take an element off the free stack
+
+@param [in,out] *stack  The stack
+
+@return index + 1 of the element, or 0 if every element is in use
+*/
+static uint32_t lfstack_take_free(LFStack_t *stack)
+{
+  uint32_t index;
+  int retval;
+
+  while ((retval = lfstack_try_pop(stack, &stack->free, &index)) < 0)
+    ;
+
+  return retval ? index : 0;
+}
+
+
+/**
+Return an element to the free stack
+
+@param [in,out] *stack  The stack
+@param [in]      index  Index + 1 of the element
+*/
+static void lfstack_give_free(LFStack_t *stack, uint32_t index)
+{
+  while (!lfstack_try_push(stack, &stack->free, index))
+    ;
+}
+
+
+/**
+Offer an element in the elimination array for a concurrent pop to take
+
+@param [in,out] *stack  The stack
+@param [in]      index  Index + 1 of the element being pushed
+
+@return nonzero if a pop took the element, 0 if the push must retry on the head
+*/
+static int lfstack_offer(LFStack_t *stack, uint32_t index)
+{
+  _Atomic(uint32_t) *slot;
+  uint32_t expected;
+  int i;
+
+  slot = lfstack_random_slot(stack);
+
+  expected = LFSTACK_EMPTY;
+  if (!atomic_compare_exchange_strong_explicit(slot, &expected, index, 
+      memory_order_release, memory_order_relaxed))
+    return 0;
+
+  for (i = 0; i < LFSTACK_ELIMINATION_SPINS; i++) {
+    if (atomic_load_explicit(slot, memory_order_relaxed) != index)
+      break;
+    LFSTACK_PAUSE();
+  }
+
+  // Withdraw the offer, unless a pop claimed it in the meantime
+  expected = index;
+  if (atomic_compare_exchange_strong_explicit(slot, &expected, LFSTACK_EMPTY, 
+      memory_order_relaxed, memory_order_relaxed))
+    return 0;
+
+  // The pop owns the element now -- free the slot for the next pair
+  atomic_store_explicit(slot, LFSTACK_EMPTY, memory_order_release);
+
+  return 1;
+}
+
+
+/**
+Claim an element a concurrent push has offered in the elimination array
+
+@param [in,out] *stack  The stack
+
+@return index + 1 of the element, or 0 if no push was found
+*/
+static uint32_t lfstack_claim(LFStack_t *stack)
+{
+  _Atomic(uint32_t) *slot;
+  uint32_t index;
+  int i;
+
+  slot = lfstack_random_slot(stack);
+
+  for (i = 0; i < LFSTACK_ELIMINATION_SPINS; i++) {
+    index = atomic_load_explicit(slot, memory_order_acquire);
+
+    if (index != LFSTACK_EMPTY && index != LFSTACK_TAKEN) {
+      if (atomic_compare_exchange_strong_explicit(slot, &index, LFSTACK_TAKEN, 
+          memory_order_acquire, memory_order_relaxed))
+        return index;
+      return 0;
+    }
+    LFSTACK_PAUSE();
+  }
+
+  return 0;
+}
+
+
+/**
+Pick a slot of the elimination array at random
+
+Each thread has its own xorshift state, so colliding threads spread out
+without sharing a random number generator.
+
+@param [in,out] *stack  The stack
+
+@return the slot
+*/
+static _Atomic(uint32_t) *lfstack_random_slot(LFStack_t *stack)
+{
+  static _Thread_local uint32_t seed;
+
+  if (seed == 0)
+    seed = (uint32_t)(uintptr_t)&seed | 1;
+
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+
+  return &stack->elimination[seed & (LFSTACK_ELIMINATION_SIZE - 1)].value;
+}
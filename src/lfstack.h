@@ -0,0 +1,171 @@
+/** 
+@file lfstack.h
+@brief 
+Definitions of a bounded lock-free stack (Treiber stack)
+
+The stack is a singly-linked list whose head is swung with compare-and-swap.
+Elements come from an array allocated up front, so a link is a 32-bit index
+rather than a pointer, and the head packs that index together with a 32-bit
+tag bumped on every update. A thread that read the head, was delayed, and
+finds the same element on top again therefore still fails its CAS, which is
+what protects the stack from the ABA problem. Free elements are kept on a
+second tagged stack.
+
+When a CAS on the head fails because of contention, the thread visits an
+elimination array instead: a push parks its element in a random slot for a
+short while, and a pop arriving at that slot takes it directly. Such pairs
+cancel out without touching the head at all.
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#ifndef LFSTACK_h
+#define LFSTACK_h
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+/**
+The assumed size of a cache line, used to keep hot fields apart
+*/
+#ifndef LFSTACK_CACHE_LINE
+#define LFSTACK_CACHE_LINE 64
+#endif
+
+/**
+Number of slots in the elimination array (a power of two)
+*/
+#ifndef LFSTACK_ELIMINATION_SIZE
+#define LFSTACK_ELIMINATION_SIZE 8
+#endif
+
+/**
+Number of times a push waits in the elimination array for a pop to show up
+*/
+#ifndef LFSTACK_ELIMINATION_SPINS
+#define LFSTACK_ELIMINATION_SPINS 64
+#endif
+
+/**
+@struct LFStack_Element_t
+Element in the stack's array
+*/
+typedef struct LFStack_Element_T {
+  void *data;
+  _Atomic(uint32_t) next; ///< Index + 1 of the element below (0 for none)
+} LFStack_Element_t;
+
+/**
+@struct LFStack_Slot_t
+Slot in the elimination array, holding 0 (empty), the index + 1 of an element
+offered by a push, or LFSTACK_TAKEN once a pop has claimed it
+*/
+typedef struct LFStack_Slot_T {
+  _Alignas(LFSTACK_CACHE_LINE)
+  _Atomic(uint32_t) value;
+} LFStack_Slot_t;
+
+/**
+@struct LFStack_t
+Bounded lock-free stack
+*/
+typedef struct LFStack_T {
+  _Alignas(LFSTACK_CACHE_LINE)
+  _Atomic(uint64_t) head; ///< Tag << 32 | index + 1 of the top element
+
+  _Alignas(LFSTACK_CACHE_LINE)
+  _Atomic(uint64_t) free; ///< Tag << 32 | index + 1 of the first free element
+
+  LFStack_Slot_t elimination[LFSTACK_ELIMINATION_SIZE];
+
+  _Alignas(LFSTACK_CACHE_LINE)
+  int capacity;
+
+  void (*destroy)(void *data);
+
+  LFStack_Element_t *elements;
+
+} LFStack_t;
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/**
+Function to initialize a lock-free stack
+
+@pre
+Must be called before stack can be used by any other operation, and before
+any thread starts using it
+
+The stack holds at most _capacity_ elements. The _destroy_ argument provides a
+way to free dynamically allocated data when *lfstack_destroy* is called, or
+NULL if the data should not be freed.
+
+Complexity: O(n) where n is the capacity
+
+@param [out] *stack     The stack to init
+@param [in]   capacity  The maximum number of elements in the stack
+@param [in] (*destroy)  Function pointer to free data element memory
+
+@return 0 if stack init successful, otherwise -1
+*/
+int lfstack_init(LFStack_t *stack, int capacity, void (*destroy)(void *data));
+
+/**
+Function to destroy a lock-free stack
+
+Calls the function passed as _destroy_ to *lfstack_init* once for each element
+still in the stack, provided _destroy_ was not set to NULL.
+
+@pre
+No thread may be using the stack
+
+Complexity: O(n)
+
+@param [in,out] *stack  The stack to destroy
+*/
+void lfstack_destroy(LFStack_t *stack);
+
+/**
+Function to push an element onto the stack
+
+Complexity: O(1) (lock-free)
+
+@param [in,out] *stack  The stack to push element onto
+@param [in]     *data   The data to push
+
+@return 0 if push operation was successful, otherwise -1 (stack full)
+*/
+int lfstack_push(LFStack_t *stack, const void *data);
+
+/**
+Function to pop an element off the stack
+
+Complexity: O(1) (lock-free)
+
+@param [in,out] *stack  The stack to pop element from
+@param [out]    **data  The popped data
+
+@return 0 if pop operation was successful, otherwise -1 (stack empty)
+*/
+int lfstack_pop(LFStack_t *stack, void **data);
+
+/**
+MACRO that evaluates to the maximum number of elements in the stack
+*/
+#define lfstack_capacity(stack) ((stack)->capacity)
+
+#ifdef __cplusplus
+}
+#endif
+#endif // LFSTACK_h
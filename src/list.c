@@ -11,15 +11,39 @@ See header
 
 #include "list.h"
 
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+/**
+Number of merge bins used by *list_sort()*, enough for any list an int can count
+*/
+#define LIST_SORT_BINS 32
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static List_Element_t *list_merge(List_Element_t *a, List_Element_t *b, 
+  int (*compare)(const void *key1, const void *key2));
+
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // Public Functions
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 void list_init(List_t *list, void (*destroy)(void *data))
+{
+  list_init_allocator(list, destroy, NULL);
+}
+
+
+void list_init_allocator(List_t *list, void (*destroy)(void *data), 
+                           const Allocator_t *allocator)
 {
   // Initialize the list
   list->size = 0;
   list->destroy = destroy;
+  list->allocator = allocator;
   list->head = NULL;
   list->tail = NULL;
 }
@@ -29,9 +53,13 @@ void list_destroy(List_t *list)
 {
   void *data;
 
+  // Nothing to release per element if the allocator releases memory in bulk
+  if (list->destroy == NULL && allocator_is_bulk(list->allocator))
+    list->size = 0;
+
   // Remove each element in list
   while (list_size(list) > 0) {
-    if (list_remove_next(list, NULL, (void**)&data) == 0 && list_destroy != NULL) {
+    if (list_remove_next(list, NULL, (void**)&data) == 0 && list->destroy != NULL) {
       list->destroy(data);
     }
   }
@@ -46,7 +74,7 @@ int list_insert_next(List_t *list, List_Element_t *element, const void *data)
   List_Element_t *new_element;
 
   // Allocate storage for the element
-  if ((new_element = (List_Element_t *)malloc(sizeof (List_Element_t))) == NULL) {
+  if ((new_element = (List_Element_t *)allocator_alloc(list->allocator, sizeof (List_Element_t))) == NULL) {
     return -1;
   }
 
@@ -112,10 +140,225 @@ int list_remove_next(List_t *list, List_Element_t *element, void **data)
   }
 
   // Free storage allocated by the abstract datatype
-  free (old_element);
+  allocator_free(list->allocator, old_element);
 
   // Adjust the size of the list
   list->size--;
 
   return 0;
 }
+
+
+int list_concat(List_t *list, List_t *other)
+{
+  // Elements must go back to the allocator they came from
+  if (list == other || list->allocator != other->allocator)
+    return -1;
+
+  if (list_size(other) == 0)
+    return 0;
+
+  if (list_size(list) == 0)
+    list->head = other->head;
+  else
+    list->tail->next = other->head;
+
+  list->tail = other->tail;
+  list->size += other->size;
+
+  // The other list is left empty
+  other->head = NULL;
+  other->tail = NULL;
+  other->size = 0;
+
+  return 0;
+}
+
+
+int list_splice_next(List_t *list, List_Element_t *element, 
+                     List_t *other, List_Element_t *before, List_Element_t *last)
+{
+  List_Element_t *first;
+  List_Element_t *walk;
+  int count;
+
+  // Elements must go back to the allocator they came from
+  if (list == other || list->allocator != other->allocator || last == NULL)
+    return -1;
+
+  if (list_size(other) == 0)
+    return -1;
+
+  first = before == NULL ? other->head : before->next;
+  if (first == NULL)
+    return -1;
+
+  // Count the range, unless it is the whole list
+  if (first == other->head && last == other->tail)
+    count = other->size;
+  else {
+    count = 1;
+    for (walk = first; walk != last; walk = walk->next) {
+      if (walk->next == NULL)
+        return -1;
+      count++;
+    }
+  }
+
+  // Unlink the range from the other list
+  if (before == NULL)
+    other->head = last->next;
+  else
+    before->next = last->next;
+
+  if (other->tail == last)
+    other->tail = before;
+
+  other->size -= count;
+
+  // Link the range into the list
+  if (element == NULL) {
+    last->next = list->head;
+    list->head = first;
+
+    if (list_size(list) == 0)
+      list->tail = last;
+  }
+  else {
+    last->next = element->next;
+    element->next = first;
+
+    if (list->tail == element)
+      list->tail = last;
+  }
+
+  list->size += count;
+
+  return 0;
+}
+
+
+int list_split(List_t *list, List_Element_t *element, List_t *other)
+{
+  List_Element_t *first;
+  List_Element_t *walk;
+  int count;
+
+  if (list == other)
+    return -1;
+
+  list_init_allocator(other, list->destroy, list->allocator);
+
+  first = element == NULL ? list->head : element->next;
+  if (first == NULL)
+    return 0;
+
+  count = 0;
+  for (walk = first; walk != NULL; walk = walk->next)
+    count++;
+
+  other->head = first;
+  other->tail = list->tail;
+  other->size = count;
+
+  if (element == NULL)
+    list->head = NULL;
+  else
+    element->next = NULL;
+
+  list->tail = element;
+  list->size -= count;
+
+  return 0;
+}
+
+
+int list_sort(List_t *list, int (*compare)(const void *key1, const void *key2))
+{
+  List_Element_t *bins[LIST_SORT_BINS];
+  List_Element_t *element;
+  List_Element_t *next;
+  List_Element_t *run;
+  int used;
+  int i;
+
+  if (compare == NULL)
+    return -1;
+
+  if (list_size(list) < 2)
+    return 0;
+
+  // Bin i holds a sorted run of 2^i elements taken from the list before the
+  // elements in any lower bin; like a binary counter, each new element is
+  // merged with the bins it carries into
+  used = 0;
+  for (element = list->head; element != NULL; element = next) {
+    next = element->next;
+
+    element->next = NULL;
+    run = element;
+
+    for (i = 0; i < used && bins[i] != NULL; i++) {
+      run = list_merge(bins[i], run, compare);
+      bins[i] = NULL;
+    }
+
+    if (i == used)
+      used++;
+    bins[i] = run;
+  }
+
+  // Merge what is left in the bins, earlier (higher) bins first in each merge
+  run = NULL;
+  for (i = 0; i < used; i++) {
+    if (bins[i] != NULL)
+      run = run == NULL ? bins[i] : list_merge(bins[i], run, compare);
+  }
+
+  // Find the new tail
+  list->head = run;
+  for (element = run; element->next != NULL; element = element->next)
+    ;
+  list->tail = element;
+
+  return 0;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+/**
+Merge two sorted, NULL terminated chains of elements into one
+
+Only the _next_ links are set. On ties the element from _a_ comes first, which
+keeps the sort stable as long as _a_ holds the earlier elements.
+
+@param [in,out] *a         The chain of earlier elements
+@param [in,out] *b         The chain of later elements
+@param [in]    (*compare)  Function pointer to order the data of two elements
+
+@return the head of the merged chain
+*/
+static List_Element_t *list_merge(List_Element_t *a, List_Element_t *b, 
+  int (*compare)(const void *key1, const void *key2))
+{
+  List_Element_t head;
+  List_Element_t *last = &head;
+
+  while (a != NULL && b != NULL) {
+    if (compare(a->data, b->data) <= 0) {
+      last->next = a;
+      a = a->next;
+    }
+    else {
+      last->next = b;
+      b = b->next;
+    }
+    last = last->next;
+  }
+
+  last->next = a != NULL ? a : b;
+
+  return head.next;
+}
@@ -18,6 +18,8 @@ extern "C"
 
 #include <stdlib.h>
 
+#include "alloc.h"
+
 // -----------------------------------------------------------------------------
 // Definitions
 // -----------------------------------------------------------------------------
@@ -42,6 +44,8 @@ typedef struct List_T {
   int (*match)(const void *a, const void *b);
   void (*destroy)(void *data);
 
+  const Allocator_t *allocator; ///< Allocator for elements (NULL for malloc)
+
   List_Element_t *head; ///< Pointer to first element in list
   List_Element_t *tail; ///< Pointer to last element in list
 
@@ -70,6 +74,22 @@ Complexity: O(1)
 */
 void list_init(List_t *list, void (*destroy)(void *data));
 
+/**
+Function to initialize a linked-list whose elements come from an allocator
+
+Same as *list_init()*, except the elements of the linked-list are allocated
+from _allocator_ rather than with _malloc_. The allocator must remain valid
+until the linked-list is destroyed. Passing NULL is equivalent to *list_init()*.
+
+Complexity: O(1)
+
+@param [out] *list       The linked-list to init
+@param [in] (*destroy)   Function pointer to free data element memory
+@param [in]  *allocator  The allocator to take elements from
+*/
+void list_init_allocator(List_t *list, void (*destroy)(void *data), 
+                           const Allocator_t *allocator);
+
 /**
 Function to destroy a linked-list
 
@@ -81,6 +101,10 @@ removed, provided _destroy_ was not set to NULL.
 No operation is permitted after *list_destroy()* is called unless *list_init()*
 is called again. 
 
+If _destroy_ is NULL and the elements come from an allocator that releases its
+memory in bulk (see *arena_allocator()*), no element needs to be visited and
+the linked-list is destroyed in O(1).
+
 Complexity: O(n)
 
 @param [in,out] *list  The linked-list to destroy
@@ -122,6 +146,86 @@ Complexity: O(1)
 */
 int list_remove_next(List_t *list, List_Element_t *element, void **data);
 
+/**
+Function to move all the elements of one linked-list to the end of another
+
+The elements of _other_ are linked in after the tail of _list_, leaving _other_
+empty. Nothing is allocated or freed. Both lists must take their elements from
+the same allocator.
+
+Complexity: O(1)
+
+@param [in,out] *list   The linked-list to append to
+@param [in,out] *other  The linked-list whose elements are moved
+
+@return 0 if concatenating the lists was successful, otherwise -1
+*/
+int list_concat(List_t *list, List_t *other);
+
+/**
+Function to move a range of elements from one linked-list into another
+
+Unlinks the elements of _other_ from the one just past _before_ up to and
+including _last_, and links them in just after _element_ in _list_. If _before_
+is NULL the range starts at the head of _other_, and if _element_ is NULL the
+range is inserted at the head of _list_. Nothing is allocated or freed. Both
+lists must take their elements from the same allocator.
+
+The range is walked to count its elements, unless it is the whole of _other_.
+
+Complexity: O(1) for a whole list, otherwise O(k) for k elements moved
+
+@param [in,out] *list     The linked-list to insert the range into
+@param [in]     *element  Pointer to element to insert after
+@param [in,out] *other    The linked-list to take the range from
+@param [in]     *before   Pointer to element just before the range
+@param [in]     *last     Pointer to last element of the range
+
+@return 0 if splicing the range was successful, otherwise -1
+*/
+int list_splice_next(List_t *list, List_Element_t *element, 
+                     List_t *other, List_Element_t *before, List_Element_t *last);
+
+/**
+Function to split a linked-list after an element
+
+Moves the elements just past _element_ to the end of the list into _other_,
+which is initialized like _list_ by this function. If _element_ is NULL, every
+element is moved. Nothing is allocated or freed, but the elements moved are
+walked to count them.
+
+Complexity: O(m) for m elements moved
+
+@param [in,out] *list     The linked-list to split
+@param [in]     *element  Pointer to last element to keep in _list_
+@param [out]    *other    The linked-list to receive the remaining elements
+
+@return 0 if splitting the list was successful, otherwise -1
+*/
+int list_split(List_t *list, List_Element_t *element, List_t *other);
+
+/**
+Function to sort a linked-list
+
+Sorts the elements into the order given by _compare_, which is called with the
+data of two elements and returns a negative, zero or positive value as for
+_qsort_. The sort is a bottom-up merge sort that relinks the existing elements,
+so nothing is allocated, and it is stable: elements comparing equal keep their
+relative order.
+
+@note
+Elements are relinked rather than copied, so a pointer to an element still
+refers to the same data afterwards, now at its sorted place in the list.
+
+Complexity: O(n log n)
+
+@param [in,out] *list     The linked-list to sort
+@param [in]    (*compare) Function pointer to order the data of two elements
+
+@return 0 if sorting the list was successful, otherwise -1
+*/
+int list_sort(List_t *list, int (*compare)(const void *key1, const void *key2));
+
 /**
 MACRO that evaluates to the number of elements in the linked-list
 */
@@ -0,0 +1,344 @@
+/**
+@file listsort.c
+
+See header
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "listsort.h"
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+/**
+@struct ListSort_Task_t
+Work for one thread: sort a run, or merge the next run into it
+*/
+typedef struct ListSort_Task_T {
+  void *run;   ///< The List_t or DList_t run to sort or merge into
+  void *other; ///< The run to merge into _run_ (NULL to sort _run_)
+
+  int (*compare)(const void *key1, const void *key2);
+
+} ListSort_Task_t;
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static int listsort_threads(int size, int threads);
+static void listsort_run(void *(*work)(void *), ListSort_Task_t *tasks, int count);
+static void *list_sort_task(void *arg);
+static void *dlist_sort_task(void *arg);
+static void list_merge_runs(List_t *a, List_t *b, 
+  int (*compare)(const void *key1, const void *key2));
+static void dlist_merge_runs(DList_t *a, DList_t *b, 
+  int (*compare)(const void *key1, const void *key2));
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+int list_sort_parallel(List_t *list, int (*compare)(const void *key1, const void *key2), 
+                       int threads)
+{
+  List_t runs[LISTSORT_MAX_THREADS];
+  ListSort_Task_t tasks[LISTSORT_MAX_THREADS];
+  List_Element_t *element;
+  int count;
+  int share;
+  int step;
+  int i;
+  int j;
+
+  if (compare == NULL)
+    return -1;
+
+  if ((count = listsort_threads(list_size(list), threads)) < 2)
+    return list_sort(list, compare);
+
+  // Cut the list into one run per thread (the last run takes the remainder)
+  share = list_size(list) / count;
+  element = list->head;
+
+  for (i = 0; i < count; i++) {
+    runs[i] = *list;
+    runs[i].size = i == count - 1 ? list_size(list) - i * share : share;
+    runs[i].head = element;
+
+    for (j = 1; j < runs[i].size; j++)
+      element = element->next;
+
+    runs[i].tail = element;
+    element = element->next;
+    runs[i].tail->next = NULL;
+
+    tasks[i].run = &runs[i];
+    tasks[i].other = NULL;
+    tasks[i].compare = compare;
+  }
+
+  listsort_run(list_sort_task, tasks, count);
+
+  // Merge neighbouring runs pairwise, halving the number of runs each round
+  for (step = 1; step < count; step *= 2) {
+    for (i = 0, j = 0; i + step < count; i += 2 * step, j++) {
+      tasks[j].run = &runs[i];
+      tasks[j].other = &runs[i + step];
+    }
+    listsort_run(list_sort_task, tasks, j);
+  }
+
+  list->head = runs[0].head;
+  list->tail = runs[0].tail;
+
+  return 0;
+}
+
+
+int dlist_sort_parallel(DList_t *list, int (*compare)(const void *key1, const void *key2), 
+                        int threads)
+{
+  DList_t runs[LISTSORT_MAX_THREADS];
+  ListSort_Task_t tasks[LISTSORT_MAX_THREADS];
+  DList_Element_t *element;
+  int count;
+  int share;
+  int step;
+  int i;
+  int j;
+
+  if (compare == NULL)
+    return -1;
+
+  if ((count = listsort_threads(dlist_size(list), threads)) < 2)
+    return dlist_sort(list, compare);
+
+  // Cut the list into one run per thread (the last run takes the remainder)
+  share = dlist_size(list) / count;
+  element = list->head;
+
+  for (i = 0; i < count; i++) {
+    runs[i] = *list;
+    runs[i].size = i == count - 1 ? dlist_size(list) - i * share : share;
+    runs[i].head = element;
+    element->prev = NULL;
+
+    for (j = 1; j < runs[i].size; j++)
+      element = element->next;
+
+    runs[i].tail = element;
+    element = element->next;
+    runs[i].tail->next = NULL;
+
+    tasks[i].run = &runs[i];
+    tasks[i].other = NULL;
+    tasks[i].compare = compare;
+  }
+
+  listsort_run(dlist_sort_task, tasks, count);
+
+  // Merge neighbouring runs pairwise, halving the number of runs each round
+  for (step = 1; step < count; step *= 2) {
+    for (i = 0, j = 0; i + step < count; i += 2 * step, j++) {
+      tasks[j].run = &runs[i];
+      tasks[j].other = &runs[i + step];
+    }
+    listsort_run(dlist_sort_task, tasks, j);
+  }
+
+  list->head = runs[0].head;
+  list->tail = runs[0].tail;
+
+  return 0;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+/**
+Decide how many threads are worth using to sort a list
+
+@param [in] size     The number of elements in the list
+@param [in] threads  The number of threads asked for
+
+@return the number of threads to use
+*/
+static int listsort_threads(int size, int threads)
+{
+  if (threads > LISTSORT_MAX_THREADS)
+    threads = LISTSORT_MAX_THREADS;
+
+  if (threads > size / LISTSORT_MIN_RUN)
+    threads = size / LISTSORT_MIN_RUN;
+
+  return threads;
+}
+
+
+/**
+Run tasks in parallel, one per thread, and wait for all of them
+
+The calling thread runs the first task itself. A task whose thread cannot be
+started is run by the calling thread as well.
+
+@param [in]    (*work)  The thread function, given a pointer to its task
+@param [in,out] *tasks  The tasks
+@param [in]      count  The number of tasks
+*/
+static void listsort_run(void *(*work)(void *), ListSort_Task_t *tasks, int count)
+{
+  pthread_t ids[LISTSORT_MAX_THREADS];
+  int started[LISTSORT_MAX_THREADS];
+  int i;
+
+  for (i = 1; i < count; i++)
+    started[i] = pthread_create(&ids[i], NULL, work, &tasks[i]) == 0;
+
+  if (count > 0)
+    work(&tasks[0]);
+
+  for (i = 1; i < count; i++) {
+    if (started[i])
+      pthread_join(ids[i], NULL);
+    else
+      work(&tasks[i]);
+  }
+}
+
+
+/**
+Thread function to sort a List_t run, or merge the next run into it
+
+@param [in,out] *arg  The task
+
+@return NULL
+*/
+static void *list_sort_task(void *arg)
+{
+  ListSort_Task_t *task = (ListSort_Task_t *)arg;
+
+  if (task->other == NULL)
+    list_sort((List_t *)task->run, task->compare);
+  else
+    list_merge_runs((List_t *)task->run, (List_t *)task->other, task->compare);
+
+  return NULL;
+}
+
+
+/**
+Thread function to sort a DList_t run, or merge the next run into it
+
+@param [in,out] *arg  The task
+
+@return NULL
+*/
+static void *dlist_sort_task(void *arg)
+{
+  ListSort_Task_t *task = (ListSort_Task_t *)arg;
+
+  if (task->other == NULL)
+    dlist_sort((DList_t *)task->run, task->compare);
+  else
+    dlist_merge_runs((DList_t *)task->run, (DList_t *)task->other, task->compare);
+
+  return NULL;
+}
+
+
+/**
+Merge a sorted run into the sorted run just before it
+
+On ties the element from _a_ comes first, which keeps the sort stable.
+
+@param [in,out] *a         The earlier run, which receives the merged run
+@param [in,out] *b         The later run
+@param [in]    (*compare)  Function pointer to order the data of two elements
+*/
+static void list_merge_runs(List_t *a, List_t *b, 
+  int (*compare)(const void *key1, const void *key2))
+{
+  List_Element_t head;
+  List_Element_t *last = &head;
+  List_Element_t *x = a->head;
+  List_Element_t *y = b->head;
+
+  while (x != NULL && y != NULL) {
+    if (compare(x->data, y->data) <= 0) {
+      last->next = x;
+      x = x->next;
+    }
+    else {
+      last->next = y;
+      y = y->next;
+    }
+    last = last->next;
+  }
+
+  // Whichever run is left over supplies the tail
+  if (x != NULL)
+    last->next = x;
+  else {
+    last->next = y;
+    a->tail = b->tail;
+  }
+
+  a->head = head.next;
+  a->size += b->size;
+}
+
+
+/**
+Merge a sorted doubly linked run into the sorted run just before it
+
+On ties the element from _a_ comes first, which keeps the sort stable.
+
+@param [in,out] *a         The earlier run, which receives the merged run
+@param [in,out] *b         The later run
+@param [in]    (*compare)  Function pointer to order the data of two elements
+*/
+static void dlist_merge_runs(DList_t *a, DList_t *b, 
+  int (*compare)(const void *key1, const void *key2))
+{
+  DList_Element_t head;
+  DList_Element_t *last = &head;
+  DList_Element_t *x = a->head;
+  DList_Element_t *y = b->head;
+
+  while (x != NULL && y != NULL) {
+    if (compare(x->data, y->data) <= 0) {
+      last->next = x;
+      x->prev = last;
+      x = x->next;
+    }
+    else {
+      last->next = y;
+      y->prev = last;
+      y = y->next;
+    }
+    last = last->next;
+  }
+
+  // Whichever run is left over supplies the tail
+  if (x != NULL) {
+    last->next = x;
+    x->prev = last;
+  }
+  else {
+    last->next = y;
+    y->prev = last;
+    a->tail = b->tail;
+  }
+
+  a->head = head.next;
+  a->head->prev = NULL;
+  a->size += b->size;
+}
@@ -0,0 +1,98 @@
+/** 
+@file listsort.h
+@brief 
+Definitions of multi-threaded merge sorts for linked-lists
+
+The list is cut into one run per thread, the runs are sorted at the same time
+with *list_sort()* or *dlist_sort()*, and the sorted runs are merged pairwise,
+again with the merges of each round running in parallel. Like the sequential
+sorts, these relink the existing elements and are stable.
+
+They are kept apart from list.c and dlist.c so that only programs that sort
+in parallel need to link with POSIX threads.
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#ifndef LISTSORT_h
+#define LISTSORT_h
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdlib.h>
+
+#include "dlist.h"
+#include "list.h"
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+/**
+Lists with fewer elements than this per thread are sorted on fewer threads, as
+starting a thread would cost more than it saves
+*/
+#ifndef LISTSORT_MIN_RUN
+#define LISTSORT_MIN_RUN 16384
+#endif
+
+/**
+Maximum number of threads a sort uses
+*/
+#ifndef LISTSORT_MAX_THREADS
+#define LISTSORT_MAX_THREADS 64
+#endif
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/**
+Function to sort a linked-list on several threads
+
+Gives the same result as *list_sort()*. The calling thread takes part in the
+sort, so at most _threads_ - 1 threads are started. If a thread cannot be
+started its share of the work is done by the calling thread instead.
+
+@pre
+No other thread may access the list during the sort, and _compare_ must be
+safe to call from several threads at once
+
+Complexity: O(n log n), with O(n) for the last merge
+
+@param [in,out] *list     The linked-list to sort
+@param [in]    (*compare) Function pointer to order the data of two elements
+@param [in]     threads   The number of threads to sort with
+
+@return 0 if sorting the list was successful, otherwise -1
+*/
+int list_sort_parallel(List_t *list, int (*compare)(const void *key1, const void *key2), 
+                       int threads);
+
+/**
+Function to sort a doubly linked-list on several threads
+
+Gives the same result as *dlist_sort()*, as described for
+*list_sort_parallel()*.
+
+@pre
+No other thread may access the list during the sort, and _compare_ must be
+safe to call from several threads at once
+
+Complexity: O(n log n), with O(n) for the last merge
+
+@param [in,out] *list     The doubly linked-list to sort
+@param [in]    (*compare) Function pointer to order the data of two elements
+@param [in]     threads   The number of threads to sort with
+
+@return 0 if sorting the list was successful, otherwise -1
+*/
+int dlist_sort_parallel(DList_t *list, int (*compare)(const void *key1, const void *key2), 
+                        int threads);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // LISTSORT_h
@@ -0,0 +1,349 @@
+/**
+@file lru.c
+
+See header
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "lru.h"
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+/**
+Largest of the blocks the pool hands out
+*/
+#define LRU_BLOCK_SIZE \
+  (sizeof (LRUCache_Entry_t) > sizeof (HashTable_Element_t) ? \
+   (sizeof (LRUCache_Entry_t) > sizeof (DList_Element_t) ? \
+    sizeof (LRUCache_Entry_t) : sizeof (DList_Element_t)) : \
+   (sizeof (HashTable_Element_t) > sizeof (DList_Element_t) ? \
+    sizeof (HashTable_Element_t) : sizeof (DList_Element_t)))
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static uint64_t lru_entry_hash(const void *data);
+static int lru_entry_match(const void *a, const void *b);
+static void *lru_entry_create(const void *key);
+static void lru_entry_free(void *data);
+static LRUCache_Entry_t *lru_find(LRUCache_t *cache, const void *key);
+static void lru_unlink(LRUCache_t *cache, LRUCache_Entry_t *entry);
+static void lru_touch(LRUCache_t *cache, LRUCache_Entry_t *entry);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+int lru_init(LRUCache_t *cache, int buckets, int max_entries, size_t max_weight, 
+             uint64_t (*hash)(const void *key),
+             int (*match)(const void *key1, const void *key2),
+             void (*evict)(void *key, void *value))
+{
+  if (max_entries < 0)
+    return -1;
+
+  if (pool_init(&cache->pool, LRU_BLOCK_SIZE, LRU_POOL_BLOCKS) != 0)
+    return -1;
+
+  if (hashtable_init_allocator(&cache->table, buckets, lru_entry_hash, 
+      lru_entry_match, lru_entry_free, pool_allocator(&cache->pool)) != 0) {
+    pool_destroy(&cache->pool);
+    return -1;
+  }
+
+  // Keep probes short however many entries the limits allow
+  hashtable_set_load_factor(&cache->table, 1.0, 0.0);
+
+  dlist_init_allocator(&cache->recency, NULL, pool_allocator(&cache->pool));
+
+  cache->max_entries = max_entries;
+  cache->max_weight = max_weight;
+  cache->weight = 0;
+  cache->hash = hash;
+  cache->match = match;
+  cache->evict = evict;
+
+  return 0;
+}
+
+
+void lru_destroy(LRUCache_t *cache)
+{
+  DList_Element_t *element;
+  LRUCache_Entry_t *entry;
+
+  // Hand every entry to the evict callback
+  if (cache->evict != NULL) {
+    for (element = dlist_head(&cache->recency); element != NULL; element = dlist_next(element)) {
+      entry = (LRUCache_Entry_t *)dlist_data(element);
+      cache->evict(entry->key, entry->value);
+    }
+  }
+
+  // Entries and elements all live in the pool, so the pool goes last
+  hashtable_destroy(&cache->table);
+  dlist_destroy(&cache->recency);
+  pool_destroy(&cache->pool);
+
+  // No operations permitted at this point -- clear memory as precaution
+  memset(cache, 0, sizeof (LRUCache_t));
+}
+
+
+int lru_get(LRUCache_t *cache, const void *key, void **value)
+{
+  LRUCache_Entry_t *entry;
+
+  if ((entry = lru_find(cache, key)) == NULL)
+    return -1;
+
+  lru_touch(cache, entry);
+  *value = entry->value;
+
+  return 0;
+}
+
+
+int lru_peek(LRUCache_t *cache, const void *key, void **value)
+{
+  LRUCache_Entry_t *entry;
+
+  if ((entry = lru_find(cache, key)) == NULL)
+    return -1;
+
+  *value = entry->value;
+
+  return 0;
+}
+
+
+int lru_put(LRUCache_t *cache, const void *key, const void *value, size_t weight)
+{
+  LRUCache_Entry_t probe;
+  LRUCache_Entry_t *entry;
+  void *old_key;
+  void *old_value;
+  void *data;
+  int retval;
+
+  if (cache->max_weight > 0 && weight > cache->max_weight)
+    return -1;
+
+  // One probe finds the entry or links in a new one from the pool
+  probe.key = (void *)key;
+  probe.cache = cache;
+
+  data = &probe;
+  if ((retval = hashtable_get_or_insert_with(&cache->table, &data, lru_entry_create)) < 0)
+    return -1;
+
+  entry = (LRUCache_Entry_t *)data;
+
+  if (retval == 1) {
+    // Replace the entry in place
+    old_key = entry->key;
+    old_value = entry->value;
+
+    entry->key = (void *)key;
+    entry->value = (void *)value;
+    cache->weight += weight - entry->weight;
+    entry->weight = weight;
+
+    lru_touch(cache, entry);
+
+    // Only let go of what is no longer stored
+    if (old_key == key)
+      old_key = NULL;
+    if (old_value == value)
+      old_value = NULL;
+
+    if (cache->evict != NULL && (old_key != NULL || old_value != NULL))
+      cache->evict(old_key, old_value);
+  }
+  else {
+    // Add the new entry at the head of the recency list
+    entry->value = (void *)value;
+    entry->weight = weight;
+
+    if (dlist_insert_prev(&cache->recency, dlist_head(&cache->recency), entry) != 0) {
+      data = entry;
+      hashtable_remove(&cache->table, &data);
+      pool_free(&cache->pool, entry);
+      return -1;
+    }
+    entry->element = dlist_head(&cache->recency);
+
+    cache->weight += weight;
+  }
+
+  // Evict from the cold end until within limits; the entry just put is at the
+  // head and fits on its own, so it is never the one evicted
+  while ((cache->max_entries > 0 && lru_size(cache) > cache->max_entries) || 
+         (cache->max_weight > 0 && cache->weight > cache->max_weight)) {
+    entry = (LRUCache_Entry_t *)dlist_data(dlist_tail(&cache->recency));
+
+    old_key = entry->key;
+    old_value = entry->value;
+
+    lru_unlink(cache, entry);
+
+    if (cache->evict != NULL)
+      cache->evict(old_key, old_value);
+  }
+
+  return retval;
+}
+
+
+int lru_remove(LRUCache_t *cache, void **key, void **value)
+{
+  LRUCache_Entry_t *entry;
+
+  if ((entry = lru_find(cache, *key)) == NULL)
+    return -1;
+
+  *key = entry->key;
+  *value = entry->value;
+
+  lru_unlink(cache, entry);
+
+  return 0;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+/**
+Hash table callback hashing an entry by its key
+
+@param [in] *data  The entry
+
+@return the hash of the entry's key
+*/
+static uint64_t lru_entry_hash(const void *data)
+{
+  const LRUCache_Entry_t *entry = (const LRUCache_Entry_t *)data;
+
+  return entry->cache->hash(entry->key);
+}
+
+
+/**
+Hash table callback comparing two entries by their keys
+
+@param [in] *a  The first entry
+@param [in] *b  The second entry
+
+@return nonzero if the keys match
+*/
+static int lru_entry_match(const void *a, const void *b)
+{
+  const LRUCache_Entry_t *entry1 = (const LRUCache_Entry_t *)a;
+  const LRUCache_Entry_t *entry2 = (const LRUCache_Entry_t *)b;
+
+  return entry1->cache->match(entry1->key, entry2->key);
+}
+
+
+/**
+Hash table factory creating an entry for the key of a probe entry
+
+The entry is taken from the pool of the probe's cache and holds only the key;
+the caller fills in the rest.
+
+@param [in] *key  The probe entry
+
+@return the new entry, or NULL if memory could not be allocated
+*/
+static void *lru_entry_create(const void *key)
+{
+  const LRUCache_Entry_t *probe = (const LRUCache_Entry_t *)key;
+  LRUCache_Entry_t *entry;
+
+  if ((entry = (LRUCache_Entry_t *)pool_alloc(&probe->cache->pool)) == NULL)
+    return NULL;
+
+  entry->key = probe->key;
+  entry->value = NULL;
+  entry->weight = 0;
+  entry->cache = probe->cache;
+  entry->element = NULL;
+
+  return entry;
+}
+
+
+/**
+Hash table callback giving an entry back to the pool
+
+@param [in] *data  The entry
+*/
+static void lru_entry_free(void *data)
+{
+  LRUCache_Entry_t *entry = (LRUCache_Entry_t *)data;
+
+  pool_free(&entry->cache->pool, entry);
+}
+
+
+/**
+Find the entry for a key
+
+@param [in,out] *cache  The cache
+@param [in]     *key    The key
+
+@return the entry, or NULL if the key is not cached
+*/
+static LRUCache_Entry_t *lru_find(LRUCache_t *cache, const void *key)
+{
+  LRUCache_Entry_t probe;
+  void *data;
+
+  probe.key = (void *)key;
+  probe.cache = cache;
+
+  data = &probe;
+  if (hashtable_lookup(&cache->table, &data) != 0)
+    return NULL;
+
+  return (LRUCache_Entry_t *)data;
+}
+
+
+/**
+Take an entry out of the hash table and recency list and free it
+
+@param [in,out] *cache  The cache
+@param [in]     *entry  The entry
+*/
+static void lru_unlink(LRUCache_t *cache, LRUCache_Entry_t *entry)
+{
+  void *data;
+
+  data = entry;
+  hashtable_remove(&cache->table, &data);
+  dlist_remove(&cache->recency, entry->element, &data);
+
+  cache->weight -= entry->weight;
+  pool_free(&cache->pool, entry);
+}
+
+
+/**
+Move an entry to the head of the recency list
+
+@param [in,out] *cache  The cache
+@param [in]     *entry  The entry
+*/
+static void lru_touch(LRUCache_t *cache, LRUCache_Entry_t *entry)
+{
+  dlist_move_prev(&cache->recency, entry->element, dlist_head(&cache->recency));
+}
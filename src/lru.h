@@ -0,0 +1,205 @@
+/** 
+@file lru.h
+@brief 
+Definitions of a least-recently-used cache ADT
+
+The cache pairs a chained hash table with a doubly linked-list ordered by
+recency, most recently used at the head. The hash table stores the cache
+entries themselves, and each entry holds a pointer to its own list element,
+so a hit costs one hash probe plus an O(1) move of that element to the head
+of the list; the least recently used entry is always at the tail.
+
+The cache can be bounded by number of entries, by total weight (for example
+the size in bytes of the values), or both. Entries, hash table elements and
+list elements all come from one pool owned by the cache, so a steady state of
+puts and evictions does not go through malloc.
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#ifndef LRU_h
+#define LRU_h
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "dlist.h"
+#include "hashtable.h"
+#include "pool.h"
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+/**
+Number of entries the cache's pool allocates at once
+*/
+#ifndef LRU_POOL_BLOCKS
+#define LRU_POOL_BLOCKS 256
+#endif
+
+/**
+@struct LRUCache_Entry_t
+Entry of a cache, stored in both the hash table and the recency list
+*/
+typedef struct LRUCache_Entry_T {
+  void *key;
+  void *value;
+  size_t weight;
+
+  DList_Element_t *element; ///< The entry's element in the recency list
+  struct LRUCache_T *cache; ///< The cache, for the hash table callbacks
+
+} LRUCache_Entry_t;
+
+/**
+@struct LRUCache_t
+Least-recently-used cache
+
+@note
+The cache contains its own pool, which the hash table and list refer to, so an
+initialized cache must not be copied or moved.
+*/
+typedef struct LRUCache_T {
+  int max_entries;   ///< Maximum number of entries (0 = unlimited)
+  size_t max_weight; ///< Maximum total weight (0 = unlimited)
+  size_t weight;     ///< Total weight of the entries
+
+  uint64_t (*hash)(const void *key);
+  int (*match)(const void *key1, const void *key2);
+  void (*evict)(void *key, void *value);
+
+  Pool_t pool;       ///< Storage for entries and the elements holding them
+  HashTable_t table; ///< Entries by key
+  DList_t recency;   ///< Entries, most recently used first
+
+} LRUCache_t;
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/**
+Function to initialize a least-recently-used cache
+
+@pre
+Must be called before cache can be used by any other operation
+
+The cache holds at most _max_entries_ entries whose weights add up to at most
+_max_weight_; either limit may be 0 for none. The functions _hash_ and _match_
+work on keys as for *hashtable_init()*. The _evict_ argument is called with the
+key and value of every entry the cache lets go of by itself: entries evicted
+to make room, entries replaced by *lru_put()* (where either pointer may be NULL,
+see there), and entries left when the cache is destroyed. It may be NULL.
+
+Complexity: O(m), where *m* is the initial number of buckets
+
+@param [out] *cache        The cache to init
+@param [in]   buckets      The initial number of hash table buckets
+@param [in]   max_entries  The maximum number of entries (0 = unlimited)
+@param [in]   max_weight   The maximum total weight (0 = unlimited)
+@param [in]  *hash         Pointer to user hash function
+@param [in]  *match        Pointer to user key comparison function
+@param [in]  *evict        Pointer to function releasing an evicted entry
+
+@return 0 if cache init successful, otherwise -1
+*/
+int lru_init(LRUCache_t *cache, int buckets, int max_entries, size_t max_weight, 
+             uint64_t (*hash)(const void *key),
+             int (*match)(const void *key1, const void *key2),
+             void (*evict)(void *key, void *value));
+
+/**
+Function to destroy a least-recently-used cache
+
+Calls _evict_ for each entry left, provided _evict_ was not set to NULL.
+
+Complexity: O(n + m)
+
+@param [in,out] *cache  The cache to destroy
+*/
+void lru_destroy(LRUCache_t *cache);
+
+/**
+Function to look up a value and mark it as most recently used
+
+Complexity: O(1)
+
+@param [in,out] *cache  The cache to look in
+@param [in]     *key    The key to look up
+@param [out]    **value The value found
+
+@return 0 if the key is cached, otherwise -1
+*/
+int lru_get(LRUCache_t *cache, const void *key, void **value);
+
+/**
+Function to look up a value without changing its recency
+
+Complexity: O(1)
+
+@param [in,out] *cache  The cache to look in
+@param [in]     *key    The key to look up
+@param [out]    **value The value found
+
+@return 0 if the key is cached, otherwise -1
+*/
+int lru_peek(LRUCache_t *cache, const void *key, void **value);
+
+/**
+Function to add or replace a value as most recently used
+
+If _key_ is already cached, the entry takes the new key, value and weight, and
+the old key and value are passed to _evict_. An old pointer that is the same
+as the new one is still stored, so NULL is passed in its place, and _evict_ is
+not called at all if both are the same. Least recently used entries are then
+evicted until the cache is within its limits again.
+
+The key is hashed and its bucket searched once, whether it is a hit or a miss.
+
+Complexity: O(1) plus O(1) per entry evicted
+
+@param [in,out] *cache   The cache to add to
+@param [in]     *key     The key
+@param [in]     *value   The value
+@param [in]      weight  The weight of the entry
+
+@return 0 if a new entry was added, 1 if an entry was replaced, otherwise -1
+(including when _weight_ alone exceeds the weight limit)
+*/
+int lru_put(LRUCache_t *cache, const void *key, const void *value, size_t weight);
+
+/**
+Function to remove an entry and hand it back to the caller
+
+_evict_ is not called. On entry _key_ points to the key to remove; upon return
+_key_ and _value_ point to the key and value that were stored.
+
+Complexity: O(1)
+
+@param [in,out] *cache  The cache to remove from
+@param [in,out] **key   The key to remove, then the key that was stored
+@param [out]    **value The value that was stored
+
+@return 0 if the entry was removed, otherwise -1 (not cached)
+*/
+int lru_remove(LRUCache_t *cache, void **key, void **value);
+
+/**
+MACRO that evaluates to the number of entries in the cache
+*/
+#define lru_size(cache) (dlist_size(&(cache)->recency))
+
+/**
+MACRO that evaluates to the total weight of the entries in the cache
+*/
+#define lru_weight(cache) ((cache)->weight)
+
+#ifdef __cplusplus
+}
+#endif
+#endif // LRU_h
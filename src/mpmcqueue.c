@@ -0,0 +1,200 @@
+/**
+@file mpmcqueue.c
+
+See header
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+
+#include <sched.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mpmcqueue.h"
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static void mpmcqueue_backoff(int *spins);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+int mpmcqueue_init(MPMCQueue_t *queue, int capacity, void (*destroy)(void *data))
+{
+  size_t slots;
+  size_t i;
+
+  if (capacity <= 0)
+    return -1;
+
+  // Round the capacity up to a power of two; a single cell cannot tell a full
+  // queue from an empty one by its sequence alone
+  slots = 2;
+  while (slots < (size_t)capacity)
+    slots *= 2;
+
+  queue->cells = (MPMCQueue_Cell_t *)malloc(slots * sizeof (MPMCQueue_Cell_t));
+  if (queue->cells == NULL)
+    return -1;
+
+  // Cell i is initially ready for the producer claiming position i
+  for (i = 0; i < slots; i++) {
+    atomic_init(&queue->cells[i].sequence, i);
+    queue->cells[i].data = NULL;
+  }
+
+  queue->capacity = slots;
+  queue->destroy = destroy;
+
+  atomic_init(&queue->enqueue_pos, 0);
+  atomic_init(&queue->dequeue_pos, 0);
+
+  return 0;
+}
+
+
+void mpmcqueue_destroy(MPMCQueue_t *queue)
+{
+  void *data;
+
+  // Destroy each element still in the queue
+  while (mpmcqueue_try_dequeue(queue, &data) == 0) {
+    if (queue->destroy != NULL)
+      queue->destroy(data);
+  }
+
+  free(queue->cells);
+
+  // No operations permitted at this point -- clear memory as precaution
+  memset(queue, 0, sizeof (MPMCQueue_t));
+}
+
+
+int mpmcqueue_try_enqueue(MPMCQueue_t *queue, const void *data)
+{
+  MPMCQueue_Cell_t *cell;
+  size_t pos;
+  size_t seq;
+  intptr_t diff;
+
+  pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+
+  for (;;) {
+    cell = &queue->cells[pos & (queue->capacity - 1)];
+    seq = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+    diff = (intptr_t)seq - (intptr_t)pos;
+
+    if (diff == 0) {
+      // Cell is free for this position -- try to claim it
+      if (atomic_compare_exchange_weak_explicit(&queue->enqueue_pos, &pos, 
+          pos + 1, memory_order_relaxed, memory_order_relaxed))
+        break;
+    }
+    else if (diff < 0) {
+      // Cell still holds the element from one lap ago -- queue is full
+      return -1;
+    }
+    else {
+      // Another producer claimed this position first
+      pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+    }
+  }
+
+  cell->data = (void *)data;
+
+  // Hand the cell to the consumer that will claim this position
+  atomic_store_explicit(&cell->sequence, pos + 1, memory_order_release);
+
+  return 0;
+}
+
+
+int mpmcqueue_try_dequeue(MPMCQueue_t *queue, void **data)
+{
+  MPMCQueue_Cell_t *cell;
+  size_t pos;
+  size_t seq;
+  intptr_t diff;
+
+  pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+
+  for (;;) {
+    cell = &queue->cells[pos & (queue->capacity - 1)];
+    seq = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+    diff = (intptr_t)seq - (intptr_t)(pos + 1);
+
+    if (diff == 0) {
+      // Cell has been filled for this position -- try to claim it
+      if (atomic_compare_exchange_weak_explicit(&queue->dequeue_pos, &pos, 
+          pos + 1, memory_order_relaxed, memory_order_relaxed))
+        break;
+    }
+    else if (diff < 0) {
+      // Cell has not been filled yet -- queue is empty
+      return -1;
+    }
+    else {
+      // Another consumer claimed this position first
+      pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+    }
+  }
+
+  *data = cell->data;
+
+  // Hand the cell back to the producer one lap ahead
+  atomic_store_explicit(&cell->sequence, pos + queue->capacity, 
+    memory_order_release);
+
+  return 0;
+}
+
+
+int mpmcqueue_enqueue(MPMCQueue_t *queue, const void *data)
+{
+  int spins = 0;
+
+  while (mpmcqueue_try_enqueue(queue, data) != 0)
+    mpmcqueue_backoff(&spins);
+
+  return 0;
+}
+
+
+int mpmcqueue_dequeue(MPMCQueue_t *queue, void **data)
+{
+  int spins = 0;
+
+  while (mpmcqueue_try_dequeue(queue, data) != 0)
+    mpmcqueue_backoff(&spins);
+
+  return 0;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+/**
+Wait a little before the next attempt of a blocking call
+
+Spins for the first MPMCQUEUE_SPIN_LIMIT attempts, since the other side is
+usually only a few instructions away, then starts yielding the CPU so a
+waiting thread does not starve the one it is waiting on.
+
+@param [in,out] *spins  Number of failed attempts so far
+*/
+static void mpmcqueue_backoff(int *spins)
+{
+  if (*spins < MPMCQUEUE_SPIN_LIMIT) {
+    (*spins)++;
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_ia32_pause();
+#endif
+  }
+  else
+    sched_yield();
+}
@@ -0,0 +1,178 @@
+/** 
+@file mpmcqueue.h
+@brief 
+Definitions of a bounded lock-free multi-producer/multi-consumer queue
+
+Any number of threads may enqueue and dequeue concurrently. The queue is a
+power-of-two array of cells, each tagged with a sequence number that tells
+producers and consumers whether the cell is ready for them (Dmitry Vyukov's
+bounded MPMC queue). A producer claims a cell by advancing the shared enqueue
+position with a compare-and-swap, fills it, then publishes it by bumping the
+cell's sequence; consumers do the same on the dequeue side. Producers and
+consumers therefore only contend with their own kind, and never on a lock.
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#ifndef MPMCQUEUE_h
+#define MPMCQUEUE_h
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdatomic.h>
+#include <stdlib.h>
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+/**
+The assumed size of a cache line, used to keep the two ends of the queue apart
+*/
+#ifndef MPMCQUEUE_CACHE_LINE
+#define MPMCQUEUE_CACHE_LINE 64
+#endif
+
+/**
+Number of failed attempts a blocking call spins before yielding the CPU
+*/
+#ifndef MPMCQUEUE_SPIN_LIMIT
+#define MPMCQUEUE_SPIN_LIMIT 64
+#endif
+
+/**
+@struct MPMCQueue_Cell_t
+Slot in the queue's ring
+*/
+typedef struct MPMCQueue_Cell_T {
+  atomic_size_t sequence; ///< Position this cell is ready for
+  void *data;
+} MPMCQueue_Cell_t;
+
+/**
+@struct MPMCQueue_t
+Bounded lock-free multi-producer/multi-consumer queue
+*/
+typedef struct MPMCQueue_T {
+  _Alignas(MPMCQUEUE_CACHE_LINE)
+  atomic_size_t enqueue_pos; ///< Next position a producer will claim
+
+  _Alignas(MPMCQUEUE_CACHE_LINE)
+  atomic_size_t dequeue_pos; ///< Next position a consumer will claim
+
+  _Alignas(MPMCQUEUE_CACHE_LINE)
+  size_t capacity; ///< Number of cells in the ring (a power of two)
+
+  void (*destroy)(void *data);
+
+  MPMCQueue_Cell_t *cells;
+
+} MPMCQueue_t;
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/**
+Function to initialize a multi-producer/multi-consumer queue
+
+@pre
+Must be called before queue can be used by any other operation, and before
+any thread starts using it
+
+The queue holds at most _capacity_ elements, rounded up to a power of two (and
+at least 2). The _destroy_ argument provides a way to free dynamically
+allocated data when *mpmcqueue_destroy* is called, or NULL if the data should
+not be freed.
+
+Complexity: O(n) where n is the capacity
+
+@param [out] *queue     The queue to init
+@param [in]   capacity  The maximum number of elements in the queue
+@param [in] (*destroy)  Function pointer to free data element memory
+
+@return 0 if queue init successful, otherwise -1
+*/
+int mpmcqueue_init(MPMCQueue_t *queue, int capacity, void (*destroy)(void *data));
+
+/**
+Function to destroy a multi-producer/multi-consumer queue
+
+Calls the function passed as _destroy_ to *mpmcqueue_init* once for each
+element still in the queue, provided _destroy_ was not set to NULL.
+
+@pre
+No thread may be using the queue
+
+Complexity: O(n)
+
+@param [in,out] *queue  The queue to destroy
+*/
+void mpmcqueue_destroy(MPMCQueue_t *queue);
+
+/**
+Function to try to add an element to the end of the queue without blocking
+
+Complexity: O(1) (lock-free)
+
+@param [in,out] *queue  The queue to add element to
+@param [in]     *data   The data to enqueue
+
+@return 0 if enqueue operation was successful, otherwise -1 (queue full)
+*/
+int mpmcqueue_try_enqueue(MPMCQueue_t *queue, const void *data);
+
+/**
+Function to try to remove an element from the front of the queue without
+blocking
+
+Complexity: O(1) (lock-free)
+
+@param [in,out] *queue  The queue to remove element from
+@param [out]    **data  The dequeued data
+
+@return 0 if dequeue operation was successful, otherwise -1 (queue empty)
+*/
+int mpmcqueue_try_dequeue(MPMCQueue_t *queue, void **data);
+
+/**
+Function to add an element to the end of the queue, waiting while it is full
+
+Spins briefly, then yields the CPU between attempts.
+
+@param [in,out] *queue  The queue to add element to
+@param [in]     *data   The data to enqueue
+
+@return 0 once the element is enqueued
+*/
+int mpmcqueue_enqueue(MPMCQueue_t *queue, const void *data);
+
+/**
+Function to remove an element from the front of the queue, waiting while it
+is empty
+
+Spins briefly, then yields the CPU between attempts.
+
+@param [in,out] *queue  The queue to remove element from
+@param [out]    **data  The dequeued data
+
+@return 0 once an element is dequeued
+*/
+int mpmcqueue_dequeue(MPMCQueue_t *queue, void **data);
+
+/**
+MACRO that evaluates to the approximate number of elements in the queue
+
+Counts claimed positions, so it is only a snapshot while other threads are
+active.
+*/
+#define mpmcqueue_size(queue) \
+  ((int)(atomic_load_explicit(&(queue)->enqueue_pos, memory_order_relaxed) - \
+         atomic_load_explicit(&(queue)->dequeue_pos, memory_order_relaxed)))
+
+#ifdef __cplusplus
+}
+#endif
+#endif // MPMCQUEUE_h
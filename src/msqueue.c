@@ -0,0 +1,236 @@
+/**
+@file msqueue.c
+
+See header
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "msqueue.h"
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static MSQueue_Element_t *msqueue_alloc(MSQueue_Handle_t *handle);
+static void msqueue_recycle(void *ptr, void *context);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+int msqueue_init(MSQueue_t *queue, void (*destroy)(void *data))
+{
+  MSQueue_Element_t *dummy;
+
+  if ((dummy = (MSQueue_Element_t *)malloc(sizeof (MSQueue_Element_t))) == NULL)
+    return -1;
+
+  dummy->data = NULL;
+  atomic_init(&dummy->next, NULL);
+
+  atomic_init(&queue->head, dummy);
+  atomic_init(&queue->tail, dummy);
+  queue->destroy = destroy;
+
+  epoch_init(&queue->epoch);
+
+  return 0;
+}
+
+
+void msqueue_destroy(MSQueue_t *queue)
+{
+  MSQueue_Element_t *element;
+  MSQueue_Element_t *next;
+
+  // The first element is the dummy, whose data has already been dequeued
+  element = atomic_load(&queue->head);
+  next = atomic_load(&element->next);
+  free(element);
+
+  for (element = next; element != NULL; element = next) {
+    next = atomic_load(&element->next);
+    if (queue->destroy != NULL)
+      queue->destroy(element->data);
+    free(element);
+  }
+
+  epoch_destroy(&queue->epoch);
+
+  // No operations permitted at this point -- clear memory as precaution
+  memset(queue, 0, sizeof (MSQueue_t));
+}
+
+
+int msqueue_register(MSQueue_t *queue, MSQueue_Handle_t *handle)
+{
+  if ((handle->record = epoch_register(&queue->epoch)) == NULL)
+    return -1;
+
+  handle->queue = queue;
+  handle->cache = NULL;
+  handle->cached = 0;
+
+  return 0;
+}
+
+
+void msqueue_unregister(MSQueue_Handle_t *handle)
+{
+  MSQueue_Element_t *element;
+
+  // Pull every element this thread retired back into the cache first
+  epoch_unregister(handle->record);
+
+  while ((element = handle->cache) != NULL) {
+    handle->cache = atomic_load_explicit(&element->next, memory_order_relaxed);
+    free(element);
+  }
+
+  // No operations permitted at this point -- clear memory as precaution
+  memset(handle, 0, sizeof (MSQueue_Handle_t));
+}
+
+
+int msqueue_enqueue(MSQueue_Handle_t *handle, const void *data)
+{
+  MSQueue_t *queue = handle->queue;
+  MSQueue_Element_t *new_element;
+  MSQueue_Element_t *tail;
+  MSQueue_Element_t *next;
+
+  if ((new_element = msqueue_alloc(handle)) == NULL)
+    return -1;
+
+  new_element->data = (void *)data;
+  atomic_store_explicit(&new_element->next, NULL, memory_order_relaxed);
+
+  epoch_enter(handle->record);
+
+  for (;;) {
+    tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+    next = atomic_load_explicit(&tail->next, memory_order_acquire);
+
+    if (tail != atomic_load_explicit(&queue->tail, memory_order_acquire))
+      continue;
+
+    if (next == NULL) {
+      // Tail really is last -- link the new element after it
+      if (atomic_compare_exchange_weak_explicit(&tail->next, &next, new_element, 
+          memory_order_release, memory_order_relaxed))
+        break;
+    }
+    else {
+      // Tail is lagging -- help it along before trying again
+      atomic_compare_exchange_weak_explicit(&queue->tail, &tail, next, 
+        memory_order_release, memory_order_relaxed);
+    }
+  }
+
+  // Swing the tail to the new element (fine if another thread already did)
+  atomic_compare_exchange_strong_explicit(&queue->tail, &tail, new_element, 
+    memory_order_release, memory_order_relaxed);
+
+  epoch_exit(handle->record);
+
+  return 0;
+}
+
+
+int msqueue_dequeue(MSQueue_Handle_t *handle, void **data)
+{
+  MSQueue_t *queue = handle->queue;
+  MSQueue_Element_t *head;
+  MSQueue_Element_t *tail;
+  MSQueue_Element_t *next;
+  void *value;
+
+  epoch_enter(handle->record);
+
+  for (;;) {
+    head = atomic_load_explicit(&queue->head, memory_order_acquire);
+    tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+    next = atomic_load_explicit(&head->next, memory_order_acquire);
+
+    if (head != atomic_load_explicit(&queue->head, memory_order_acquire))
+      continue;
+
+    if (head == tail) {
+      if (next == NULL) {
+        // Only the dummy is left
+        epoch_exit(handle->record);
+        return -1;
+      }
+
+      // Tail is lagging -- help it along before trying again
+      atomic_compare_exchange_weak_explicit(&queue->tail, &tail, next, 
+        memory_order_release, memory_order_relaxed);
+    }
+    else {
+      // Read the data before the element can become somebody else's dummy
+      value = next->data;
+      if (atomic_compare_exchange_weak_explicit(&queue->head, &head, next, 
+          memory_order_acq_rel, memory_order_relaxed))
+        break;
+    }
+  }
+
+  epoch_exit(handle->record);
+
+  // The old dummy is unlinked, but others may still be looking at it
+  epoch_retire(handle->record, head, msqueue_recycle, handle);
+
+  *data = value;
+
+  return 0;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+/**
+Take an element from the handle's cache, or allocate one if it is empty
+
+@param [in,out] *handle  The calling thread's handle
+
+@return the element, or NULL if memory could not be allocated
+*/
+static MSQueue_Element_t *msqueue_alloc(MSQueue_Handle_t *handle)
+{
+  MSQueue_Element_t *element;
+
+  if ((element = handle->cache) == NULL)
+    return (MSQueue_Element_t *)malloc(sizeof (MSQueue_Element_t));
+
+  handle->cache = atomic_load_explicit(&element->next, memory_order_relaxed);
+  handle->cached--;
+
+  return element;
+}
+
+
+/**
+Reclaim callback returning a retired element to the handle's cache
+
+@param [in] *ptr      The retired element
+@param [in] *context  The handle of the thread which retired it
+*/
+static void msqueue_recycle(void *ptr, void *context)
+{
+  MSQueue_Handle_t *handle = (MSQueue_Handle_t *)context;
+  MSQueue_Element_t *element = (MSQueue_Element_t *)ptr;
+
+  if (handle->cached >= MSQUEUE_CACHE_SIZE) {
+    free(element);
+    return;
+  }
+
+  atomic_store_explicit(&element->next, handle->cache, memory_order_relaxed);
+  handle->cache = element;
+  handle->cached++;
+}
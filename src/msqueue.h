@@ -0,0 +1,175 @@
+/** 
+@file msqueue.h
+@brief 
+Definitions of an unbounded lock-free queue (Michael-Scott queue)
+
+The queue keeps the singly-linked element layout of Queue_t, except that each
+element's _next_ pointer is atomic and the list always starts with a dummy
+element. Producers link new elements after the tail with a compare-and-swap,
+consumers swing the head forward with another, and either side helps a lagging
+tail along. Dequeued elements are retired through an epoch domain (see
+epoch.h), and once no thread can reference them they are returned to a node
+cache in the handle of the thread that dequeued them, so a steady stream of
+enqueue/dequeue calls does not go through malloc and free.
+
+Each thread accesses the queue through its own MSQueue_Handle_t.
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#ifndef MSQUEUE_h
+#define MSQUEUE_h
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#include "epoch.h"
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+/**
+The assumed size of a cache line, used to keep the two ends of the queue apart
+*/
+#ifndef MSQUEUE_CACHE_LINE
+#define MSQUEUE_CACHE_LINE 64
+#endif
+
+/**
+Maximum number of free elements a handle keeps for reuse
+*/
+#ifndef MSQUEUE_CACHE_SIZE
+#define MSQUEUE_CACHE_SIZE 256
+#endif
+
+/**
+@struct MSQueue_Element_t
+Element in the queue's linked-list
+*/
+typedef struct MSQueue_Element_T {
+  void *data;
+  _Atomic(struct MSQueue_Element_T *) next;
+} MSQueue_Element_t;
+
+/**
+@struct MSQueue_t
+Unbounded lock-free multi-producer/multi-consumer queue
+*/
+typedef struct MSQueue_T {
+  _Alignas(MSQUEUE_CACHE_LINE)
+  _Atomic(MSQueue_Element_t *) head; ///< Dummy element before the first element
+
+  _Alignas(MSQUEUE_CACHE_LINE)
+  _Atomic(MSQueue_Element_t *) tail; ///< Last element (or lagging by one)
+
+  _Alignas(MSQUEUE_CACHE_LINE)
+  void (*destroy)(void *data);
+
+  Epoch_t epoch; ///< Reclamation domain for dequeued elements
+
+} MSQueue_t;
+
+/**
+@struct MSQueue_Handle_t
+Per-thread access to a queue
+*/
+typedef struct MSQueue_Handle_T {
+  MSQueue_t *queue;
+  Epoch_Record_t *record;   ///< The thread's record in the queue's epoch domain
+  MSQueue_Element_t *cache; ///< Free elements ready for reuse
+  int cached;               ///< Number of elements in _cache_
+} MSQueue_Handle_t;
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/**
+Function to initialize a lock-free queue
+
+@pre
+Must be called before queue can be used by any other operation, and before
+any thread registers with it
+
+The _destroy_ argument provides a way to free dynamically allocated data when
+*msqueue_destroy* is called, or NULL if the data should not be freed.
+
+Complexity: O(1)
+
+@param [out] *queue     The queue to init
+@param [in] (*destroy)  Function pointer to free data element memory
+
+@return 0 if queue init successful, otherwise -1
+*/
+int msqueue_init(MSQueue_t *queue, void (*destroy)(void *data));
+
+/**
+Function to destroy a lock-free queue
+
+Calls the function passed as _destroy_ to *msqueue_init* once for each element
+still in the queue, provided _destroy_ was not set to NULL.
+
+@pre
+Every handle must have been unregistered
+
+Complexity: O(n)
+
+@param [in,out] *queue  The queue to destroy
+*/
+void msqueue_destroy(MSQueue_t *queue);
+
+/**
+Function to set up a thread's handle on the queue
+
+Complexity: O(t) where t is the number of threads ever registered
+
+@param [in,out] *queue   The queue to access
+@param [out]    *handle  The handle to init
+
+@return 0 if registration successful, otherwise -1
+*/
+int msqueue_register(MSQueue_t *queue, MSQueue_Handle_t *handle);
+
+/**
+Function to release a thread's handle on the queue
+
+Waits until the elements this thread dequeued can be reclaimed, then frees the
+handle's node cache.
+
+@param [in,out] *handle  The handle to release
+*/
+void msqueue_unregister(MSQueue_Handle_t *handle);
+
+/**
+Function to add an element to the end of the queue
+
+Complexity: O(1) (lock-free)
+
+@param [in,out] *handle  The calling thread's handle
+@param [in]     *data    The data to enqueue
+
+@return 0 if enqueue operation was successful, otherwise -1
+*/
+int msqueue_enqueue(MSQueue_Handle_t *handle, const void *data);
+
+/**
+Function to remove an element from the front of the queue
+
+Complexity: O(1) (lock-free)
+
+@param [in,out] *handle  The calling thread's handle
+@param [out]    **data   The dequeued data
+
+@return 0 if dequeue operation was successful, otherwise -1 (queue empty)
+*/
+int msqueue_dequeue(MSQueue_Handle_t *handle, void **data);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // MSQUEUE_h
@@ -0,0 +1,138 @@
+/**
+@file pool.c
+
+See header
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "pool.h"
+
+// -----------------------------------------------------------------------------
+// Local Definitions
+// -----------------------------------------------------------------------------
+
+/**
+Alignment of each block (enough for pointers, doubles and 64-bit integers)
+*/
+#define POOL_ALIGN 16
+
+/**
+Size of the chunk header, rounded up so the first block is aligned
+*/
+#define POOL_HEADER_SIZE (((sizeof (Pool_Chunk_t) + POOL_ALIGN - 1) / POOL_ALIGN) * POOL_ALIGN)
+
+// -----------------------------------------------------------------------------
+// Local Function Prototypes
+// -----------------------------------------------------------------------------
+
+static void *pool_allocator_alloc(void *context, size_t size);
+static void pool_allocator_free(void *context, void *ptr);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+int pool_init(Pool_t *pool, size_t size, int blocks)
+{
+  if (size == 0 || blocks <= 0)
+    return -1;
+
+  // Every block must be able to hold the free-list link
+  if (size < sizeof (void *))
+    size = sizeof (void *);
+
+  pool->size = ((size + POOL_ALIGN - 1) / POOL_ALIGN) * POOL_ALIGN;
+  pool->blocks = blocks;
+
+  pool->free_list = NULL;
+  pool->next_block = NULL;
+  pool->chunk_end = NULL;
+  pool->chunks = NULL;
+
+  pool->allocator.alloc = pool_allocator_alloc;
+  pool->allocator.free = pool_allocator_free;
+  pool->allocator.context = pool;
+
+  return 0;
+}
+
+
+void pool_destroy(Pool_t *pool)
+{
+  Pool_Chunk_t *chunk;
+
+  // Free each chunk
+  while ((chunk = pool->chunks) != NULL) {
+    pool->chunks = chunk->next;
+    free(chunk);
+  }
+
+  // No operations permitted at this point -- clear memory as precaution
+  memset(pool, 0, sizeof (Pool_t));
+}
+
+
+void *pool_alloc(Pool_t *pool)
+{
+  Pool_Chunk_t *chunk;
+  void *block;
+
+  // Reuse the most recently released block
+  if ((block = pool->free_list) != NULL) {
+    pool->free_list = *(void **)block;
+    return block;
+  }
+
+  // Add a chunk once the current one is used up
+  if (pool->next_block == pool->chunk_end) {
+    if ((chunk = (Pool_Chunk_t *)malloc(POOL_HEADER_SIZE + pool->size * pool->blocks)) == NULL)
+      return NULL;
+
+    chunk->next = pool->chunks;
+    pool->chunks = chunk;
+
+    pool->next_block = (char *)chunk + POOL_HEADER_SIZE;
+    pool->chunk_end = pool->next_block + pool->size * pool->blocks;
+  }
+
+  // Carve the next block off the chunk
+  block = pool->next_block;
+  pool->next_block += pool->size;
+
+  return block;
+}
+
+
+void pool_free(Pool_t *pool, void *ptr)
+{
+  if (ptr == NULL)
+    return;
+
+  // Push the block onto the free-list
+  *(void **)ptr = pool->free_list;
+  pool->free_list = ptr;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+static void *pool_allocator_alloc(void *context, size_t size)
+{
+  Pool_t *pool = (Pool_t *)context;
+
+  if (size > pool->size)
+    return NULL;
+
+  return pool_alloc(pool);
+}
+
+
+static void pool_allocator_free(void *context, void *ptr)
+{
+  pool_free((Pool_t *)context, ptr);
+}
@@ -0,0 +1,125 @@
+/** 
+@file pool.h
+@brief 
+Definitions of a fixed-size block pool allocator
+
+A pool hands out blocks of one size carved from large contiguous chunks, and
+keeps released blocks on a free-list for reuse. Both allocation and release
+are O(1) and never call _malloc_ except to add a chunk. Nodes allocated one
+after another sit next to each other in memory, which helps traversals.
+
+The pool is not thread safe; each pool should be used by one thread at a time.
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#ifndef POOL_h
+#define POOL_h
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdlib.h>
+
+#include "alloc.h"
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+/**
+@struct Pool_Chunk_t
+Header of a contiguous chunk of blocks
+*/
+typedef struct Pool_Chunk_T {
+  struct Pool_Chunk_T *next; ///< Pointer to the previously allocated chunk
+
+} Pool_Chunk_t;
+
+/**
+@struct Pool_t
+Fixed-size block pool
+*/
+typedef struct Pool_T {
+  size_t size; ///< Size of each block (rounded up for alignment)
+  int blocks;  ///< Number of blocks in each chunk
+
+  void *free_list;     ///< Released blocks, each holding a pointer to the next
+  char *next_block;    ///< Next never used block in the newest chunk
+  char *chunk_end;     ///< End of the newest chunk
+  Pool_Chunk_t *chunks; ///< All chunks allocated so far
+
+  Allocator_t allocator; ///< Allocator interface handing out blocks of this pool
+
+} Pool_t;
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/**
+Function to initialize a pool
+
+@pre
+Must be called before pool can be used by any other operation
+
+Blocks of _size_ bytes are handed out, taken from chunks of _blocks_ blocks
+each. No memory is allocated until the first block is requested. To share one
+pool between several kinds of containers, use the size of the largest element
+(e.g. sizeof (DList_Element_t)).
+
+Complexity: O(1)
+
+@param [out] *pool    The pool to init
+@param [in]   size    The size of each block in bytes
+@param [in]   blocks  The number of blocks allocated at once
+
+@return 0 if pool init successful, otherwise -1
+*/
+int pool_init(Pool_t *pool, size_t size, int blocks);
+
+/**
+Function to destroy a pool
+
+Releases every chunk of the pool. All blocks handed out by the pool become
+invalid, so any container using the pool must be destroyed first.
+
+Complexity: O(c), where *c* is the number of chunks allocated
+
+@param [in,out] *pool  The pool to destroy
+*/
+void pool_destroy(Pool_t *pool);
+
+/**
+Function to allocate a block from a pool
+
+Complexity: O(1) amortized
+
+@param [in,out] *pool  The pool to allocate from
+
+@return pointer to the block, otherwise NULL
+*/
+void *pool_alloc(Pool_t *pool);
+
+/**
+Function to release a block back to a pool
+
+Complexity: O(1)
+
+@param [in,out] *pool  The pool the block came from
+@param [in]     *ptr   The block to release
+*/
+void pool_free(Pool_t *pool, void *ptr);
+
+/**
+MACRO that evaluates to an *Allocator_t* handing out blocks of the pool
+
+Requests for more than the block size of the pool fail.
+*/
+#define pool_allocator(pool) ((const Allocator_t *)&(pool)->allocator)
+
+#ifdef __cplusplus
+}
+#endif
+#endif // POOL_h
@@ -0,0 +1,365 @@
+/**
+@file pqueue.c
+
+See header
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "pqueue.h"
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+#define PQUEUE_PARENT(index) (((index) - 1) / PQUEUE_ARITY)
+#define PQUEUE_CHILD(index)  (PQUEUE_ARITY * (index) + 1)
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static int pqueue_reserve(PQueue_t *pqueue, int n);
+static int pqueue_new_handle(PQueue_t *pqueue);
+static void pqueue_free_handle(PQueue_t *pqueue, int handle);
+static void pqueue_move(PQueue_t *pqueue, int from, int to);
+static void pqueue_place(PQueue_t *pqueue, int index, void *data, int handle);
+static void pqueue_sift_up(PQueue_t *pqueue, int index, void *data, int handle);
+static void pqueue_sift_down(PQueue_t *pqueue, int index, void *data, int handle);
+static void pqueue_fix(PQueue_t *pqueue, int index, void *data, int handle);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void pqueue_init(PQueue_t *pqueue, int (*compare)(const void *key1, const void *key2), 
+  void (*destroy)(void *data))
+{
+  pqueue->size = 0;
+  pqueue->capacity = 0;
+  pqueue->compare = compare;
+  pqueue->destroy = destroy;
+  pqueue->items = NULL;
+  pqueue->heap_handles = NULL;
+  pqueue->positions = NULL;
+  pqueue->handles = 0;
+  pqueue->free_handle = -1;
+}
+
+
+void pqueue_destroy(PQueue_t *pqueue)
+{
+  int i;
+
+  // Destroy each element in the queue
+  if (pqueue->destroy != NULL) {
+    for (i = 0; i < pqueue->size; i++)
+      pqueue->destroy(pqueue->items[i]);
+  }
+
+  free(pqueue->items);
+  free(pqueue->heap_handles);
+  free(pqueue->positions);
+
+  // No operations permitted at this point -- clear memory as precaution
+  memset(pqueue, 0, sizeof (PQueue_t));
+}
+
+
+int pqueue_insert(PQueue_t *pqueue, const void *data)
+{
+  int handle;
+
+  return pqueue_insert_handle(pqueue, data, &handle);
+}
+
+
+int pqueue_insert_handle(PQueue_t *pqueue, const void *data, int *handle)
+{
+  if (pqueue_reserve(pqueue, 1) != 0)
+    return -1;
+
+  *handle = pqueue_new_handle(pqueue);
+
+  // Start at the first free leaf and work up
+  pqueue_sift_up(pqueue, pqueue->size++, (void *)data, *handle);
+
+  return 0;
+}
+
+
+int pqueue_build(PQueue_t *pqueue, void *const *data, int n, int *handles)
+{
+  int handle;
+  int i;
+
+  if (n < 0 || pqueue_reserve(pqueue, n) != 0)
+    return -1;
+
+  // Append everything without regard to order...
+  for (i = 0; i < n; i++) {
+    handle = pqueue_new_handle(pqueue);
+    pqueue_place(pqueue, pqueue->size++, data[i], handle);
+
+    if (handles != NULL)
+      handles[i] = handle;
+  }
+
+  // ...then sift down every internal node, deepest first (Floyd's method)
+  if (pqueue->size > 1) {
+    for (i = PQUEUE_PARENT(pqueue->size - 1); i >= 0; i--)
+      pqueue_sift_down(pqueue, i, pqueue->items[i], pqueue->heap_handles[i]);
+  }
+
+  return 0;
+}
+
+
+int pqueue_extract(PQueue_t *pqueue, void **data)
+{
+  if (pqueue->size == 0)
+    return -1;
+
+  *data = pqueue->items[0];
+  pqueue_free_handle(pqueue, pqueue->heap_handles[0]);
+
+  // Fill the hole at the root with the last leaf
+  if (--pqueue->size > 0) {
+    pqueue_sift_down(pqueue, 0, pqueue->items[pqueue->size], 
+      pqueue->heap_handles[pqueue->size]);
+  }
+
+  return 0;
+}
+
+
+int pqueue_update(PQueue_t *pqueue, int handle)
+{
+  int index;
+
+  if (!pqueue_is_queued(pqueue, handle))
+    return -1;
+
+  index = pqueue->positions[handle];
+  pqueue_fix(pqueue, index, pqueue->items[index], handle);
+
+  return 0;
+}
+
+
+int pqueue_remove(PQueue_t *pqueue, int handle, void **data)
+{
+  int index;
+
+  if (!pqueue_is_queued(pqueue, handle))
+    return -1;
+
+  index = pqueue->positions[handle];
+
+  *data = pqueue->items[index];
+  pqueue_free_handle(pqueue, handle);
+
+  // Fill the hole with the last leaf, which may belong above or below it
+  if (index != --pqueue->size) {
+    pqueue_fix(pqueue, index, pqueue->items[pqueue->size], 
+      pqueue->heap_handles[pqueue->size]);
+  }
+
+  return 0;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+/**
+Make sure _n_ more elements fit, doubling the capacity as needed
+
+@param [in,out] *pqueue  The queue
+@param [in]      n       The number of elements about to be inserted
+
+@return 0 if there is room, otherwise -1
+*/
+static int pqueue_reserve(PQueue_t *pqueue, int n)
+{
+  void **items;
+  int *heap_handles;
+  int *positions;
+  int capacity;
+
+  if (pqueue->size + n <= pqueue->capacity)
+    return 0;
+
+  capacity = pqueue->capacity > 0 ? pqueue->capacity : PQUEUE_MIN_CAPACITY;
+  while (capacity < pqueue->size + n)
+    capacity *= 2;
+
+  // Each array is only adopted once reallocated, so a failure part way leaves
+  // the queue usable at its old capacity
+  if ((items = (void **)realloc(pqueue->items, capacity * sizeof (void *))) == NULL)
+    return -1;
+  pqueue->items = items;
+
+  if ((heap_handles = (int *)realloc(pqueue->heap_handles, capacity * sizeof (int))) == NULL)
+    return -1;
+  pqueue->heap_handles = heap_handles;
+
+  if ((positions = (int *)realloc(pqueue->positions, capacity * sizeof (int))) == NULL)
+    return -1;
+  pqueue->positions = positions;
+
+  pqueue->capacity = capacity;
+
+  return 0;
+}
+
+
+/**
+Give out a handle, reusing a free one first
+
+There is always one available, as handles in use never outnumber elements and
+the capacity has already been reserved.
+
+@param [in,out] *pqueue  The queue
+
+@return the handle
+*/
+static int pqueue_new_handle(PQueue_t *pqueue)
+{
+  int handle;
+
+  if ((handle = pqueue->free_handle) < 0)
+    return pqueue->handles++;
+
+  // Free handles are chained through their positions as -2 - next
+  pqueue->free_handle = -2 - pqueue->positions[handle];
+
+  return handle;
+}
+
+
+/**
+Return a handle to the free chain
+
+@param [in,out] *pqueue  The queue
+@param [in]      handle  The handle
+*/
+static void pqueue_free_handle(PQueue_t *pqueue, int handle)
+{
+  pqueue->positions[handle] = -2 - pqueue->free_handle;
+  pqueue->free_handle = handle;
+}
+
+
+/**
+Move the element at heap position _from_ to position _to_
+
+@param [in,out] *pqueue  The queue
+@param [in]      from    The position to move from
+@param [in]      to      The position to move to
+*/
+static void pqueue_move(PQueue_t *pqueue, int from, int to)
+{
+  pqueue->items[to] = pqueue->items[from];
+  pqueue->heap_handles[to] = pqueue->heap_handles[from];
+  pqueue->positions[pqueue->heap_handles[to]] = to;
+}
+
+
+/**
+Store an element at a heap position
+
+@param [in,out] *pqueue  The queue
+@param [in]      index   The position
+@param [in]     *data    The element
+@param [in]      handle  The element's handle
+*/
+static void pqueue_place(PQueue_t *pqueue, int index, void *data, int handle)
+{
+  pqueue->items[index] = data;
+  pqueue->heap_handles[index] = handle;
+  pqueue->positions[handle] = index;
+}
+
+
+/**
+Move an element up from a hole at _index_ to where it belongs
+
+Parents are shifted down into the hole rather than swapped, so the element is
+only written once.
+
+@param [in,out] *pqueue  The queue
+@param [in]      index   The position of the hole
+@param [in]     *data    The element to place
+@param [in]      handle  The element's handle
+*/
+static void pqueue_sift_up(PQueue_t *pqueue, int index, void *data, int handle)
+{
+  int parent;
+
+  while (index > 0) {
+    parent = PQUEUE_PARENT(index);
+    if (pqueue->compare(data, pqueue->items[parent]) >= 0)
+      break;
+
+    pqueue_move(pqueue, parent, index);
+    index = parent;
+  }
+
+  pqueue_place(pqueue, index, data, handle);
+}
+
+
+/**
+Move an element down from a hole at _index_ to where it belongs
+
+@param [in,out] *pqueue  The queue
+@param [in]      index   The position of the hole
+@param [in]     *data    The element to place
+@param [in]      handle  The element's handle
+*/
+static void pqueue_sift_down(PQueue_t *pqueue, int index, void *data, int handle)
+{
+  int child;
+  int last;
+  int best;
+
+  while ((child = PQUEUE_CHILD(index)) < pqueue->size) {
+    // Find the highest priority of the (up to) four siblings
+    last = child + PQUEUE_ARITY < pqueue->size ? child + PQUEUE_ARITY : pqueue->size;
+
+    for (best = child++; child < last; child++) {
+      if (pqueue->compare(pqueue->items[child], pqueue->items[best]) < 0)
+        best = child;
+    }
+
+    if (pqueue->compare(pqueue->items[best], data) >= 0)
+      break;
+
+    pqueue_move(pqueue, best, index);
+    index = best;
+  }
+
+  pqueue_place(pqueue, index, data, handle);
+}
+
+
+/**
+Place an element into a hole at _index_, sifting in whichever direction it
+needs to go
+
+@param [in,out] *pqueue  The queue
+@param [in]      index   The position of the hole
+@param [in]     *data    The element to place
+@param [in]      handle  The element's handle
+*/
+static void pqueue_fix(PQueue_t *pqueue, int index, void *data, int handle)
+{
+  if (index > 0 && pqueue->compare(data, pqueue->items[PQUEUE_PARENT(index)]) < 0)
+    pqueue_sift_up(pqueue, index, data, handle);
+  else
+    pqueue_sift_down(pqueue, index, data, handle);
+}
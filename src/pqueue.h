@@ -0,0 +1,209 @@
+/** 
+@file pqueue.h
+@brief 
+Definitions of a generic priority queue ADT
+
+The priority queue is a 4-ary min-heap stored in a contiguous array of
+pointers. Compared to a binary heap the tree is half as deep, and the four
+children of a node sit next to each other in memory, so sifting down touches
+fewer cache lines at the cost of a few extra comparisons per level.
+
+Every element is also given an integer handle when it is inserted. A handle
+stays valid until its element leaves the queue, and can be used to locate the
+element in O(1), for example to re-sift it after its key has been decreased
+(as in Dijkstra's algorithm) or to remove it early.
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#ifndef PQUEUE_h
+#define PQUEUE_h
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdlib.h>
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+/**
+Number of children of each node in the heap
+*/
+#define PQUEUE_ARITY 4
+
+/**
+Number of elements allocated the first time the queue is used
+*/
+#define PQUEUE_MIN_CAPACITY 16
+
+/**
+@struct PQueue_t
+Generic priority queue
+*/
+typedef struct PQueue_T {
+  int size;     ///< Number of elements in queue
+  int capacity; ///< Number of elements that fit before growing
+
+  int (*compare)(const void *key1, const void *key2);
+  void (*destroy)(void *data);
+
+  void **items;      ///< Heap of elements, highest priority first
+  int *heap_handles; ///< Handle of the element at each heap position
+  int *positions;    ///< Heap position of each handle (negative when free)
+
+  int handles;     ///< Number of handles ever given out
+  int free_handle; ///< First handle free for reuse (or -1)
+
+} PQueue_t;
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/**
+Function to initialize a priority queue
+
+@pre
+Must be called before queue can be used by any other operation
+
+The _compare_ argument orders the elements like the comparison function of
+qsort: it returns a negative value if _key1_ should leave the queue before
+_key2_, a positive value if after, and 0 if either order will do. The
+_destroy_ argument provides a way to free dynamically allocated data when
+*pqueue_destroy* is called, or NULL if the data should not be freed.
+
+No memory is allocated until the first element is inserted.
+
+Complexity: O(1)
+
+@param [out] *pqueue    The queue to init
+@param [in] (*compare)  Function pointer to order two elements
+@param [in] (*destroy)  Function pointer to free data element memory
+*/
+void pqueue_init(PQueue_t *pqueue, int (*compare)(const void *key1, const void *key2), 
+  void (*destroy)(void *data));
+
+/**
+Function to destroy a priority queue
+
+The *pqueue_destroy* operation removes all elements from the queue and calls
+the function passed as _destroy_ to *pqueue_init* once for each element as it
+is removed, provided _destroy_ was not set to NULL.
+
+Complexity: O(n)
+
+@param [in,out] *pqueue  The queue to destroy
+*/
+void pqueue_destroy(PQueue_t *pqueue);
+
+/**
+Function to insert an element into the queue
+
+Complexity: O(log n)
+
+@param [in,out] *pqueue  The queue to insert element into
+@param [in]     *data    The data to insert
+
+@return 0 if insert operation was successful, otherwise -1
+*/
+int pqueue_insert(PQueue_t *pqueue, const void *data);
+
+/**
+Function to insert an element into the queue and obtain its handle
+
+Complexity: O(log n)
+
+@param [in,out] *pqueue  The queue to insert element into
+@param [in]     *data    The data to insert
+@param [out]    *handle  The handle of the new element
+
+@return 0 if insert operation was successful, otherwise -1
+*/
+int pqueue_insert_handle(PQueue_t *pqueue, const void *data, int *handle);
+
+/**
+Function to insert many elements at once
+
+The elements are appended as they are and the whole heap is then rebuilt
+bottom-up, which is cheaper than inserting them one at a time.
+
+Complexity: O(n + m) where m is the number of elements inserted
+
+@param [in,out] *pqueue   The queue to insert elements into
+@param [in]     **data    The data to insert
+@param [in]       n       The number of elements in _data_
+@param [out]    *handles  Array receiving the handles of the new elements (may
+                          be NULL)
+
+@return 0 if insert operation was successful, otherwise -1 (nothing inserted)
+*/
+int pqueue_build(PQueue_t *pqueue, void *const *data, int n, int *handles);
+
+/**
+Function to remove the element with the highest priority
+
+Complexity: O(log n)
+
+@param [in,out] *pqueue  The queue to remove element from
+@param [out]    **data   The removed data
+
+@return 0 if extract operation was successful, otherwise -1 (queue empty)
+*/
+int pqueue_extract(PQueue_t *pqueue, void **data);
+
+/**
+Function to restore the order of the queue after an element's key changed
+
+Call this after changing the key of the element with _handle_ in place, in
+either direction; decreasing a key is the usual case.
+
+Complexity: O(log n)
+
+@param [in,out] *pqueue  The queue holding the element
+@param [in]      handle  The handle of the element
+
+@return 0 if update operation was successful, otherwise -1 (invalid handle)
+*/
+int pqueue_update(PQueue_t *pqueue, int handle);
+
+/**
+Function to remove an element from anywhere in the queue
+
+Complexity: O(log n)
+
+@param [in,out] *pqueue  The queue to remove element from
+@param [in]      handle  The handle of the element
+@param [out]    **data   The removed data
+
+@return 0 if remove operation was successful, otherwise -1 (invalid handle)
+*/
+int pqueue_remove(PQueue_t *pqueue, int handle, void **data);
+
+/**
+MACRO that evaluates to the number of elements in the queue
+*/
+#define pqueue_size(pqueue) ((pqueue)->size)
+
+/**
+MACRO that evaluates to the element with the highest priority (or NULL)
+*/
+#define pqueue_peek(pqueue) ((pqueue)->size == 0 ? NULL : (pqueue)->items[0])
+
+/**
+MACRO that evaluates to true if _handle_ refers to an element in the queue
+*/
+#define pqueue_is_queued(pqueue, handle) \
+  ((handle) >= 0 && (handle) < (pqueue)->handles && (pqueue)->positions[handle] >= 0)
+
+/**
+MACRO that evaluates to the data of the element with _handle_
+*/
+#define pqueue_data(pqueue, handle) ((pqueue)->items[(pqueue)->positions[handle]])
+
+#ifdef __cplusplus
+}
+#endif
+#endif // PQUEUE_h
@@ -35,6 +35,12 @@ MACRO to init the queue. Functionally same as *list_init*
 */
 #define queue_init list_init
 
+/**
+MACRO to init the queue with an element allocator. Functionally same as 
+*list_init_allocator*
+*/
+#define queue_init_allocator list_init_allocator
+
 /**
 MACRO to destroy the queue. Functionally same as *list_destroy*
 */
@@ -0,0 +1,368 @@
+/**
+@file rcutable.c
+
+See header
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "rcutable.h"
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static RCUTable_Array_t *rcutable_alloc_array(int buckets);
+static void rcutable_free_chains(RCUTable_Array_t *array, void (*destroy)(void *data));
+static void rcutable_reclaim_element(void *ptr, void *context);
+static void rcutable_reclaim_array(void *ptr, void *context);
+static int rcutable_grow(RCUTable_t *table, RCUTable_Array_t *array);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+int rcutable_init(RCUTable_t *table, int buckets, 
+                  uint64_t (*hash)(const void *key),
+                  int (*match)(const void *a, const void *b),
+                  void (*destroy)(void *data))
+{
+  RCUTable_Array_t *array;
+  int n;
+
+  if (buckets <= 0)
+    return -1;
+
+  // Round the number of buckets up to a power of two
+  for (n = 1; n < buckets; n <<= 1)
+    ;
+
+  if ((array = rcutable_alloc_array(n)) == NULL)
+    return -1;
+
+  epoch_init(&table->epoch);
+
+  if ((table->writer = epoch_register(&table->epoch)) == NULL) {
+    epoch_destroy(&table->epoch);
+    free(array);
+    return -1;
+  }
+
+  atomic_init(&table->array, array);
+  atomic_init(&table->size, 0);
+  pthread_mutex_init(&table->lock, NULL);
+
+  table->hash = hash;
+  table->match = match;
+  table->destroy = destroy;
+
+  return 0;
+}
+
+
+void rcutable_destroy(RCUTable_t *table)
+{
+  RCUTable_Array_t *array;
+
+  array = atomic_load(&table->array);
+  rcutable_free_chains(array, table->destroy);
+  free(array);
+
+  // Frees whatever elements and arrays were still waiting in limbo
+  epoch_destroy(&table->epoch);
+  pthread_mutex_destroy(&table->lock);
+
+  // No operations permitted at this point -- clear memory as precaution
+  memset(table, 0, sizeof (RCUTable_t));
+}
+
+
+int rcutable_register(RCUTable_t *table, RCUTable_Handle_t *handle)
+{
+  if ((handle->record = epoch_register(&table->epoch)) == NULL)
+    return -1;
+
+  handle->table = table;
+
+  return 0;
+}
+
+
+void rcutable_unregister(RCUTable_Handle_t *handle)
+{
+  epoch_unregister(handle->record);
+
+  // No operations permitted at this point -- clear memory as precaution
+  memset(handle, 0, sizeof (RCUTable_Handle_t));
+}
+
+
+int rcutable_insert(RCUTable_t *table, const void *data)
+{
+  RCUTable_Array_t *array;
+  RCUTable_Element_t *element;
+  RCUTable_Element_t *head;
+  uint64_t hash;
+  int bucket;
+  int size;
+
+  hash = table->hash(data);
+
+  pthread_mutex_lock(&table->lock);
+
+  // Only writers change the array and the links, and they hold the lock
+  array = atomic_load_explicit(&table->array, memory_order_relaxed);
+  bucket = (int)(hash & (uint64_t)(array->buckets - 1));
+  head = atomic_load_explicit(&array->table[bucket], memory_order_relaxed);
+
+  // Do nothing if the data is already in the table
+  for (element = head; element != NULL; 
+       element = atomic_load_explicit(&element->next, memory_order_relaxed)) {
+    if (element->hash == hash && table->match(data, element->data)) {
+      pthread_mutex_unlock(&table->lock);
+      return 1;
+    }
+  }
+
+  if ((element = (RCUTable_Element_t *)malloc(sizeof (RCUTable_Element_t))) == NULL) {
+    pthread_mutex_unlock(&table->lock);
+    return -1;
+  }
+
+  element->data = (void *)data;
+  element->hash = hash;
+  atomic_init(&element->next, head);
+
+  // Publish the element; the release store makes its fields visible first
+  atomic_store_explicit(&array->table[bucket], element, memory_order_release);
+
+  size = atomic_load_explicit(&table->size, memory_order_relaxed) + 1;
+  atomic_store_explicit(&table->size, size, memory_order_relaxed);
+
+  // Grow once the load factor exceeds 1; a failed grow leaves a fuller table
+  if (size > array->buckets)
+    rcutable_grow(table, array);
+
+  pthread_mutex_unlock(&table->lock);
+
+  return 0;
+}
+
+
+int rcutable_remove(RCUTable_t *table, void **data)
+{
+  RCUTable_Array_t *array;
+  RCUTable_Element_t *element;
+  _Atomic(RCUTable_Element_t *) *link;
+  uint64_t hash;
+  int size;
+
+  hash = table->hash(*data);
+
+  pthread_mutex_lock(&table->lock);
+
+  array = atomic_load_explicit(&table->array, memory_order_relaxed);
+  link = &array->table[hash & (uint64_t)(array->buckets - 1)];
+
+  for (element = atomic_load_explicit(link, memory_order_relaxed); element != NULL; 
+       element = atomic_load_explicit(link, memory_order_relaxed)) {
+    if (element->hash == hash && table->match(*data, element->data)) {
+      // Swing the link past the element; the element keeps its own link, so
+      // readers standing on it still reach the rest of the chain
+      atomic_store_explicit(link, 
+        atomic_load_explicit(&element->next, memory_order_relaxed), 
+        memory_order_release);
+
+      *data = element->data;
+      epoch_retire(table->writer, element, rcutable_reclaim_element, NULL);
+
+      size = atomic_load_explicit(&table->size, memory_order_relaxed) - 1;
+      atomic_store_explicit(&table->size, size, memory_order_relaxed);
+
+      pthread_mutex_unlock(&table->lock);
+      return 0;
+    }
+    link = &element->next;
+  }
+
+  pthread_mutex_unlock(&table->lock);
+
+  return -1;
+}
+
+
+void rcutable_synchronize(RCUTable_t *table)
+{
+  pthread_mutex_lock(&table->lock);
+  epoch_synchronize(table->writer);
+  pthread_mutex_unlock(&table->lock);
+}
+
+
+int rcutable_lookup(RCUTable_Handle_t *handle, void **data)
+{
+  RCUTable_t *table = handle->table;
+  RCUTable_Array_t *array;
+  RCUTable_Element_t *element;
+  uint64_t hash;
+
+  hash = table->hash(*data);
+
+  epoch_enter(handle->record);
+
+  array = atomic_load_explicit(&table->array, memory_order_acquire);
+  element = atomic_load_explicit(&array->table[hash & (uint64_t)(array->buckets - 1)], 
+    memory_order_acquire);
+
+  for (; element != NULL; 
+       element = atomic_load_explicit(&element->next, memory_order_acquire)) {
+    if (element->hash == hash && table->match(*data, element->data)) {
+      *data = element->data;
+      epoch_exit(handle->record);
+      return 0;
+    }
+  }
+
+  epoch_exit(handle->record);
+
+  return -1;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+/**
+Allocate a bucket array with every chain empty
+
+@param [in] buckets  The number of buckets
+
+@return the array, or NULL if memory could not be allocated
+*/
+static RCUTable_Array_t *rcutable_alloc_array(int buckets)
+{
+  RCUTable_Array_t *array;
+  int i;
+
+  array = (RCUTable_Array_t *)malloc(sizeof (RCUTable_Array_t) + 
+    (size_t)buckets * sizeof (_Atomic(RCUTable_Element_t *)));
+  if (array == NULL)
+    return NULL;
+
+  array->buckets = buckets;
+  for (i = 0; i < buckets; i++)
+    atomic_init(&array->table[i], NULL);
+
+  return array;
+}
+
+
+/**
+Free every element on the chains of an array (but not the array itself)
+
+@param [in,out] *array     The array
+@param [in]    (*destroy)  Function to free the data, or NULL to keep it
+*/
+static void rcutable_free_chains(RCUTable_Array_t *array, void (*destroy)(void *data))
+{
+  RCUTable_Element_t *element;
+  RCUTable_Element_t *next;
+  int i;
+
+  for (i = 0; i < array->buckets; i++) {
+    element = atomic_load_explicit(&array->table[i], memory_order_relaxed);
+    for (; element != NULL; element = next) {
+      next = atomic_load_explicit(&element->next, memory_order_relaxed);
+      if (destroy != NULL)
+        destroy(element->data);
+      free(element);
+    }
+  }
+}
+
+
+/**
+Epoch reclaim callback for an element unlinked by *rcutable_remove()*
+
+@param [in,out] *ptr      The element
+@param [in]     *context  Unused
+*/
+static void rcutable_reclaim_element(void *ptr, void *context)
+{
+  (void)context;
+  free(ptr);
+}
+
+
+/**
+Epoch reclaim callback for an array replaced by *rcutable_grow()*
+
+The chains of a replaced array hold copies of the elements, so they are freed
+along with the array while the data is left alone.
+
+@param [in,out] *ptr      The array
+@param [in]     *context  Unused
+*/
+static void rcutable_reclaim_array(void *ptr, void *context)
+{
+  (void)context;
+  rcutable_free_chains((RCUTable_Array_t *)ptr, NULL);
+  free(ptr);
+}
+
+
+/**
+Double the number of buckets of the table
+
+The elements cannot be relinked in place, since a reader walking a chain could
+be led onto another chain and miss its key. Instead every element is copied
+into a new array, which is then published whole.
+
+@pre
+The writer lock is held
+
+@param [in,out] *table  The table
+@param [in,out] *array  The current array of the table
+
+@return 0 if the table grew, otherwise -1 (the table is unchanged)
+*/
+static int rcutable_grow(RCUTable_t *table, RCUTable_Array_t *array)
+{
+  RCUTable_Array_t *grown;
+  RCUTable_Element_t *element;
+  RCUTable_Element_t *copy;
+  int bucket;
+  int i;
+
+  if ((grown = rcutable_alloc_array(array->buckets * 2)) == NULL)
+    return -1;
+
+  for (i = 0; i < array->buckets; i++) {
+    element = atomic_load_explicit(&array->table[i], memory_order_relaxed);
+    for (; element != NULL; 
+         element = atomic_load_explicit(&element->next, memory_order_relaxed)) {
+      if ((copy = (RCUTable_Element_t *)malloc(sizeof (RCUTable_Element_t))) == NULL) {
+        rcutable_free_chains(grown, NULL);
+        free(grown);
+        return -1;
+      }
+
+      copy->data = element->data;
+      copy->hash = element->hash;
+
+      bucket = (int)(element->hash & (uint64_t)(grown->buckets - 1));
+      atomic_init(&copy->next, 
+        atomic_load_explicit(&grown->table[bucket], memory_order_relaxed));
+      atomic_store_explicit(&grown->table[bucket], copy, memory_order_relaxed);
+    }
+  }
+
+  // Publish the new array; readers already on the old one finish there
+  atomic_store_explicit(&table->array, grown, memory_order_release);
+  epoch_retire(table->writer, array, rcutable_reclaim_array, NULL);
+
+  return 0;
+}
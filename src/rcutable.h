@@ -0,0 +1,256 @@
+/** 
+@file rcutable.h
+@brief 
+Definitions of a read-mostly hash table with lock-free readers (RCU-style)
+
+The table is chained like HashTable_t (see hashtable.h), but readers take no
+lock and perform no atomic read-modify-write operation: they announce
+themselves in an epoch domain (see epoch.h), which only stores to the reader's
+own record, and then walk the bucket chains with acquire loads.
+
+Writers are serialized by a mutex. A new element is fully initialized before
+it is published at the head of its chain with a release store, and a removal
+swings a single link past the element, so a reader always sees either the old
+or the new chain and never a torn one. Unlinked elements are retired to the
+epoch domain and freed once no reader can still be walking over them. Growing
+the table copies every chain into a new bucket array, publishes the array and
+retires the old one whole, so readers that started on the old array finish on
+an unchanged snapshot.
+
+This suits tables read far more often than they are written, such as
+configuration or routing tables.
+
+Each reader thread accesses the table through its own RCUTable_Handle_t.
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#ifndef RCUTABLE_h
+#define RCUTABLE_h
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "epoch.h"
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+/**
+The assumed size of a cache line, used to keep the writer state away from the
+fields read on every lookup
+*/
+#ifndef RCUTABLE_CACHE_LINE
+#define RCUTABLE_CACHE_LINE 64
+#endif
+
+/**
+@struct RCUTable_Element_t
+Element in one of the chains of the table
+
+The element never changes after it is published, except for its _next_ link.
+*/
+typedef struct RCUTable_Element_T {
+  void *data;     ///< Pointer to data
+  uint64_t hash;  ///< Cached hash of the data
+
+  _Atomic(struct RCUTable_Element_T *) next; ///< Next element in the chain
+
+} RCUTable_Element_t;
+
+/**
+@struct RCUTable_Array_t
+Bucket array of the table, replaced whole when the table grows
+*/
+typedef struct RCUTable_Array_T {
+  int buckets; ///< The number of buckets (a power of two)
+
+  _Atomic(RCUTable_Element_t *) table[]; ///< Array of chains, one per bucket
+
+} RCUTable_Array_t;
+
+/**
+@struct RCUTable_t
+Hash table with lock-free readers and a single writer at a time
+*/
+typedef struct RCUTable_T {
+  _Atomic(RCUTable_Array_t *) array; ///< Current bucket array
+
+  uint64_t (*hash)(const void *key);
+  int (*match)(const void *a, const void *b);
+  void (*destroy)(void *data);
+
+  _Alignas(RCUTABLE_CACHE_LINE)
+  pthread_mutex_t lock;   ///< Serializes the writers
+  atomic_int size;        ///< The number of elements in the table
+  Epoch_Record_t *writer; ///< Record the writers retire elements through
+
+  Epoch_t epoch; ///< Reclamation domain for unlinked elements and arrays
+
+} RCUTable_t;
+
+/**
+@struct RCUTable_Handle_t
+Per-thread read access to a table
+*/
+typedef struct RCUTable_Handle_T {
+  RCUTable_t *table;
+  Epoch_Record_t *record; ///< The thread's record in the table's epoch domain
+} RCUTable_Handle_t;
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/**
+Function to initialize a read-mostly hash table
+
+@pre
+Must be called before table can be used by any other operation, and before
+any thread registers with it
+
+The number of buckets is rounded up to a power of two and the bucket is taken
+from the low bits of the hash. The table doubles whenever it holds more
+elements than buckets. The _hash_, _match_ and _destroy_ arguments are as for
+*hashtable_init()*.
+
+Complexity: O(m)
+
+@param [out] *table    The table to init
+@param [in]   buckets  The initial number of buckets
+@param [in]  *hash     Pointer to user hash function
+@param [in]  *match    Pointer to user hash key comparison function
+@param [in]  *destroy  Pointer to function to free element memory
+
+@return 0 if table init successful, otherwise -1
+*/
+int rcutable_init(RCUTable_t *table, int buckets, 
+                  uint64_t (*hash)(const void *key),
+                  int (*match)(const void *a, const void *b),
+                  void (*destroy)(void *data));
+
+/**
+Function to destroy a read-mostly hash table
+
+Calls the function passed as _destroy_ to *rcutable_init* once for each element
+still in the table, provided _destroy_ was not set to NULL.
+
+@pre
+Every handle must have been unregistered
+
+Complexity: O(n + m)
+
+@param [in,out] *table  The table to destroy
+*/
+void rcutable_destroy(RCUTable_t *table);
+
+/**
+Function to set up a reader thread's handle on the table
+
+Complexity: O(t) where t is the number of threads ever registered
+
+@param [in,out] *table   The table to read
+@param [out]    *handle  The handle to init
+
+@return 0 if registration successful, otherwise -1
+*/
+int rcutable_register(RCUTable_t *table, RCUTable_Handle_t *handle);
+
+/**
+Function to release a reader thread's handle on the table
+
+@param [in,out] *handle  The handle to release
+*/
+void rcutable_unregister(RCUTable_Handle_t *handle);
+
+/**
+Function to insert an element into the table
+
+Writers are serialized by the table's mutex; readers are never blocked.
+
+Complexity: O(1) amortized
+
+@param [in,out] *table  The table to insert into
+@param [in]     *data   The data to insert
+
+@return 0 if inserting the element was successful, 1 if the element was already
+in the table, otherwise -1
+*/
+int rcutable_insert(RCUTable_t *table, const void *data);
+
+/**
+Function to remove an element from the table
+
+The element is unlinked at once, but readers that found the data before may
+still be using it. The data returned belongs to the caller, who must call
+*rcutable_synchronize()* before freeing it.
+
+Complexity: O(1)
+
+@param [in,out] *table  The table to remove from
+@param [in,out] **data  The key to remove, then the data that was stored
+
+@return 0 if removing the element was successful, otherwise -1
+*/
+int rcutable_remove(RCUTable_t *table, void **data);
+
+/**
+Function to wait until every reader is past the elements removed so far
+
+@pre
+The calling thread must not be inside a read section of the table
+
+@param [in,out] *table  The table
+*/
+void rcutable_synchronize(RCUTable_t *table);
+
+/**
+Function to look up an element in the table (lock-free)
+
+The data found is only guaranteed to stay valid while the calling thread is
+inside a read section (see *rcutable_read_enter()*). Outside one, the lookup
+opens and closes a section of its own.
+
+Complexity: O(1)
+
+@param [in,out] *handle  The calling thread's handle
+@param [in,out] **data   The key to look up, then the data that was found
+
+@return 0 if the element was found, otherwise -1
+*/
+int rcutable_lookup(RCUTable_Handle_t *handle, void **data);
+
+/**
+MACRO to open a read section, during which data found by *rcutable_lookup()*
+cannot be reclaimed (sections nest)
+*/
+#define rcutable_read_enter(handle) epoch_enter((handle)->record)
+
+/**
+MACRO to close a read section opened by *rcutable_read_enter()*
+*/
+#define rcutable_read_exit(handle) epoch_exit((handle)->record)
+
+/**
+MACRO that evaluates to the number of elements in the table
+*/
+#define rcutable_size(table) \
+  atomic_load_explicit(&(table)->size, memory_order_relaxed)
+
+/**
+MACRO that evaluates to the current number of buckets in the table
+*/
+#define rcutable_buckets(table) \
+  (atomic_load_explicit(&(table)->array, memory_order_acquire)->buckets)
+
+#ifdef __cplusplus
+}
+#endif
+#endif // RCUTABLE_h
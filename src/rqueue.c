@@ -0,0 +1,165 @@
+/**
+@file rqueue.c
+
+See header
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "rqueue.h"
+
+// -----------------------------------------------------------------------------
+// Local Function Prototypes
+// -----------------------------------------------------------------------------
+
+static int rqueue_reserve(RQueue_t *queue, int n);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void rqueue_init(RQueue_t *queue, void (*destroy)(void *data))
+{
+  // Initialize the queue
+  queue->size = 0;
+  queue->capacity = 0;
+  queue->destroy = destroy;
+  queue->head = 0;
+  queue->items = NULL;
+}
+
+
+void rqueue_destroy(RQueue_t *queue)
+{
+  int i;
+
+  // Destroy each element, front of the queue first
+  if (queue->destroy != NULL) {
+    for (i = 0; i < queue->size; i++)
+      queue->destroy(queue->items[(queue->head + i) & (queue->capacity - 1)]);
+  }
+
+  free(queue->items);
+
+  // No operations permitted at this point -- clear memory as precaution
+  memset(queue, 0, sizeof (RQueue_t));
+}
+
+
+int rqueue_enqueue(RQueue_t *queue, const void *data)
+{
+  if (queue->size == queue->capacity && rqueue_reserve(queue, 1) != 0)
+    return -1;
+
+  queue->items[(queue->head + queue->size) & (queue->capacity - 1)] = (void *)data;
+  queue->size++;
+
+  return 0;
+}
+
+
+int rqueue_dequeue(RQueue_t *queue, void **data)
+{
+  if (queue->size == 0)
+    return -1;
+
+  *data = queue->items[queue->head];
+  queue->head = (queue->head + 1) & (queue->capacity - 1);
+  queue->size--;
+
+  return 0;
+}
+
+
+int rqueue_enqueue_n(RQueue_t *queue, void *const *data, int n)
+{
+  int tail;
+  int first;
+
+  if (n <= 0)
+    return n == 0 ? 0 : -1;
+
+  if (rqueue_reserve(queue, n) != 0)
+    return -1;
+
+  // Copy up to the end of the array, then wrap around to the start
+  tail = (queue->head + queue->size) & (queue->capacity - 1);
+  first = (n < queue->capacity - tail) ? n : queue->capacity - tail;
+
+  memcpy(&queue->items[tail], data, first * sizeof (void *));
+  memcpy(queue->items, &data[first], (n - first) * sizeof (void *));
+
+  queue->size += n;
+
+  return 0;
+}
+
+
+int rqueue_dequeue_n(RQueue_t *queue, void **data, int n)
+{
+  int count;
+  int first;
+
+  count = (n < queue->size) ? n : queue->size;
+  if (count <= 0)
+    return 0;
+
+  // Copy up to the end of the array, then wrap around to the start
+  first = (count < queue->capacity - queue->head) ? count : queue->capacity - queue->head;
+
+  memcpy(data, &queue->items[queue->head], first * sizeof (void *));
+  memcpy(&data[first], queue->items, (count - first) * sizeof (void *));
+
+  queue->head = (queue->head + count) & (queue->capacity - 1);
+  queue->size -= count;
+
+  return count;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+/**
+Function to make room for _n_ more elements
+
+The array grows to the next large enough power of two and the elements are
+unwrapped so the front of the queue is at index 0.
+
+@return 0 if successful, otherwise -1
+*/
+static int rqueue_reserve(RQueue_t *queue, int n)
+{
+  void **items;
+  int capacity;
+  int first;
+
+  if (queue->size + n <= queue->capacity)
+    return 0;
+
+  capacity = (queue->capacity == 0) ? RQUEUE_MIN_CAPACITY : queue->capacity;
+  while (capacity < queue->size + n)
+    capacity *= 2;
+
+  if ((items = (void **)malloc(capacity * sizeof (void *))) == NULL)
+    return -1;
+
+  // Copy the elements in order into the new array
+  first = (queue->size < queue->capacity - queue->head) ? queue->size : queue->capacity - queue->head;
+
+  if (queue->size > 0) {
+    memcpy(items, &queue->items[queue->head], first * sizeof (void *));
+    memcpy(&items[first], queue->items, (queue->size - first) * sizeof (void *));
+  }
+
+  free(queue->items);
+
+  queue->items = items;
+  queue->capacity = capacity;
+  queue->head = 0;
+
+  return 0;
+}
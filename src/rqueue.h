@@ -0,0 +1,153 @@
+/** 
+@file rqueue.h
+@brief 
+Definitions of a generic ring-buffer queue ADT
+
+The queue keeps its elements in a circular array of pointers whose size is a
+power of two, doubling when it fills up. Unlike *Queue_t* no memory is 
+allocated per element, and consecutive elements share cache lines.
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#ifndef RQUEUE_h
+#define RQUEUE_h
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdlib.h>
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+/**
+The number of elements allocated by the first enqueue (a power of two)
+*/
+#ifndef RQUEUE_MIN_CAPACITY
+#define RQUEUE_MIN_CAPACITY 16
+#endif
+
+/**
+@struct RQueue_t
+Generic ring-buffer queue
+*/
+typedef struct RQueue_T {
+  int size;     ///< Number of elements in queue
+  int capacity; ///< Number of elements in the array (a power of two)
+
+  void (*destroy)(void *data);
+
+  int head;     ///< Index of the element at the front of the queue
+  void **items; ///< Circular array of elements
+
+} RQueue_t;
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/**
+Function to initialize a ring-buffer queue
+
+@pre
+Must be called before queue can be used by any other operation
+
+The _destroy_ argument provides a way to free dynamically allocated data when
+*rqueue_destroy* is called. For a queue containing data that should not be 
+freed, _destroy_ should be set to NULL. No memory is allocated until the first
+element is enqueued.
+
+Complexity: O(1)
+
+@param [out] *queue    The queue to init
+@param [in] (*destroy) Function pointer to free data element memory
+*/
+void rqueue_init(RQueue_t *queue, void (*destroy)(void *data));
+
+/**
+Function to destroy a ring-buffer queue
+
+The *rqueue_destroy* operation removes all elements from the queue and calls
+the function passed as _destroy_ to *rqueue_init* once for each element as it
+is removed, provided _destroy_ was not set to NULL.
+
+Complexity: O(n) (O(1) if _destroy_ is NULL)
+
+@param [in,out] *queue  The queue to destroy
+*/
+void rqueue_destroy(RQueue_t *queue);
+
+/**
+Function to add an element to the end of the queue
+
+Complexity: O(1) amortized
+
+@param [in,out] *queue  The queue to add element to
+@param [in]     *data   The data to enqueue
+
+@return 0 if enqueue operation was successful, otherwise -1
+*/
+int rqueue_enqueue(RQueue_t *queue, const void *data);
+
+/**
+Function to remove an element from the front of a queue
+
+Complexity: O(1)
+
+@param [in,out] *queue  The queue to remove element from
+@param [out]    **data  The dequeued data
+
+@return 0 if dequeue operation was successful, otherwise -1
+*/
+int rqueue_dequeue(RQueue_t *queue, void **data);
+
+/**
+Function to add _n_ elements to the end of the queue
+
+The elements are enqueued in order, as if *rqueue_enqueue()* was called for
+each, but they are copied into the array with at most two _memcpy_ calls.
+Either all of the elements are enqueued or none are.
+
+Complexity: O(n) amortized
+
+@param [in,out] *queue  The queue to add elements to
+@param [in]     **data  The data to enqueue
+@param [in]       n     The number of elements in _data_
+
+@return 0 if enqueue operation was successful, otherwise -1
+*/
+int rqueue_enqueue_n(RQueue_t *queue, void *const *data, int n);
+
+/**
+Function to remove up to _n_ elements from the front of a queue
+
+The elements are dequeued in order, as if *rqueue_dequeue()* was called for
+each, but they are copied out of the array with at most two _memcpy_ calls.
+
+Complexity: O(n)
+
+@param [in,out] *queue  The queue to remove elements from
+@param [out]    **data  Array receiving the dequeued data
+@param [in]       n     The maximum number of elements to dequeue
+
+@return the number of elements dequeued
+*/
+int rqueue_dequeue_n(RQueue_t *queue, void **data, int n);
+
+/**
+MACRO that provides mechanism to inspect the element at front of queue
+*/
+#define rqueue_peek(queue) ((queue)->size == 0 ? NULL : (queue)->items[(queue)->head])
+
+/**
+MACRO that evaluates to the number of elements in the queue
+*/
+#define rqueue_size(queue) ((queue)->size)
+
+#ifdef __cplusplus
+}
+#endif
+#endif // RQUEUE_h
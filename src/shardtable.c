@@ -0,0 +1,184 @@
+/**
+@file shardtable.c
+
+See header
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "shardtable.h"
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+/**
+Load factor at which the table of a shard doubles
+*/
+#define SHARDTABLE_GROW_LOAD 1.0
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static ShardTable_Shard_t *shardtable_shard(ShardTable_t *stable, const void *data);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+int shardtable_init(ShardTable_t *stable, int shards, int buckets, 
+                    uint64_t (*hash)(const void *key),
+                    int (*match)(const void *a, const void *b),
+                    void (*destroy)(void *data))
+{
+  int bits;
+  int i;
+
+  if (shards <= 0)
+    return -1;
+
+  // Round the number of shards up to a power of two
+  for (bits = 0; (1 << bits) < shards; bits++)
+    ;
+
+  stable->shard = (ShardTable_Shard_t *)aligned_alloc(SHARDTABLE_CACHE_LINE, 
+    (size_t)(1 << bits) * sizeof (ShardTable_Shard_t));
+  if (stable->shard == NULL)
+    return -1;
+
+  for (i = 0; i < (1 << bits); i++) {
+    if (hashtable_init(&stable->shard[i].table, buckets, hash, match, destroy) != 0)
+      break;
+
+    hashtable_set_load_factor(&stable->shard[i].table, SHARDTABLE_GROW_LOAD, 0.0);
+    pthread_rwlock_init(&stable->shard[i].lock, NULL);
+  }
+
+  if (i < (1 << bits)) {
+    // Undo the shards set up so far
+    while (i-- > 0) {
+      hashtable_destroy(&stable->shard[i].table);
+      pthread_rwlock_destroy(&stable->shard[i].lock);
+    }
+    free(stable->shard);
+    return -1;
+  }
+
+  stable->shards = 1 << bits;
+  stable->shift = 64 - bits;
+  stable->hash = hash;
+
+  return 0;
+}
+
+
+void shardtable_destroy(ShardTable_t *stable)
+{
+  int i;
+
+  for (i = 0; i < stable->shards; i++) {
+    hashtable_destroy(&stable->shard[i].table);
+    pthread_rwlock_destroy(&stable->shard[i].lock);
+  }
+
+  free(stable->shard);
+
+  // No operations permitted at this point -- clear memory as precaution
+  memset(stable, 0, sizeof (ShardTable_t));
+}
+
+
+int shardtable_insert(ShardTable_t *stable, const void *data)
+{
+  ShardTable_Shard_t *shard;
+  int retval;
+
+  shard = shardtable_shard(stable, data);
+
+  pthread_rwlock_wrlock(&shard->lock);
+  retval = hashtable_insert(&shard->table, data);
+  pthread_rwlock_unlock(&shard->lock);
+
+  return retval;
+}
+
+
+int shardtable_remove(ShardTable_t *stable, void **data)
+{
+  ShardTable_Shard_t *shard;
+  int retval;
+
+  shard = shardtable_shard(stable, *data);
+
+  pthread_rwlock_wrlock(&shard->lock);
+  retval = hashtable_remove(&shard->table, data);
+  pthread_rwlock_unlock(&shard->lock);
+
+  return retval;
+}
+
+
+int shardtable_lookup(ShardTable_t *stable, void **data)
+{
+  ShardTable_Shard_t *shard;
+  int retval;
+
+  shard = shardtable_shard(stable, *data);
+
+  pthread_rwlock_rdlock(&shard->lock);
+
+  if (!hashtable_is_rehashing(&shard->table)) {
+    // A lookup in a table at rest only reads
+    retval = hashtable_lookup(&shard->table, data);
+    pthread_rwlock_unlock(&shard->lock);
+    return retval;
+  }
+
+  // A lookup during a resize also moves buckets along
+  pthread_rwlock_unlock(&shard->lock);
+  pthread_rwlock_wrlock(&shard->lock);
+  retval = hashtable_lookup(&shard->table, data);
+  pthread_rwlock_unlock(&shard->lock);
+
+  return retval;
+}
+
+
+int shardtable_size(ShardTable_t *stable)
+{
+  int size = 0;
+  int i;
+
+  for (i = 0; i < stable->shards; i++) {
+    pthread_rwlock_rdlock(&stable->shard[i].lock);
+    size += hashtable_size(&stable->shard[i].table);
+    pthread_rwlock_unlock(&stable->shard[i].lock);
+  }
+
+  return size;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+/**
+Find the shard responsible for a key
+
+@param [in] *stable  The table
+@param [in] *data    The key
+
+@return the shard
+*/
+static ShardTable_Shard_t *shardtable_shard(ShardTable_t *stable, const void *data)
+{
+  // A shift by 64 is undefined, so a single shard is handled apart
+  if (stable->shards == 1)
+    return &stable->shard[0];
+
+  return &stable->shard[stable->hash(data) >> stable->shift];
+}
@@ -0,0 +1,178 @@
+/** 
+@file shardtable.h
+@brief 
+Definitions of a sharded concurrent hash table ADT
+
+The key space is split by hash into a power-of-two number of shards, each a
+chained hash table (see hashtable.h) guarded by its own reader-writer lock.
+Threads working on different shards never wait for one another, and lookups
+in the same shard proceed in parallel under the read lock. Each shard is
+aligned and padded to a cache line, so the locks of neighbouring shards do not
+share a line and bounce between cores.
+
+The shard is chosen from the top bits of the hash, while the shard's own
+table picks buckets from the low bits, so the two do not correlate.
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#ifndef SHARDTABLE_h
+#define SHARDTABLE_h
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "hashtable.h"
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+/**
+The assumed size of a cache line, used to keep the shards apart
+*/
+#ifndef SHARDTABLE_CACHE_LINE
+#define SHARDTABLE_CACHE_LINE 64
+#endif
+
+/**
+@struct ShardTable_Shard_t
+One shard of a sharded hash table
+*/
+typedef struct ShardTable_Shard_T {
+  _Alignas(SHARDTABLE_CACHE_LINE)
+  pthread_rwlock_t lock; ///< Read lock for lookups, write lock for updates
+  HashTable_t table;
+} ShardTable_Shard_t;
+
+/**
+@struct ShardTable_t
+Sharded concurrent hash table
+*/
+typedef struct ShardTable_T {
+  int shards; ///< Number of shards (a power of two)
+  int shift;  ///< Shift taking a hash to its shard
+
+  uint64_t (*hash)(const void *key);
+
+  ShardTable_Shard_t *shard;
+
+} ShardTable_t;
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/**
+Function to initialize a sharded hash table
+
+@pre
+Must be called before table can be used by any other operation, and before
+any thread starts using it
+
+The number of shards is rounded up to a power of two; a few times the number
+of threads is a good start. Each shard starts with _buckets_ buckets and
+doubles them as it fills up. The _hash_, _match_ and _destroy_ arguments are as
+for *hashtable_init()*; _hash_ should mix all 64 bits, since the top bits pick
+the shard.
+
+Complexity: O(s * m)
+
+@param [out] *stable   The table to init
+@param [in]   shards   The number of shards
+@param [in]   buckets  The initial number of buckets in each shard
+@param [in]  *hash     Pointer to user hash function
+@param [in]  *match    Pointer to user hash key comparison function
+@param [in]  *destroy  Pointer to function to free element memory
+
+@return 0 if table init successful, otherwise -1
+*/
+int shardtable_init(ShardTable_t *stable, int shards, int buckets, 
+                    uint64_t (*hash)(const void *key),
+                    int (*match)(const void *a, const void *b),
+                    void (*destroy)(void *data));
+
+/**
+Function to destroy a sharded hash table
+
+@pre
+No thread may be using the table
+
+Complexity: O(n + s * m)
+
+@param [in,out] *stable  The table to destroy
+*/
+void shardtable_destroy(ShardTable_t *stable);
+
+/**
+Function to insert an element into the table (thread-safe)
+
+Complexity: O(1)
+
+@param [in,out] *stable  The table to insert into
+@param [in]     *data    The data to insert
+
+@return 0 if inserting the element was successful, 1 if the element was already
+in the table, otherwise -1
+*/
+int shardtable_insert(ShardTable_t *stable, const void *data);
+
+/**
+Function to remove an element from the table (thread-safe)
+
+Complexity: O(1)
+
+@param [in,out] *stable  The table to remove from
+@param [in,out] **data   The key to remove, then the data that was stored
+
+@return 0 if removing the element was successful, otherwise -1
+*/
+int shardtable_remove(ShardTable_t *stable, void **data);
+
+/**
+Function to look up an element in the table (thread-safe)
+
+Takes only the shard's read lock, unless the shard is in the middle of an
+incremental resize, where a lookup moves buckets and needs the write lock.
+
+@note
+The data returned is only guaranteed to stay valid while no other thread can
+remove it; the table does not reference-count its elements.
+
+Complexity: O(1)
+
+@param [in,out] *stable  The table to search
+@param [in,out] **data   The key to look up, then the data that was found
+
+@return 0 if the element was found, otherwise -1
+*/
+int shardtable_lookup(ShardTable_t *stable, void **data);
+
+/**
+Function to count the elements of the table (thread-safe)
+
+Each shard is counted under its read lock, so the total is a snapshot only
+while other threads are updating the table.
+
+Complexity: O(s)
+
+@param [in,out] *stable  The table to count
+
+@return the number of elements
+*/
+int shardtable_size(ShardTable_t *stable);
+
+/**
+MACRO that evaluates to the number of shards in the table
+*/
+#define shardtable_shards(stable) ((stable)->shards)
+
+#ifdef __cplusplus
+}
+#endif
+#endif // SHARDTABLE_h
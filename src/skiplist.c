@@ -0,0 +1,251 @@
+/**
+@file skiplist.c
+
+See header
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "skiplist.h"
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static SkipList_Element_t *skiplist_alloc(int level);
+static int skiplist_random_level(SkipList_t *list);
+static SkipList_Element_t *skiplist_find(const SkipList_t *list, const void *key, 
+  SkipList_Element_t **update);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+int skiplist_init(SkipList_t *list, int (*compare)(const void *key1, const void *key2), 
+                  void (*destroy)(void *data))
+{
+  int i;
+
+  if (compare == NULL)
+    return -1;
+
+  // The head is a sentinel with a full tower and no data
+  if ((list->head = skiplist_alloc(SKIPLIST_MAX_LEVEL)) == NULL)
+    return -1;
+
+  list->head->data = NULL;
+  for (i = 0; i < SKIPLIST_MAX_LEVEL; i++)
+    list->head->next[i] = NULL;
+
+  list->size = 0;
+  list->level = 1;
+  list->seed = SKIPLIST_DEFAULT_SEED;
+  list->compare = compare;
+  list->destroy = destroy;
+
+  return 0;
+}
+
+
+void skiplist_destroy(SkipList_t *list)
+{
+  SkipList_Element_t *element;
+  SkipList_Element_t *next;
+
+  // Every element is on the bottom level
+  for (element = list->head->next[0]; element != NULL; element = next) {
+    next = element->next[0];
+    if (list->destroy != NULL)
+      list->destroy(element->data);
+    free(element);
+  }
+
+  free(list->head);
+
+  // No operations permitted at this point -- clear memory as precaution
+  memset(list, 0, sizeof (SkipList_t));
+}
+
+
+void skiplist_seed(SkipList_t *list, uint64_t seed)
+{
+  // xorshift must not start from zero
+  list->seed = seed != 0 ? seed : SKIPLIST_DEFAULT_SEED;
+}
+
+
+int skiplist_insert(SkipList_t *list, const void *data)
+{
+  SkipList_Element_t *update[SKIPLIST_MAX_LEVEL];
+  SkipList_Element_t *element;
+  int level;
+  int i;
+
+  element = skiplist_find(list, data, update);
+
+  // Do nothing if the key is already in the list
+  if (element != NULL && list->compare(data, element->data) == 0)
+    return 1;
+
+  level = skiplist_random_level(list);
+
+  if ((element = skiplist_alloc(level)) == NULL)
+    return -1;
+
+  element->data = (void *)data;
+
+  // Levels above the current height are linked straight from the head
+  for (i = list->level; i < level; i++)
+    update[i] = list->head;
+  if (level > list->level)
+    list->level = level;
+
+  // Link the tower in after the last element before it at each level
+  for (i = 0; i < level; i++) {
+    element->next[i] = update[i]->next[i];
+    update[i]->next[i] = element;
+  }
+
+  // Adjust the size
+  list->size++;
+
+  return 0;
+}
+
+
+int skiplist_remove(SkipList_t *list, void **data)
+{
+  SkipList_Element_t *update[SKIPLIST_MAX_LEVEL];
+  SkipList_Element_t *element;
+  int i;
+
+  element = skiplist_find(list, *data, update);
+
+  if (element == NULL || list->compare(*data, element->data) != 0)
+    return -1;
+
+  // Unlink the tower at each of its levels
+  for (i = 0; i < element->level; i++)
+    update[i]->next[i] = element->next[i];
+
+  // Lower the list if its tallest tower went
+  while (list->level > 1 && list->head->next[list->level - 1] == NULL)
+    list->level--;
+
+  *data = element->data;
+  free(element);
+
+  // Adjust the size of the list
+  list->size--;
+
+  return 0;
+}
+
+
+int skiplist_lookup(const SkipList_t *list, void **data)
+{
+  SkipList_Element_t *element;
+
+  element = skiplist_find(list, *data, NULL);
+
+  if (element == NULL || list->compare(*data, element->data) != 0)
+    return -1;
+
+  *data = element->data;
+
+  return 0;
+}
+
+
+SkipList_Element_t *skiplist_lower_bound(const SkipList_t *list, const void *key)
+{
+  return skiplist_find(list, key, NULL);
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+/**
+Allocate an element with a tower of the given height
+
+@param [in] level  The height of the tower
+
+@return the element, or NULL if memory could not be allocated
+*/
+static SkipList_Element_t *skiplist_alloc(int level)
+{
+  SkipList_Element_t *element;
+
+  element = (SkipList_Element_t *)malloc(sizeof (SkipList_Element_t) + 
+    level * sizeof (SkipList_Element_t *));
+  if (element == NULL)
+    return NULL;
+
+  element->level = level;
+
+  return element;
+}
+
+
+/**
+Draw the height of a new tower
+
+Each level above the first is reached with probability 1/4, taken two bits at
+a time from a xorshift64* generator.
+
+@param [in,out] *list  The skip list holding the generator state
+
+@return the height, from 1 to SKIPLIST_MAX_LEVEL
+*/
+static int skiplist_random_level(SkipList_t *list)
+{
+  uint64_t bits;
+  int level = 1;
+
+  list->seed ^= list->seed >> 12;
+  list->seed ^= list->seed << 25;
+  list->seed ^= list->seed >> 27;
+  bits = list->seed * 0x2545f4914f6cdd1dULL;
+
+  while ((bits & 3) == 0 && level < SKIPLIST_MAX_LEVEL) {
+    level++;
+    bits >>= 2;
+  }
+
+  return level;
+}
+
+
+/**
+Search for the first element not ordered before a key
+
+@param [in]  *list    The skip list to search
+@param [in]  *key     The key to search for
+@param [out] **update If not NULL, receives at each level below the list height
+                      the last element (or head) ordered before _key_
+
+@return the first element whose data compares greater than or equal to _key_,
+or NULL if there is none
+*/
+static SkipList_Element_t *skiplist_find(const SkipList_t *list, const void *key, 
+  SkipList_Element_t **update)
+{
+  SkipList_Element_t *element = list->head;
+  SkipList_Element_t *next;
+  int i;
+
+  // Run along each level as far as the key allows, then drop down
+  for (i = list->level - 1; i >= 0; i--) {
+    while ((next = element->next[i]) != NULL && list->compare(next->data, key) < 0)
+      element = next;
+
+    if (update != NULL)
+      update[i] = element;
+  }
+
+  return element->next[0];
+}
@@ -0,0 +1,200 @@
+/** 
+@file skiplist.h
+@brief 
+Definitions of a skip list ADT (ordered map)
+
+The elements are kept in order of a user comparison function on a linked-list,
+and each element also carries a tower of forward links that skip over runs of
+the elements after it. Tower heights are drawn at random, with each level a
+quarter as likely as the one below, so a search descends through O(log n)
+expected elements. The tower is allocated together with its element and sized
+to its height, so most elements cost a single link.
+
+The random heights come from a small generator held in the list, which starts
+from a fixed seed (see *skiplist_seed()*), so a given sequence of operations
+always builds the same list.
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#ifndef SKIPLIST_h
+#define SKIPLIST_h
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <stdlib.h>
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+/**
+The maximum height of a tower, enough for 4^SKIPLIST_MAX_LEVEL elements
+*/
+#ifndef SKIPLIST_MAX_LEVEL
+#define SKIPLIST_MAX_LEVEL 24
+#endif
+
+/**
+The seed the height generator starts from
+*/
+#define SKIPLIST_DEFAULT_SEED 0x9e3779b97f4a7c15ULL
+
+/**
+@struct SkipList_Element_t
+Skip list element with its tower of forward links
+*/
+typedef struct SkipList_Element_T {
+  void *data; ///< Pointer to data
+  int level;  ///< Height of the tower
+
+  struct SkipList_Element_T *next[]; ///< Next element at each level of the tower
+
+} SkipList_Element_t;
+
+/**
+@struct SkipList_t
+Skip list
+*/
+typedef struct SkipList_T {
+  int size;  ///< Number of elements in list
+  int level; ///< Height of the tallest tower in the list
+
+  uint64_t seed; ///< State of the tower height generator
+
+  int (*compare)(const void *key1, const void *key2);
+  void (*destroy)(void *data);
+
+  SkipList_Element_t *head; ///< Sentinel whose tower has every level
+
+} SkipList_t;
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/**
+Function to initialize a skip list
+
+@pre
+Must be called before list can be used by any other operation
+
+The _compare_ argument orders the elements like the comparison function of
+_qsort_, but is given the data pointers themselves. Elements comparing equal
+are the same key, so the list holds each key at most once. The _destroy_
+argument provides a way to free dynamically allocated data when
+*skiplist_destroy* is called, or NULL if the data should not be freed.
+
+Complexity: O(1)
+
+@param [out] *list      The skip list to init
+@param [in] (*compare)  Function pointer to order two elements
+@param [in] (*destroy)  Function pointer to free data element memory
+
+@return 0 if list init successful, otherwise -1
+*/
+int skiplist_init(SkipList_t *list, int (*compare)(const void *key1, const void *key2), 
+                  void (*destroy)(void *data));
+
+/**
+Function to destroy a skip list
+
+Calls the function passed as _destroy_ to *skiplist_init* once for each
+element, provided _destroy_ was not set to NULL.
+
+Complexity: O(n)
+
+@param [in,out] *list  The skip list to destroy
+*/
+void skiplist_destroy(SkipList_t *list);
+
+/**
+Function to reseed the tower height generator of a skip list
+
+Complexity: O(1)
+
+@param [in,out] *list  The skip list
+@param [in]      seed  The new seed
+*/
+void skiplist_seed(SkipList_t *list, uint64_t seed);
+
+/**
+Function to insert an element into a skip list
+
+Complexity: O(log n) expected
+
+@param [in,out] *list  The skip list to insert into
+@param [in]     *data  The data to insert
+
+@return 0 if inserting the element was successful, 1 if an element with the
+same key was already in the list, otherwise -1
+*/
+int skiplist_insert(SkipList_t *list, const void *data);
+
+/**
+Function to remove an element from a skip list
+
+Complexity: O(log n) expected
+
+@param [in,out] *list  The skip list to remove from
+@param [in,out] **data The key to remove, then the data that was stored
+
+@return 0 if removing the element was successful, otherwise -1
+*/
+int skiplist_remove(SkipList_t *list, void **data);
+
+/**
+Function to look up an element in a skip list
+
+Complexity: O(log n) expected
+
+@param [in]     *list  The skip list to search
+@param [in,out] **data The key to look up, then the data that was found
+
+@return 0 if the element was found, otherwise -1
+*/
+int skiplist_lookup(const SkipList_t *list, void **data);
+
+/**
+Function to find the first element not ordered before a key
+
+The element returned is the start of an in-order scan of every key from _key_
+on, continued with *skiplist_next()*.
+
+Complexity: O(log n) expected
+
+@param [in] *list  The skip list to search
+@param [in] *key   The key to search for
+
+@return the first element whose data compares greater than or equal to _key_,
+or NULL if there is none
+*/
+SkipList_Element_t *skiplist_lower_bound(const SkipList_t *list, const void *key);
+
+/**
+MACRO that evaluates to the number of elements in the skip list
+*/
+#define skiplist_size(list) ((list)->size)
+
+/**
+MACRO that evaluates to the first element (smallest key) of the skip list
+*/
+#define skiplist_head(list) ((list)->head->next[0])
+
+/**
+MACRO that evaluates to the element after a given element in key order
+*/
+#define skiplist_next(element) ((element)->next[0])
+
+/**
+MACRO that evaluates to the data stored in given element of a skip list
+*/
+#define skiplist_data(element) ((element)->data)
+
+#ifdef __cplusplus
+}
+#endif
+#endif // SKIPLIST_h
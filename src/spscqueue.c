@@ -0,0 +1,171 @@
+/**
+@file spscqueue.c
+
+See header
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "spscqueue.h"
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+int spscqueue_init(SPSCQueue_t *queue, int capacity, void (*destroy)(void *data))
+{
+  size_t slots;
+
+  if (capacity <= 0)
+    return -1;
+
+  // Round the capacity up to a power of two
+  slots = 1;
+  while (slots < (size_t)capacity)
+    slots *= 2;
+
+  if ((queue->items = (void **)malloc(slots * sizeof (void *))) == NULL)
+    return -1;
+
+  queue->capacity = slots;
+  queue->destroy = destroy;
+
+  atomic_init(&queue->tail, 0);
+  atomic_init(&queue->head, 0);
+  queue->head_cache = 0;
+  queue->tail_cache = 0;
+
+  return 0;
+}
+
+
+void spscqueue_destroy(SPSCQueue_t *queue)
+{
+  size_t head;
+  size_t tail;
+
+  // Destroy each element still in the queue
+  head = atomic_load_explicit(&queue->head, memory_order_acquire);
+  tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+
+  if (queue->destroy != NULL) {
+    for (; head != tail; head++)
+      queue->destroy(queue->items[head & (queue->capacity - 1)]);
+  }
+
+  free(queue->items);
+
+  // No operations permitted at this point -- clear memory as precaution
+  memset(queue, 0, sizeof (SPSCQueue_t));
+}
+
+
+int spscqueue_enqueue(SPSCQueue_t *queue, const void *data)
+{
+  size_t tail;
+
+  tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+
+  // Only look at the consumer's index when the queue appears full
+  if (tail - queue->head_cache == queue->capacity) {
+    queue->head_cache = atomic_load_explicit(&queue->head, memory_order_acquire);
+    if (tail - queue->head_cache == queue->capacity)
+      return -1;
+  }
+
+  queue->items[tail & (queue->capacity - 1)] = (void *)data;
+
+  // Publish the element to the consumer
+  atomic_store_explicit(&queue->tail, tail + 1, memory_order_release);
+
+  return 0;
+}
+
+
+int spscqueue_dequeue(SPSCQueue_t *queue, void **data)
+{
+  size_t head;
+
+  head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+
+  // Only look at the producer's index when the queue appears empty
+  if (head == queue->tail_cache) {
+    queue->tail_cache = atomic_load_explicit(&queue->tail, memory_order_acquire);
+    if (head == queue->tail_cache)
+      return -1;
+  }
+
+  *data = queue->items[head & (queue->capacity - 1)];
+
+  // Hand the slot back to the producer
+  atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+
+  return 0;
+}
+
+
+int spscqueue_enqueue_n(SPSCQueue_t *queue, void *const *data, int n)
+{
+  size_t tail;
+  size_t room;
+  int i;
+
+  if (n <= 0)
+    return 0;
+
+  tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+
+  // Refresh the view of the consumer's index only if it limits the burst
+  room = queue->capacity - (tail - queue->head_cache);
+  if (room < (size_t)n) {
+    queue->head_cache = atomic_load_explicit(&queue->head, memory_order_acquire);
+    room = queue->capacity - (tail - queue->head_cache);
+  }
+
+  if ((size_t)n > room)
+    n = (int)room;
+
+  for (i = 0; i < n; i++)
+    queue->items[(tail + i) & (queue->capacity - 1)] = data[i];
+
+  // Publish the whole burst at once
+  if (n > 0)
+    atomic_store_explicit(&queue->tail, tail + n, memory_order_release);
+
+  return n;
+}
+
+
+int spscqueue_dequeue_n(SPSCQueue_t *queue, void **data, int n)
+{
+  size_t head;
+  size_t avail;
+  int i;
+
+  if (n <= 0)
+    return 0;
+
+  head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+
+  // Refresh the view of the producer's index only if it limits the burst
+  avail = queue->tail_cache - head;
+  if (avail < (size_t)n) {
+    queue->tail_cache = atomic_load_explicit(&queue->tail, memory_order_acquire);
+    avail = queue->tail_cache - head;
+  }
+
+  if ((size_t)n > avail)
+    n = (int)avail;
+
+  for (i = 0; i < n; i++)
+    data[i] = queue->items[(head + i) & (queue->capacity - 1)];
+
+  // Hand the whole burst of slots back at once
+  if (n > 0)
+    atomic_store_explicit(&queue->head, head + n, memory_order_release);
+
+  return n;
+}
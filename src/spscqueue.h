@@ -0,0 +1,169 @@
+/** 
+@file spscqueue.h
+@brief 
+Definitions of a bounded lock-free single-producer/single-consumer queue
+
+Exactly one thread may enqueue and exactly one (other) thread may dequeue at
+the same time, without any locking. The queue is a power-of-two ring of
+pointers indexed by two ever increasing counters: the producer owns _tail_ and
+the consumer owns _head_. Each counter lives on its own cache line together
+with its owner's cached copy of the other counter, so in the common case the
+producer and consumer never touch the same cache line except for the element
+being handed over.
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#ifndef SPSCQUEUE_h
+#define SPSCQUEUE_h
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdatomic.h>
+#include <stdlib.h>
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+/**
+The assumed size of a cache line, used to keep the two ends of the queue apart
+*/
+#ifndef SPSCQUEUE_CACHE_LINE
+#define SPSCQUEUE_CACHE_LINE 64
+#endif
+
+/**
+@struct SPSCQueue_t
+Bounded lock-free single-producer/single-consumer queue
+*/
+typedef struct SPSCQueue_T {
+  _Alignas(SPSCQUEUE_CACHE_LINE)
+  atomic_size_t tail; ///< Count of elements ever enqueued (written by producer)
+  size_t head_cache;  ///< Producer's last view of _head_
+
+  _Alignas(SPSCQUEUE_CACHE_LINE)
+  atomic_size_t head; ///< Count of elements ever dequeued (written by consumer)
+  size_t tail_cache;  ///< Consumer's last view of _tail_
+
+  _Alignas(SPSCQUEUE_CACHE_LINE)
+  size_t capacity; ///< Number of elements in the ring (a power of two)
+
+  void (*destroy)(void *data);
+
+  void **items; ///< Ring of elements
+
+} SPSCQueue_t;
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/**
+Function to initialize a single-producer/single-consumer queue
+
+@pre
+Must be called before queue can be used by any other operation, and before
+the producer and consumer threads start using it
+
+The queue holds at most _capacity_ elements, rounded up to a power of two. The
+_destroy_ argument provides a way to free dynamically allocated data when
+*spscqueue_destroy* is called, or NULL if the data should not be freed.
+
+Complexity: O(1)
+
+@param [out] *queue     The queue to init
+@param [in]   capacity  The maximum number of elements in the queue
+@param [in] (*destroy)  Function pointer to free data element memory
+
+@return 0 if queue init successful, otherwise -1
+*/
+int spscqueue_init(SPSCQueue_t *queue, int capacity, void (*destroy)(void *data));
+
+/**
+Function to destroy a single-producer/single-consumer queue
+
+Calls the function passed as _destroy_ to *spscqueue_init* once for each
+element still in the queue, provided _destroy_ was not set to NULL.
+
+@pre
+Neither the producer nor the consumer may be using the queue
+
+Complexity: O(n)
+
+@param [in,out] *queue  The queue to destroy
+*/
+void spscqueue_destroy(SPSCQueue_t *queue);
+
+/**
+Function to add an element to the end of the queue (producer only)
+
+Complexity: O(1)
+
+@param [in,out] *queue  The queue to add element to
+@param [in]     *data   The data to enqueue
+
+@return 0 if enqueue operation was successful, otherwise -1 (queue full)
+*/
+int spscqueue_enqueue(SPSCQueue_t *queue, const void *data);
+
+/**
+Function to remove an element from the front of the queue (consumer only)
+
+Complexity: O(1)
+
+@param [in,out] *queue  The queue to remove element from
+@param [out]    **data  The dequeued data
+
+@return 0 if dequeue operation was successful, otherwise -1 (queue empty)
+*/
+int spscqueue_dequeue(SPSCQueue_t *queue, void **data);
+
+/**
+Function to add up to _n_ elements to the end of the queue (producer only)
+
+The elements are published to the consumer with a single store, so a burst
+costs about as much synchronization as one element.
+
+Complexity: O(n)
+
+@param [in,out] *queue  The queue to add elements to
+@param [in]     **data  The data to enqueue
+@param [in]       n     The number of elements in _data_
+
+@return the number of elements enqueued (fewer than _n_ if the queue filled up)
+*/
+int spscqueue_enqueue_n(SPSCQueue_t *queue, void *const *data, int n);
+
+/**
+Function to remove up to _n_ elements from the front of the queue (consumer
+only)
+
+The elements are released back to the producer with a single store, so
+draining a burst costs about as much synchronization as one element.
+
+Complexity: O(n)
+
+@param [in,out] *queue  The queue to remove elements from
+@param [out]    **data  Array receiving the dequeued data
+@param [in]       n     The maximum number of elements to dequeue
+
+@return the number of elements dequeued
+*/
+int spscqueue_dequeue_n(SPSCQueue_t *queue, void **data, int n);
+
+/**
+MACRO that evaluates to the number of elements in the queue
+
+The value is only a snapshot when the other thread is active.
+*/
+#define spscqueue_size(queue) \
+  ((int)(atomic_load_explicit(&(queue)->tail, memory_order_acquire) - \
+         atomic_load_explicit(&(queue)->head, memory_order_acquire)))
+
+#ifdef __cplusplus
+}
+#endif
+#endif // SPSCQUEUE_h
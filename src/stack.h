@@ -35,6 +35,12 @@ MACRO to init the stack. Functionally same as *list_init*
 */
 #define stack_init list_init
 
+/**
+MACRO to init the stack with an element allocator. Functionally same as 
+*list_init_allocator*
+*/
+#define stack_init_allocator list_init_allocator
+
 /**
 MACRO to destroy the stack. Functionally same as *list_destroy*
 */
@@ -0,0 +1,268 @@
+/**
+@file twheel.c
+
+See header
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "twheel.h"
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+#define TWHEEL_MASK (TWHEEL_SLOTS - 1)
+
+/**
+Number of ticks covered by the whole of level _level_ and those below it
+*/
+#define TWHEEL_SPAN(level) ((uint64_t)1 << (TWHEEL_SLOT_BITS * ((level) + 1)))
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static int twheel_file(TWheel_t *wheel, TWheel_Timer_t *timer);
+static CList_t *twheel_list(TWheel_t *wheel, const TWheel_Timer_t *timer);
+static void twheel_cascade(TWheel_t *wheel, int level);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+int twheel_init(TWheel_t *wheel, uint64_t now)
+{
+  int level;
+  int slot;
+
+  if (pool_init(&wheel->pool, sizeof (CList_Element_t), TWHEEL_POOL_BLOCKS) != 0)
+    return -1;
+
+  for (level = 0; level < TWHEEL_LEVELS; level++) {
+    for (slot = 0; slot < TWHEEL_SLOTS; slot++)
+      clist_init_allocator(&wheel->slots[level][slot], NULL, pool_allocator(&wheel->pool));
+  }
+
+  clist_init_allocator(&wheel->expiring, NULL, pool_allocator(&wheel->pool));
+
+  wheel->now = now;
+  wheel->size = 0;
+
+  return 0;
+}
+
+
+void twheel_destroy(TWheel_t *wheel)
+{
+  // Every element lives in the pool, so the lists need not be walked
+  pool_destroy(&wheel->pool);
+
+  // No operations permitted at this point -- clear memory as precaution
+  memset(wheel, 0, sizeof (TWheel_t));
+}
+
+
+void twheel_timer_init(TWheel_Timer_t *timer, void (*callback)(TWheel_Timer_t *timer), 
+  void *data)
+{
+  timer->expires = 0;
+  timer->callback = callback;
+  timer->data = data;
+  timer->element = NULL;
+  timer->level = 0;
+  timer->slot = 0;
+}
+
+
+int twheel_schedule(TWheel_t *wheel, TWheel_Timer_t *timer, uint64_t expires)
+{
+  if (twheel_is_pending(timer))
+    twheel_cancel(wheel, timer);
+
+  // Whatever is already due goes off on the next tick
+  timer->expires = expires > wheel->now ? expires : wheel->now + 1;
+
+  if (twheel_file(wheel, timer) != 0)
+    return -1;
+
+  wheel->size++;
+
+  return 0;
+}
+
+
+int twheel_cancel(TWheel_t *wheel, TWheel_Timer_t *timer)
+{
+  CList_Element_t *element;
+  TWheel_Timer_t *moved;
+  CList_t *list;
+  void *data;
+
+  if (!twheel_is_pending(timer))
+    return -1;
+
+  list = twheel_list(wheel, timer);
+  element = timer->element;
+
+  if (clist_size(list) > 1) {
+    // Move the next timer into this element and unlink the next element
+    // instead, which only needs this element as its predecessor
+    moved = (TWheel_Timer_t *)clist_data(clist_next(element));
+    element->data = moved;
+    moved->element = element;
+  }
+
+  clist_remove_next(list, element, &data);
+
+  timer->element = NULL;
+  wheel->size--;
+
+  return 0;
+}
+
+
+int twheel_advance(TWheel_t *wheel, uint64_t ticks)
+{
+  CList_Element_t *element;
+  TWheel_Timer_t *timer;
+  CList_t *slot;
+  int fired = 0;
+  int level;
+
+  while (ticks-- > 0) {
+    wheel->now++;
+
+    // Refill the finer levels from the coarser ones at the end of each turn
+    for (level = 1; level < TWHEEL_LEVELS; level++) {
+      if ((wheel->now & (TWHEEL_SPAN(level - 1) - 1)) != 0)
+        break;
+      twheel_cascade(wheel, level);
+    }
+
+    // Detach the due slot, so callbacks can file timers into it for a later
+    // turn while the due ones are still being fired
+    slot = &wheel->slots[0][wheel->now & TWHEEL_MASK];
+    if (clist_size(slot) == 0)
+      continue;
+
+    wheel->expiring = *slot;
+    clist_init_allocator(slot, NULL, pool_allocator(&wheel->pool));
+
+    // Let a callback cancelling one of them find it in the expiring list
+    element = clist_head(&wheel->expiring);
+    do {
+      ((TWheel_Timer_t *)clist_data(element))->level = TWHEEL_LEVELS;
+      element = clist_next(element);
+    } while (element != clist_head(&wheel->expiring));
+
+    while (clist_size(&wheel->expiring) > 0) {
+      clist_remove_next(&wheel->expiring, clist_head(&wheel->expiring), (void **)&timer);
+
+      timer->element = NULL;
+      wheel->size--;
+      fired++;
+
+      timer->callback(timer);
+    }
+  }
+
+  return fired;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+/**
+File a timer in the slot matching its distance from the current tick
+
+@param [in,out] *wheel  The wheel
+@param [in,out] *timer  The timer (its _expires_ must be after now)
+
+@return 0 if successful, otherwise -1
+*/
+static int twheel_file(TWheel_t *wheel, TWheel_Timer_t *timer)
+{
+  CList_t *list;
+  uint64_t delta;
+  uint64_t expires;
+  int level;
+
+  delta = timer->expires - wheel->now;
+  expires = timer->expires;
+
+  // Find the finest level that reaches that far
+  for (level = 0; level < TWHEEL_LEVELS - 1; level++) {
+    if (delta < TWHEEL_SPAN(level))
+      break;
+  }
+
+  // Out of reach -- park it as far out as the last level goes
+  if (delta >= TWHEEL_SPAN(TWHEEL_LEVELS - 1))
+    expires = wheel->now + TWHEEL_SPAN(TWHEEL_LEVELS - 1) - 1;
+
+  timer->level = level;
+  timer->slot = (int)((expires >> (TWHEEL_SLOT_BITS * level)) & TWHEEL_MASK);
+
+  list = &wheel->slots[level][timer->slot];
+
+  if (clist_insert_next(list, clist_head(list), timer) != 0)
+    return -1;
+
+  // The new element follows the head, or is the head of an empty list
+  timer->element = clist_size(list) == 1 ? clist_head(list) : clist_next(clist_head(list));
+
+  return 0;
+}
+
+
+/**
+Find the list a pending timer is in
+
+@param [in] *wheel  The wheel
+@param [in] *timer  The timer
+
+@return the list
+*/
+static CList_t *twheel_list(TWheel_t *wheel, const TWheel_Timer_t *timer)
+{
+  if (timer->level == TWHEEL_LEVELS)
+    return &wheel->expiring;
+
+  return &wheel->slots[timer->level][timer->slot];
+}
+
+
+/**
+Refile the timers of the current slot of a level into the finer levels
+
+The slot is detached first, since a parked timer which is still out of reach
+may be filed right back into it.
+
+@param [in,out] *wheel  The wheel
+@param [in]      level  The level to cascade from
+*/
+static void twheel_cascade(TWheel_t *wheel, int level)
+{
+  TWheel_Timer_t *timer;
+  CList_t *slot;
+  CList_t list;
+
+  slot = &wheel->slots[level][(wheel->now >> (TWHEEL_SLOT_BITS * level)) & TWHEEL_MASK];
+  if (clist_size(slot) == 0)
+    return;
+
+  list = *slot;
+  clist_init_allocator(slot, NULL, pool_allocator(&wheel->pool));
+
+  while (clist_size(&list) > 0) {
+    clist_remove_next(&list, clist_head(&list), (void **)&timer);
+
+    // The element just came back to the pool, so this cannot run short
+    twheel_file(wheel, timer);
+  }
+}
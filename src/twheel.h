@@ -0,0 +1,210 @@
+/** 
+@file twheel.h
+@brief 
+Definitions of a hierarchical timer wheel ADT
+
+The wheel keeps TWHEEL_LEVELS wheels of TWHEEL_SLOTS slots, each slot a
+circular linked-list of timers. A slot of level 0 covers a single tick, a slot
+of level 1 covers TWHEEL_SLOTS ticks, and so on. A timer is filed in the
+finest level whose span covers its distance from now, so scheduling is O(1).
+Whenever the level 0 wheel completes a turn, the next slot of level 1 is
+emptied and its timers are filed again one level down (cascading), and
+likewise further up. Timers further out than the whole wheel can reach are
+parked in the last level and refiled until they come into range.
+
+Cancelling is O(1) as well, even though the slot lists are singly linked: a
+timer remembers its list element, and rather than unlinking that element
+(which would need its predecessor) the timer stored in the following element
+is moved into it and the following element is unlinked instead.
+
+List elements come from a pool owned by the wheel, so hundreds of thousands of
+timers can be scheduled and cancelled without touching malloc.
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#ifndef TWHEEL_h
+#define TWHEEL_h
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "clist.h"
+#include "pool.h"
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+/**
+Number of bits of the tick count resolved by each level
+*/
+#define TWHEEL_SLOT_BITS 6
+
+/**
+Number of slots in each level
+*/
+#define TWHEEL_SLOTS (1 << TWHEEL_SLOT_BITS)
+
+/**
+Number of levels; the wheel reaches TWHEEL_SLOTS^TWHEEL_LEVELS ticks ahead
+*/
+#define TWHEEL_LEVELS 4
+
+/**
+Number of list elements the wheel's pool allocates at once
+*/
+#ifndef TWHEEL_POOL_BLOCKS
+#define TWHEEL_POOL_BLOCKS 1024
+#endif
+
+/**
+@struct TWheel_Timer_t
+Timer which can be scheduled on a wheel
+
+The timer is owned by the caller and must stay valid while it is scheduled.
+*/
+typedef struct TWheel_Timer_T {
+  uint64_t expires; ///< Tick at which the timer fires
+
+  void (*callback)(struct TWheel_Timer_T *timer); ///< Called when the timer fires
+  void *data; ///< Caller data for the callback
+
+  CList_Element_t *element; ///< Element holding the timer (NULL unless pending)
+  int level; ///< Level the timer is filed in (TWHEEL_LEVELS while expiring)
+  int slot;  ///< Slot the timer is filed in
+
+} TWheel_Timer_t;
+
+/**
+@struct TWheel_t
+Hierarchical timer wheel
+
+@note
+The wheel contains its own pool, which the slot lists refer to, so an
+initialized wheel must not be copied or moved.
+*/
+typedef struct TWheel_T {
+  uint64_t now; ///< Current tick
+  int size;     ///< Number of pending timers
+
+  Pool_t pool; ///< Storage for the list elements of every slot
+
+  CList_t slots[TWHEEL_LEVELS][TWHEEL_SLOTS];
+
+  CList_t expiring; ///< Timers due on the current tick, not yet fired
+
+} TWheel_t;
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/**
+Function to initialize a timer wheel
+
+@pre
+Must be called before wheel can be used by any other operation
+
+Complexity: O(1)
+
+@param [out] *wheel  The wheel to init
+@param [in]   now    The current tick
+
+@return 0 if wheel init successful, otherwise -1
+*/
+int twheel_init(TWheel_t *wheel, uint64_t now);
+
+/**
+Function to destroy a timer wheel
+
+Timers still pending are dropped without being fired; the timers themselves
+belong to the caller and are not freed.
+
+Complexity: O(c), where *c* is the number of pool chunks allocated
+
+@param [in,out] *wheel  The wheel to destroy
+*/
+void twheel_destroy(TWheel_t *wheel);
+
+/**
+Function to set up a timer
+
+@param [out] *timer     The timer to init
+@param [in] (*callback) Function pointer called when the timer fires
+@param [in]  *data      Caller data for the callback
+*/
+void twheel_timer_init(TWheel_Timer_t *timer, void (*callback)(TWheel_Timer_t *timer), 
+  void *data);
+
+/**
+Function to schedule a timer
+
+The timer fires during the *twheel_advance* call that reaches tick _expires_.
+A timer due now or in the past fires on the next tick. Scheduling a timer that
+is already pending moves it.
+
+Complexity: O(1)
+
+@param [in,out] *wheel    The wheel to schedule timer on
+@param [in,out] *timer    The timer to schedule
+@param [in]      expires  The tick at which the timer fires
+
+@return 0 if schedule operation was successful, otherwise -1
+*/
+int twheel_schedule(TWheel_t *wheel, TWheel_Timer_t *timer, uint64_t expires);
+
+/**
+Function to cancel a pending timer
+
+May be called from a timer callback, including for timers due on the same
+tick that have not fired yet.
+
+Complexity: O(1)
+
+@param [in,out] *wheel  The wheel the timer is scheduled on
+@param [in,out] *timer  The timer to cancel
+
+@return 0 if cancel operation was successful, otherwise -1 (not pending)
+*/
+int twheel_cancel(TWheel_t *wheel, TWheel_Timer_t *timer);
+
+/**
+Function to move the wheel forward, firing the timers that become due
+
+Each tick first advances the current tick, then cascades timers down from the
+coarser levels if a lower level completed a turn, then fires every timer due.
+Callbacks may schedule and cancel timers.
+
+Complexity: O(1) per tick plus O(1) per timer fired or cascaded
+
+@param [in,out] *wheel  The wheel to advance
+@param [in]      ticks  The number of ticks to move forward
+
+@return the number of timers fired
+*/
+int twheel_advance(TWheel_t *wheel, uint64_t ticks);
+
+/**
+MACRO that evaluates to the current tick of the wheel
+*/
+#define twheel_now(wheel) ((wheel)->now)
+
+/**
+MACRO that evaluates to the number of pending timers
+*/
+#define twheel_size(wheel) ((wheel)->size)
+
+/**
+MACRO that evaluates to true if the timer is scheduled and has not fired
+*/
+#define twheel_is_pending(timer) ((timer)->element != NULL)
+
+#ifdef __cplusplus
+}
+#endif
+#endif // TWHEEL_h
@@ -0,0 +1,327 @@
+/**
+@file ulist.c
+
+See header
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "ulist.h"
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+/**
+A node holding fewer elements than this is refilled from the node after it
+*/
+#define ULIST_NODE_MIN (ULIST_NODE_ITEMS / 2)
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static UList_Node_t *ulist_alloc_node(UList_t *list, UList_Node_t *node);
+static void ulist_rebalance(UList_t *list, UList_Node_t *prev, UList_Node_t *node);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void ulist_init(UList_t *list, void (*destroy)(void *data))
+{
+  // Initialize the list
+  list->size = 0;
+  list->destroy = destroy;
+  list->head = NULL;
+  list->tail = NULL;
+}
+
+
+void ulist_destroy(UList_t *list)
+{
+  UList_Node_t *node;
+  UList_Node_t *next;
+  int i;
+
+  for (node = list->head; node != NULL; node = next) {
+    next = node->next;
+
+    if (list->destroy != NULL) {
+      for (i = 0; i < node->count; i++)
+        list->destroy(node->items[i]);
+    }
+    free(node);
+  }
+
+  // No operations permitted at this point -- clear memory as precaution
+  memset(list, 0, sizeof (UList_t));
+}
+
+
+int ulist_insert_next(UList_t *list, UList_Position_t *position, const void *data)
+{
+  UList_Node_t *node;
+  UList_Node_t *split;
+  int index;
+
+  if (ulist_size(list) == 0) {
+    // Insert into empty list
+
+    if ((node = ulist_alloc_node(list, NULL)) == NULL)
+      return -1;
+    index = 0;
+  }
+  else if (position == NULL) {
+    // Insert at the head of the list
+    
+    node = list->head;
+    index = 0;
+  }
+  else {
+    // Insert somewhere other than at the head
+
+    node = position->node;
+    index = position->index + 1;
+  }
+
+  if (node->count == ULIST_NODE_ITEMS) {
+    if (index == ULIST_NODE_ITEMS) {
+      // Appending to a full node carries on in the next node, so a list built
+      // by appending ends up with full nodes rather than half full ones
+
+      if (node->next == NULL || node->next->count == ULIST_NODE_ITEMS) {
+        if ((node = ulist_alloc_node(list, node)) == NULL)
+          return -1;
+      }
+      else
+        node = node->next;
+
+      index = 0;
+    }
+    else {
+      // Split the node, moving its upper half into a new node after it
+
+      if ((split = ulist_alloc_node(list, node)) == NULL)
+        return -1;
+
+      split->count = ULIST_NODE_ITEMS - ULIST_NODE_MIN;
+      memcpy(split->items, &node->items[ULIST_NODE_MIN], split->count * sizeof (void *));
+      node->count = ULIST_NODE_MIN;
+
+      if (index > node->count) {
+        index -= node->count;
+        node = split;
+      }
+    }
+  }
+
+  // Make room for the element in the node
+  memmove(&node->items[index + 1], &node->items[index], 
+    (node->count - index) * sizeof (void *));
+
+  node->items[index] = (void *)data;
+  node->count++;
+
+  if (position != NULL) {
+    position->node = node;
+    position->index = index;
+  }
+
+  // Adjust the size
+  list->size++;
+
+  return 0;
+}
+
+
+int ulist_remove_next(UList_t *list, const UList_Position_t *position, void **data)
+{
+  UList_Node_t *prev;
+  UList_Node_t *node;
+  int index;
+
+  // Check for empty list!
+  if (ulist_size(list) == 0)
+    return -1;
+
+  if (position == NULL) {
+    // Remove from the head of the list
+
+    prev = NULL;
+    node = list->head;
+    index = 0;
+  }
+  else if (position->index + 1 < position->node->count) {
+    // Remove from the same node, which keeps at least the element at position
+
+    prev = NULL;
+    node = position->node;
+    index = position->index + 1;
+  }
+  else {
+    // Remove the first element of the next node
+
+    if (position->node->next == NULL)
+      return -1;
+
+    prev = position->node;
+    node = position->node->next;
+    index = 0;
+  }
+
+  *data = node->items[index];
+
+  // Close the gap in the node
+  node->count--;
+  memmove(&node->items[index], &node->items[index + 1], 
+    (node->count - index) * sizeof (void *));
+
+  ulist_rebalance(list, prev, node);
+
+  // Adjust the size of the list
+  list->size--;
+
+  return 0;
+}
+
+
+int ulist_first(const UList_t *list, UList_Position_t *position)
+{
+  if (ulist_size(list) == 0)
+    return -1;
+
+  position->node = list->head;
+  position->index = 0;
+
+  return 0;
+}
+
+
+int ulist_last(const UList_t *list, UList_Position_t *position)
+{
+  if (ulist_size(list) == 0)
+    return -1;
+
+  position->node = list->tail;
+  position->index = list->tail->count - 1;
+
+  return 0;
+}
+
+
+int ulist_next(UList_Position_t *position)
+{
+  if (position->index + 1 < position->node->count) {
+    position->index++;
+    return 0;
+  }
+
+  if (position->node->next == NULL)
+    return -1;
+
+  position->node = position->node->next;
+  position->index = 0;
+
+  return 0;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+/**
+Allocate an empty node and link it into the list
+
+@param [in,out] *list  The unrolled linked-list
+@param [in]     *node  The node to link after (NULL if the list has no nodes)
+
+@return the new node, or NULL if memory could not be allocated
+*/
+static UList_Node_t *ulist_alloc_node(UList_t *list, UList_Node_t *node)
+{
+  UList_Node_t *new_node;
+
+  if ((new_node = (UList_Node_t *)aligned_alloc(ULIST_NODE_SIZE, sizeof (UList_Node_t))) == NULL)
+    return NULL;
+
+  new_node->count = 0;
+
+  if (node == NULL) {
+    new_node->next = NULL;
+    list->head = new_node;
+    list->tail = new_node;
+  }
+  else {
+    new_node->next = node->next;
+    node->next = new_node;
+
+    if (list->tail == node)
+      list->tail = new_node;
+  }
+
+  return new_node;
+}
+
+
+/**
+Restore the fill of a node after an element was removed from it
+
+A node below half full takes elements from the front of the next node, or
+absorbs the next node whole if the two fit in one. Only the nodes from _node_
+on change, so positions before the removed element stay valid.
+
+@param [in,out] *list  The unrolled linked-list
+@param [in,out] *prev  The node before _node_, if needed to unlink it (else NULL)
+@param [in,out] *node  The node an element was removed from
+*/
+static void ulist_rebalance(UList_t *list, UList_Node_t *prev, UList_Node_t *node)
+{
+  UList_Node_t *next;
+  int moved;
+
+  if (node->count >= ULIST_NODE_MIN)
+    return;
+
+  next = node->next;
+
+  if (next == NULL) {
+    // The last node may run low, but not empty
+    if (node->count > 0)
+      return;
+
+    if (prev == NULL)
+      list->head = NULL;
+    else
+      prev->next = NULL;
+
+    list->tail = prev;
+    free(node);
+  }
+  else if (node->count + next->count <= ULIST_NODE_ITEMS) {
+    // Merge the next node into this one
+
+    memcpy(&node->items[node->count], next->items, next->count * sizeof (void *));
+    node->count += next->count;
+
+    node->next = next->next;
+    if (list->tail == next)
+      list->tail = node;
+
+    free(next);
+  }
+  else {
+    // Borrow enough elements from the next node to be half full again
+
+    moved = ULIST_NODE_MIN - node->count;
+
+    memcpy(&node->items[node->count], next->items, moved * sizeof (void *));
+    node->count += moved;
+
+    next->count -= moved;
+    memmove(next->items, &next->items[moved], next->count * sizeof (void *));
+  }
+}
@@ -0,0 +1,241 @@
+/** 
+@file ulist.h
+@brief 
+Definitions of an unrolled linked-list ADT
+
+Each node of the list is one cache line holding a small array of data pointers
+and a count, rather than a single data pointer. Scanning the list walks an
+array within each node and only chases a pointer once per node, which the
+hardware prefetcher can keep up with, and the list costs a fraction of a
+pointer per element instead of a whole List_Element_t allocation.
+
+An element is addressed by a UList_Position_t (node and index within the node)
+where List_t would use a List_Element_t pointer. A node that fills up is split
+in two, and a node that drops below half full takes elements from, or is merged
+with, the node after it.
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#ifndef ULIST_h
+#define ULIST_h
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdlib.h>
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+/**
+The size of a node, normally the size of a cache line
+*/
+#ifndef ULIST_NODE_SIZE
+#define ULIST_NODE_SIZE 64
+#endif
+
+/**
+The number of data pointers that fit in a node besides its link and count
+*/
+#define ULIST_NODE_ITEMS ((int)((ULIST_NODE_SIZE - 2 * sizeof (void *)) / sizeof (void *)))
+
+/**
+@struct UList_Node_t
+Unrolled linked-list node
+*/
+typedef struct UList_Node_T {
+  struct UList_Node_T *next; ///< Pointer to next node in list
+  int count;                 ///< Number of elements held in the node
+
+  void *items[ULIST_NODE_ITEMS]; ///< Pointers to data
+
+} UList_Node_t;
+
+/**
+@struct UList_Position_t
+Position of an element in an unrolled linked-list
+*/
+typedef struct UList_Position_T {
+  UList_Node_t *node; ///< Node holding the element
+  int index;          ///< Index of the element within the node
+
+} UList_Position_t;
+
+/**
+@struct UList_t
+Unrolled linked-list
+*/
+typedef struct UList_T {
+  int size; ///< Number of elements in list
+
+  void (*destroy)(void *data);
+
+  UList_Node_t *head; ///< Pointer to first node in list
+  UList_Node_t *tail; ///< Pointer to last node in list
+
+} UList_t;
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/**
+Function to initialize an unrolled linked-list
+
+@pre
+Must be called before list can be used by any other operation
+
+The _destroy_ argument provides a way to free dynamically allocated data when
+*ulist_destroy* is called, or NULL if the data should not be freed.
+
+Complexity: O(1)
+
+@param [out] *list     The unrolled linked-list to init
+@param [in] (*destroy) Function pointer to free data element memory
+*/
+void ulist_init(UList_t *list, void (*destroy)(void *data));
+
+/**
+Function to destroy an unrolled linked-list
+
+Calls the function passed as _destroy_ to *ulist_init* once for each element,
+provided _destroy_ was not set to NULL, and frees the nodes.
+
+Complexity: O(n)
+
+@param [in,out] *list  The unrolled linked-list to destroy
+*/
+void ulist_destroy(UList_t *list);
+
+/**
+Function to insert an element into an unrolled linked-list
+
+Inserts an element just after the one at _position_. If _position_ is NULL, the
+new element is inserted at the head of the list. Otherwise, upon return
+_position_ addresses the new element, so that calling this function repeatedly
+with the same position appends elements in order.
+
+@note
+Inserting may shift or split the node, so any other position into that node
+is invalidated.
+
+Complexity: O(1)
+
+@param [in,out] *list      The unrolled linked-list to insert element into
+@param [in,out] *position  The position to insert after, then the new element
+@param [in]     *data      The data to insert
+
+@return 0 if inserting into list was successful, otherwise -1
+*/
+int ulist_insert_next(UList_t *list, UList_Position_t *position, const void *data);
+
+/**
+Function to remove an element from an unrolled linked-list
+
+Removes the element just after the one at _position_. If _position_ is NULL,
+the element at the head of the list is removed. Upon return _data_ points to
+the data stored in the element that was removed. The element at _position_
+keeps its position.
+
+@note
+Removing may shift or merge the nodes after _position_, so any other position
+into those nodes is invalidated.
+
+Complexity: O(1)
+
+@param [in,out] *list      The unrolled linked-list to remove element from
+@param [in]     *position  The position to remove after
+@param [out]    **data     The data removed
+
+@return 0 if removing from list was successful, otherwise -1
+*/
+int ulist_remove_next(UList_t *list, const UList_Position_t *position, void **data);
+
+/**
+Function to get the position of the first element of an unrolled linked-list
+
+Complexity: O(1)
+
+@param [in]  *list      The unrolled linked-list
+@param [out] *position  The position of the first element
+
+@return 0 if the list has a first element, otherwise -1 (list empty)
+*/
+int ulist_first(const UList_t *list, UList_Position_t *position);
+
+/**
+Function to get the position of the last element of an unrolled linked-list
+
+Complexity: O(1)
+
+@param [in]  *list      The unrolled linked-list
+@param [out] *position  The position of the last element
+
+@return 0 if the list has a last element, otherwise -1 (list empty)
+*/
+int ulist_last(const UList_t *list, UList_Position_t *position);
+
+/**
+Function to advance a position to the next element of an unrolled linked-list
+
+Complexity: O(1)
+
+@param [in,out] *position  The position to advance
+
+@return 0 if the position was advanced, otherwise -1 (no next element, and
+_position_ is left unchanged)
+*/
+int ulist_next(UList_Position_t *position);
+
+/**
+MACRO that evaluates to the number of elements in the unrolled linked-list
+*/
+#define ulist_size(list) ((list)->size)
+
+/**
+MACRO that evaluates to the data stored at a position of an unrolled linked-list
+*/
+#define ulist_data(position) ((position)->node->items[(position)->index])
+
+/**
+MACRO that determines whether a position is the last element of the unrolled
+linked-list
+*/
+#define ulist_is_tail(position) \
+  ((position)->node->next == NULL && (position)->index == (position)->node->count - 1 ? 1 : 0)
+
+/**
+MACRO that evaluates to the first node of an unrolled linked-list
+
+Walking the nodes directly, with *ulist_node_next()*, *ulist_node_count()* and
+*ulist_node_data()*, is the fastest way to scan the list.
+*/
+#define ulist_head(list) ((list)->head)
+
+/**
+MACRO that evaluates to the last node of an unrolled linked-list
+*/
+#define ulist_tail(list) ((list)->tail)
+
+/**
+MACRO that evaluates to the node after a node of an unrolled linked-list
+*/
+#define ulist_node_next(node) ((node)->next)
+
+/**
+MACRO that evaluates to the number of elements held in a node
+*/
+#define ulist_node_count(node) ((node)->count)
+
+/**
+MACRO that evaluates to the data of the element at _index_ in a node
+*/
+#define ulist_node_data(node, index) ((node)->items[(index)])
+
+#ifdef __cplusplus
+}
+#endif
+#endif // ULIST_h
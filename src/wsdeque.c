@@ -0,0 +1,232 @@
+/**
+@file wsdeque.c
+
+See header
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "wsdeque.h"
+
+// -----------------------------------------------------------------------------
+// Function Prototypes
+// -----------------------------------------------------------------------------
+
+static WSDeque_Array_t *wsdeque_array(int64_t capacity);
+static WSDeque_Array_t *wsdeque_grow(WSDeque_t *deque, WSDeque_Array_t *array, 
+  int64_t top, int64_t bottom);
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+int wsdeque_init(WSDeque_t *deque, int capacity, void (*destroy)(void *data))
+{
+  WSDeque_Array_t *array;
+  int64_t slots;
+
+  if (capacity <= 0)
+    return -1;
+
+  // Round the capacity up to a power of two
+  slots = 1;
+  while (slots < capacity)
+    slots *= 2;
+
+  if ((array = wsdeque_array(slots)) == NULL)
+    return -1;
+
+  atomic_init(&deque->top, 0);
+  atomic_init(&deque->bottom, 0);
+  atomic_init(&deque->array, array);
+  deque->destroy = destroy;
+
+  return 0;
+}
+
+
+void wsdeque_destroy(WSDeque_t *deque)
+{
+  WSDeque_Array_t *array;
+  WSDeque_Array_t *prev;
+  int64_t top;
+  int64_t bottom;
+
+  array = atomic_load(&deque->array);
+  top = atomic_load(&deque->top);
+  bottom = atomic_load(&deque->bottom);
+
+  // Destroy each element still in the deque
+  if (deque->destroy != NULL) {
+    for (; top < bottom; top++)
+      deque->destroy(atomic_load(&array->items[top & (array->capacity - 1)]));
+  }
+
+  // Free the current array along with every array it replaced
+  for (; array != NULL; array = prev) {
+    prev = array->prev;
+    free(array);
+  }
+
+  // No operations permitted at this point -- clear memory as precaution
+  memset(deque, 0, sizeof (WSDeque_t));
+}
+
+
+int wsdeque_push_bottom(WSDeque_t *deque, const void *data)
+{
+  WSDeque_Array_t *array;
+  int64_t bottom;
+  int64_t top;
+
+  bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+  top = atomic_load_explicit(&deque->top, memory_order_acquire);
+  array = atomic_load_explicit(&deque->array, memory_order_relaxed);
+
+  if (bottom - top > array->capacity - 1) {
+    if ((array = wsdeque_grow(deque, array, top, bottom)) == NULL)
+      return -1;
+  }
+
+  atomic_store_explicit(&array->items[bottom & (array->capacity - 1)], 
+    (void *)data, memory_order_relaxed);
+
+  // Make the element visible before a thief can see the new bottom
+  atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_release);
+
+  return 0;
+}
+
+
+int wsdeque_pop_bottom(WSDeque_t *deque, void **data)
+{
+  WSDeque_Array_t *array;
+  int64_t bottom;
+  int64_t top;
+  void *value;
+
+  // Reserve the bottom element before looking at what thieves have done
+  bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+  array = atomic_load_explicit(&deque->array, memory_order_relaxed);
+  atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+  atomic_thread_fence(memory_order_seq_cst);
+  top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+
+  if (top > bottom) {
+    // Already empty -- undo the reservation
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    return -1;
+  }
+
+  value = atomic_load_explicit(&array->items[bottom & (array->capacity - 1)], 
+    memory_order_relaxed);
+
+  if (top == bottom) {
+    // Last element -- race the thieves for it
+    if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, 
+        memory_order_seq_cst, memory_order_relaxed)) {
+      atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+      return -1;
+    }
+
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+  }
+
+  *data = value;
+
+  return 0;
+}
+
+
+int wsdeque_steal(WSDeque_t *deque, void **data)
+{
+  WSDeque_Array_t *array;
+  int64_t bottom;
+  int64_t top;
+  void *value;
+
+  top = atomic_load_explicit(&deque->top, memory_order_acquire);
+  atomic_thread_fence(memory_order_seq_cst);
+  bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+
+  if (top >= bottom)
+    return -1;
+
+  // Read the element before claiming it; the claim fails if the owner or
+  // another thief got there first
+  array = atomic_load_explicit(&deque->array, memory_order_acquire);
+  value = atomic_load_explicit(&array->items[top & (array->capacity - 1)], 
+    memory_order_relaxed);
+
+  if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, 
+      memory_order_seq_cst, memory_order_relaxed))
+    return 1;
+
+  *data = value;
+
+  return 0;
+}
+
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+// Local Functions
+// ~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~-~
+
+/**
+Allocate an empty circular array
+
+@param [in] capacity  Number of elements (a power of two)
+
+@return the array, or NULL if memory could not be allocated
+*/
+static WSDeque_Array_t *wsdeque_array(int64_t capacity)
+{
+  WSDeque_Array_t *array;
+
+  array = (WSDeque_Array_t *)malloc(sizeof (WSDeque_Array_t) + 
+    capacity * sizeof (_Atomic(void *)));
+  if (array == NULL)
+    return NULL;
+
+  array->capacity = capacity;
+  array->prev = NULL;
+
+  return array;
+}
+
+
+/**
+Replace a full array with one twice the size (owner only)
+
+@param [in,out] *deque   The deque
+@param [in]     *array   The full array
+@param [in]      top     Index of the oldest element
+@param [in]      bottom  Index one past the newest element
+
+@return the new array, or NULL if memory could not be allocated
+*/
+static WSDeque_Array_t *wsdeque_grow(WSDeque_t *deque, WSDeque_Array_t *array, 
+  int64_t top, int64_t bottom)
+{
+  WSDeque_Array_t *new_array;
+  int64_t i;
+
+  if ((new_array = wsdeque_array(2 * array->capacity)) == NULL)
+    return NULL;
+
+  // Elements keep their indices, only the wrap-around changes
+  for (i = top; i < bottom; i++) {
+    atomic_store_explicit(&new_array->items[i & (new_array->capacity - 1)], 
+      atomic_load_explicit(&array->items[i & (array->capacity - 1)], 
+        memory_order_relaxed), memory_order_relaxed);
+  }
+
+  // Thieves may still be reading the old array, so keep it until destroy
+  new_array->prev = array;
+
+  atomic_store_explicit(&deque->array, new_array, memory_order_release);
+
+  return new_array;
+}
@@ -0,0 +1,158 @@
+/** 
+@file wsdeque.h
+@brief 
+Definitions of a lock-free work-stealing deque (Chase-Lev deque)
+
+The deque has an owner and any number of thieves. The owner pushes and pops
+at the bottom like a stack, which needs no atomic read-modify-write except when
+the deque is down to its last element; thieves take elements from the top with
+a compare-and-swap. Elements are kept in a circular array that the owner grows
+whenever it fills up. Arrays replaced by a larger one may still be read by a
+thief that is mid-steal, so they are only freed by *wsdeque_destroy*.
+
+The implementation follows the C11 formulation by Le, Pop, Cohen and Zappa
+Nardelli, "Correct and Efficient Work-Stealing for Weak Memory Models" (2013).
+
+@author Justin Hadella (pitchnogle@gmail.com)
+*/
+#ifndef WSDEQUE_h
+#define WSDEQUE_h
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// -----------------------------------------------------------------------------
+// Definitions
+// -----------------------------------------------------------------------------
+
+/**
+The assumed size of a cache line, used to keep the two ends of the deque apart
+*/
+#ifndef WSDEQUE_CACHE_LINE
+#define WSDEQUE_CACHE_LINE 64
+#endif
+
+/**
+@struct WSDeque_Array_t
+Circular array holding the elements of a deque
+*/
+typedef struct WSDeque_Array_T {
+  int64_t capacity; ///< Number of elements in the array (a power of two)
+  struct WSDeque_Array_T *prev; ///< Array this one replaced (freed at destroy)
+  _Atomic(void *) items[];
+} WSDeque_Array_t;
+
+/**
+@struct WSDeque_t
+Work-stealing deque
+*/
+typedef struct WSDeque_T {
+  _Alignas(WSDEQUE_CACHE_LINE)
+  _Atomic(int64_t) top; ///< Index of the oldest element (advanced by thieves)
+
+  _Alignas(WSDEQUE_CACHE_LINE)
+  _Atomic(int64_t) bottom; ///< Index one past the newest element (owner only)
+
+  _Atomic(WSDeque_Array_t *) array;
+
+  void (*destroy)(void *data);
+
+} WSDeque_t;
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Public Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/**
+Function to initialize a work-stealing deque
+
+@pre
+Must be called before deque can be used by any other operation, and before
+any thread starts using it
+
+The deque starts out with room for _capacity_ elements, rounded up to a power
+of two, and grows as needed. The _destroy_ argument provides a way to free
+dynamically allocated data when *wsdeque_destroy* is called, or NULL if the
+data should not be freed.
+
+Complexity: O(1)
+
+@param [out] *deque     The deque to init
+@param [in]   capacity  The initial number of elements the deque can hold
+@param [in] (*destroy)  Function pointer to free data element memory
+
+@return 0 if deque init successful, otherwise -1
+*/
+int wsdeque_init(WSDeque_t *deque, int capacity, void (*destroy)(void *data));
+
+/**
+Function to destroy a work-stealing deque
+
+Calls the function passed as _destroy_ to *wsdeque_init* once for each element
+still in the deque, provided _destroy_ was not set to NULL.
+
+@pre
+No thread may be using the deque
+
+Complexity: O(n)
+
+@param [in,out] *deque  The deque to destroy
+*/
+void wsdeque_destroy(WSDeque_t *deque);
+
+/**
+Function to push an element onto the bottom of the deque (owner only)
+
+Complexity: O(1) amortized
+
+@param [in,out] *deque  The deque to push element onto
+@param [in]     *data   The data to push
+
+@return 0 if push operation was successful, otherwise -1
+*/
+int wsdeque_push_bottom(WSDeque_t *deque, const void *data);
+
+/**
+Function to pop the newest element off the bottom of the deque (owner only)
+
+Complexity: O(1)
+
+@param [in,out] *deque  The deque to pop element from
+@param [out]    **data  The popped data
+
+@return 0 if pop operation was successful, otherwise -1 (deque empty)
+*/
+int wsdeque_pop_bottom(WSDeque_t *deque, void **data);
+
+/**
+Function to steal the oldest element from the top of the deque (any thread)
+
+Complexity: O(1) (lock-free)
+
+@param [in,out] *deque  The deque to steal element from
+@param [out]    **data  The stolen data
+
+@return 0 if steal operation was successful, -1 if the deque is empty, or 1 if
+another thread took the element first (the deque may still hold more)
+*/
+int wsdeque_steal(WSDeque_t *deque, void **data);
+
+/**
+MACRO that evaluates to the number of elements in the deque
+
+The value is only a snapshot while other threads are active.
+*/
+#define wsdeque_size(deque) \
+  ((int)(atomic_load_explicit(&(deque)->bottom, memory_order_relaxed) - \
+         atomic_load_explicit(&(deque)->top, memory_order_relaxed)))
+
+#ifdef __cplusplus
+}
+#endif
+#endif // WSDEQUE_h